@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbenchmark.h"
+#include "dwidgetprofiler.h"
+
+#include <DGuiApplicationHelper>
+
+#include <QVBoxLayout>
+#include <QWidget>
+
+DGUI_USE_NAMESPACE
+DWIDGET_USE_NAMESPACE
+
+class StyleChangeWatcher : public QObject
+{
+public:
+    using QObject::QObject;
+
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (event->type() == QEvent::StyleChange)
+            changed = true;
+        return QObject::eventFilter(watched, event);
+    }
+
+    bool changed = false;
+};
+
+class BenchDApplication : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void sizeModeChange_data();
+    void sizeModeChange();
+    void notify_data();
+    void notify();
+};
+
+void BenchDApplication::sizeModeChange_data()
+{
+    QTest::addColumn<int>("widgetCount");
+
+    QTest::newRow("2000") << 2000;
+    QTest::newRow("20000") << 20000;
+}
+
+void BenchDApplication::sizeModeChange()
+{
+    QFETCH(int, widgetCount);
+
+    QWidget window;
+    window.resize(400, 300);
+    auto layout = new QVBoxLayout(&window);
+    for (int i = 0; i < widgetCount; ++i) {
+        // 一部分控件隐藏，模拟未显示的页面
+        auto child = new QWidget(&window);
+        if (i % 4 == 0)
+            child->hide();
+        if (i % 100 == 0)
+            layout->addWidget(child);
+    }
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    // 顶层窗口最后收到事件，以此判断一次切换已全部完成
+    StyleChangeWatcher watcher;
+    window.installEventFilter(&watcher);
+
+    auto helper = DGuiApplicationHelper::instance();
+    const auto initialMode = helper->sizeMode();
+    QBENCHMARK {
+        watcher.changed = false;
+        helper->setSizeMode(helper->sizeMode() == DGuiApplicationHelper::NormalMode
+                            ? DGuiApplicationHelper::CompactMode
+                            : DGuiApplicationHelper::NormalMode);
+        QVERIFY(QTest::qWaitFor([&watcher] { return watcher.changed; }, 10000));
+    }
+    helper->setSizeMode(initialMode);
+}
+
+void BenchDApplication::notify_data()
+{
+    QTest::addColumn<bool>("baseNotify");
+
+    // 与 QApplication::notify 对比，得到 DApplication::notify 中各项处理（包括未启用的性能分析）的开销
+    QTest::newRow("QApplication") << true;
+    QTest::newRow("DApplication") << false;
+}
+
+void BenchDApplication::notify()
+{
+    QFETCH(bool, baseNotify);
+    QVERIFY(!DWidgetProfiler::instance()->isEnabled());
+
+    QWidget widget;
+    QEvent event(QEvent::StyleChange);
+    QBENCHMARK {
+        for (int i = 0; i < 10000; ++i) {
+            if (baseNotify)
+                qApp->QApplication::notify(&widget, &event);
+            else
+                qApp->notify(&widget, &event);
+        }
+    }
+}
+
+DTK_BENCHMARK_MAIN(BenchDApplication)
+
+#include "bench_dapplication.moc"
@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbenchmark.h"
+
+#include <DBlurEffectWidget>
+
+#include <QElapsedTimer>
+#include <QLinearGradient>
+#include <QPainter>
+#include <QThreadPool>
+
+DWIDGET_USE_NAMESPACE
+
+class BenchDBlurEffectWidget : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void inWidgetBlend_data();
+    void inWidgetBlend();
+    void groupSourceImage_data();
+    void groupSourceImage();
+    void groupSourceImageAsync_data();
+    void groupSourceImageAsync();
+    void groupPaint();
+
+private:
+    QImage source;
+};
+
+static QImage createSourceImage(const QSize &size)
+{
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    QPainter p(&image);
+    QLinearGradient gradient(0, 0, size.width(), size.height());
+    gradient.setColorAt(0, Qt::darkBlue);
+    gradient.setColorAt(0.5, Qt::yellow);
+    gradient.setColorAt(1, Qt::darkRed);
+    p.fillRect(image.rect(), gradient);
+    for (int i = 0; i < 64; ++i)
+        p.fillRect(QRect((i * 37) % size.width(), (i * 53) % size.height(), 40, 40), QColor::fromHsv(i * 5, 200, 200));
+    return image;
+}
+
+void BenchDBlurEffectWidget::initTestCase()
+{
+    source = createSourceImage(QSize(1920, 1080));
+}
+
+void BenchDBlurEffectWidget::inWidgetBlend_data()
+{
+    QTest::addColumn<int>("radius");
+
+    QTest::newRow("radius-10") << 10;
+    QTest::newRow("radius-30") << 30;
+}
+
+void BenchDBlurEffectWidget::inWidgetBlend()
+{
+    QFETCH(int, radius);
+
+    QWidget parent;
+    parent.resize(600, 400);
+    parent.setAutoFillBackground(true);
+    DBlurEffectWidget blur(&parent);
+    blur.setBlendMode(DBlurEffectWidget::InWidgetBlend);
+    blur.setRadius(radius);
+    blur.setGeometry(50, 50, 500, 300);
+
+    QImage canvas(parent.size(), QImage::Format_ARGB32_Premultiplied);
+    QBENCHMARK {
+        parent.render(&canvas);
+    }
+}
+
+void BenchDBlurEffectWidget::groupSourceImage_data()
+{
+    QTest::addColumn<int>("radius");
+
+    QTest::newRow("radius-15") << 15;
+    QTest::newRow("radius-35") << 35;
+}
+
+void BenchDBlurEffectWidget::groupSourceImage()
+{
+    QFETCH(int, radius);
+
+    DBlurEffectGroup group;
+    QBENCHMARK {
+        group.setSourceImage(source, radius);
+    }
+}
+
+void BenchDBlurEffectWidget::groupSourceImageAsync_data()
+{
+    groupSourceImage_data();
+}
+
+void BenchDBlurEffectWidget::groupSourceImageAsync()
+{
+    QFETCH(int, radius);
+
+    // 只统计界面线程上的耗时，模糊在工作线程中完成
+    DBlurEffectGroup group;
+    QElapsedTimer timer;
+    qint64 guiNsecs = 0;
+    int iterations = 0;
+    QBENCHMARK {
+        timer.start();
+        group.setSourceImageAsync(source, radius);
+        guiNsecs += timer.nsecsElapsed();
+        ++iterations;
+        QThreadPool::globalInstance()->waitForDone();
+        QCoreApplication::processEvents();
+    }
+
+    qInfo("async source image: %.3f ms on the GUI thread per call", guiNsecs / 1e6 / qMax(1, iterations));
+}
+
+void BenchDBlurEffectWidget::groupPaint()
+{
+    DBlurEffectGroup group;
+    DBlurEffectWidget blur;
+    blur.resize(400, 300);
+    group.addWidget(&blur, QPoint(200, 100));
+    group.setSourceImage(source);
+
+    QImage canvas(blur.size(), QImage::Format_ARGB32_Premultiplied);
+    QPainter p(&canvas);
+    QBENCHMARK {
+        group.paint(&p, &blur);
+    }
+}
+
+DTK_BENCHMARK_MAIN(BenchDBlurEffectWidget)
+
+#include "bench_dblureffectwidget.moc"
@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbenchmark.h"
+
+#include <DImageViewer>
+
+#include <QFile>
+#include <QPainter>
+#include <QTemporaryDir>
+
+DWIDGET_USE_NAMESPACE
+
+class BenchDImageViewer : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void svgPan();
+    void rotate_data();
+    void rotate();
+
+private:
+    QTemporaryDir dir;
+    QString svgFile;
+};
+
+// 生成包含大量图元的 SVG，用于测试矢量图的绘制开销
+static bool createHeavySvg(const QString &fileName, int elementCount)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    const int side = 4000;
+    file.write(QStringLiteral("<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%1\" height=\"%1\">\n").arg(side).toUtf8());
+    for (int i = 0; i < elementCount; ++i) {
+        const int x = (i * 7919) % side;
+        const int y = (i * 104729) % side;
+        file.write(QStringLiteral("<rect x=\"%1\" y=\"%2\" width=\"24\" height=\"24\" fill=\"#%3\"/>\n")
+                       .arg(x).arg(y).arg((i * 2654435761u) & 0xffffff, 6, 16, QLatin1Char('0')).toUtf8());
+    }
+    file.write("</svg>\n");
+    return true;
+}
+
+void BenchDImageViewer::initTestCase()
+{
+    QVERIFY(dir.isValid());
+    svgFile = dir.filePath(QStringLiteral("heavy.svg"));
+    QVERIFY(createHeavySvg(svgFile, 50000));
+}
+
+void BenchDImageViewer::svgPan()
+{
+    DImageViewer viewer;
+    viewer.resize(800, 600);
+    viewer.setFileName(svgFile);
+    viewer.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&viewer));
+    viewer.setScaleFactor(2);
+
+    int step = 0;
+    QBENCHMARK {
+        // 在放大后的图像上来回平移，每次都需要重绘整个视口
+        const qreal offset = (step++ % 40) * 50;
+        viewer.centerOn(1000 + offset, 1000 + offset);
+        viewer.viewport()->repaint();
+    }
+}
+
+void BenchDImageViewer::rotate_data()
+{
+    QTest::addColumn<QSize>("size");
+
+    QTest::newRow("1920x1080") << QSize(1920, 1080);
+    QTest::newRow("4000x3000") << QSize(4000, 3000);
+}
+
+void BenchDImageViewer::rotate()
+{
+    QFETCH(QSize, size);
+
+    QImage image(size, QImage::Format_ARGB32);
+    QPainter p(&image);
+    p.fillRect(image.rect(), QLinearGradient(0, 0, size.width(), size.height()));
+    p.end();
+
+    DImageViewer viewer(image);
+    QBENCHMARK {
+        viewer.rotateClockwise();
+        viewer.image();
+    }
+}
+
+DTK_BENCHMARK_MAIN(BenchDImageViewer)
+
+#include "bench_dimageviewer.moc"
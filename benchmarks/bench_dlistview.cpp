@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbenchmark.h"
+
+#include <DListView>
+
+DWIDGET_USE_NAMESPACE
+
+class BenchDListView : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void addItems();
+    void insertItems();
+    void removeItems();
+    void replaceAll();
+
+private:
+    QVariantList items;
+};
+
+static const int ItemCount = 500000;
+
+void BenchDListView::initTestCase()
+{
+    items.reserve(ItemCount);
+    for (int i = 0; i < ItemCount; ++i)
+        items << QStringLiteral("Item %1").arg(i);
+}
+
+void BenchDListView::addItems()
+{
+    QBENCHMARK {
+        DListView view;
+        view.setModel(new DVariantListModel(&view));
+        view.addItems(items);
+    }
+}
+
+void BenchDListView::insertItems()
+{
+    // 在已有数据的中间位置插入，需要移动后半部分数据
+    QBENCHMARK {
+        DListView view;
+        view.setModel(new DVariantListModel(&view));
+        view.addItems(items.mid(0, ItemCount / 2));
+        view.insertItems(ItemCount / 4, items.mid(ItemCount / 2));
+    }
+}
+
+void BenchDListView::removeItems()
+{
+    DListView view;
+    auto model = new DVariantListModel(&view);
+    view.setModel(model);
+
+    QBENCHMARK {
+        model->replaceAll(items);
+        view.removeItems(ItemCount / 4, ItemCount / 2);
+    }
+}
+
+void BenchDListView::replaceAll()
+{
+    DListView view;
+    auto model = new DVariantListModel(&view);
+    view.setModel(model);
+
+    QBENCHMARK {
+        model->replaceAll(items);
+    }
+}
+
+DTK_BENCHMARK_MAIN(BenchDListView)
+
+#include "bench_dlistview.moc"
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbenchmark.h"
+
+#include <DPaletteHelper>
+
+#include <QWidget>
+
+DWIDGET_USE_NAMESPACE
+
+static const int WidgetCount = 10000;
+
+class BenchDPaletteHelper : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void eventDelivery();
+    void palette();
+    void brush();
+
+private:
+    QWidget *window = nullptr;
+    QList<QWidget *> widgets;
+};
+
+void BenchDPaletteHelper::initTestCase()
+{
+    // 十层嵌套的控件树，所有控件都通过 DPaletteHelper 获取过调色板
+    window = new QWidget;
+    QWidget *parent = window;
+    for (int i = 0; i < WidgetCount; ++i) {
+        auto widget = new QWidget(i % 10 == 0 ? window : parent);
+        parent = widget;
+        widgets << widget;
+        DPaletteHelper::instance()->palette(widget);
+    }
+}
+
+void BenchDPaletteHelper::cleanupTestCase()
+{
+    delete window;
+    widgets.clear();
+}
+
+void BenchDPaletteHelper::eventDelivery()
+{
+    // 与调色板无关的事件，测量分发到已缓存调色板的控件时的额外开销
+    QEvent event(QEvent::User);
+    QBENCHMARK {
+        for (QWidget *widget : qAsConst(widgets))
+            QCoreApplication::sendEvent(widget, &event);
+    }
+}
+
+void BenchDPaletteHelper::palette()
+{
+    QBENCHMARK {
+        for (QWidget *widget : qAsConst(widgets))
+            DPaletteHelper::instance()->palette(widget).brush(DPalette::ItemBackground);
+    }
+}
+
+void BenchDPaletteHelper::brush()
+{
+    QBENCHMARK {
+        for (QWidget *widget : qAsConst(widgets))
+            DPaletteHelper::instance()->brush(widget, DPalette::ItemBackground);
+    }
+}
+
+DTK_BENCHMARK_MAIN(BenchDPaletteHelper)
+
+#include "bench_dpalettehelper.moc"
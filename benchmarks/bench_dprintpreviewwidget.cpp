@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbenchmark.h"
+
+#include <DPrintPreviewWidget>
+
+#include <QPainter>
+#include <QSignalSpy>
+
+DWIDGET_USE_NAMESPACE
+
+class BenchDPrintPreviewWidget : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void generatePreview_data();
+    void generatePreview();
+    void renderWaterMark_data();
+    void renderWaterMark();
+
+private:
+    void setImposition(int imposition);
+    bool waitPreview();
+
+    DPrinter *printer = nullptr;
+    DPrintPreviewWidget *preview = nullptr;
+};
+
+static const int PageCount = 20;
+
+// 每页绘制若干行文本和图形，模拟普通文档
+static void paintDocument(DPrinter *printer)
+{
+    QPainter p(printer);
+    const QRect pageRect = printer->pageLayout().paintRectPixels(printer->resolution());
+    for (int page = 0; page < PageCount; ++page) {
+        if (page > 0)
+            printer->newPage();
+        p.drawRect(pageRect.adjusted(10, 10, -10, -10));
+        for (int line = 0; line < 40; ++line) {
+            const int y = 40 + line * pageRect.height() / 45;
+            p.drawText(40, y, QStringLiteral("Page %1 line %2 - The quick brown fox jumps over the lazy dog").arg(page + 1).arg(line + 1));
+        }
+    }
+}
+
+void BenchDPrintPreviewWidget::initTestCase()
+{
+    printer = new DPrinter;
+    preview = new DPrintPreviewWidget(printer);
+    preview->resize(800, 1000);
+    connect(preview, QOverload<DPrinter *>::of(&DPrintPreviewWidget::paintRequested), this, &paintDocument);
+    preview->show();
+    QVERIFY(QTest::qWaitForWindowExposed(preview));
+    QVERIFY(waitPreview());
+}
+
+void BenchDPrintPreviewWidget::cleanupTestCase()
+{
+    delete preview;
+    preview = nullptr;
+    delete printer;
+    printer = nullptr;
+}
+
+void BenchDPrintPreviewWidget::setImposition(int imposition)
+{
+    preview->setImposition(DPrintPreviewWidget::Imposition(imposition));
+    QVERIFY(waitPreview());
+}
+
+bool BenchDPrintPreviewWidget::waitPreview()
+{
+    QSignalSpy spy(preview, &DPrintPreviewWidget::totalPages);
+    preview->updatePreview();
+    return spy.wait(5000);
+}
+
+void BenchDPrintPreviewWidget::generatePreview_data()
+{
+    QTest::addColumn<int>("imposition");
+
+    QTest::newRow("One") << int(DPrintPreviewWidget::One);
+    QTest::newRow("TwoRowTwoCol") << int(DPrintPreviewWidget::TwoRowTwoCol);
+    QTest::newRow("FourRowFourCol") << int(DPrintPreviewWidget::FourRowFourCol);
+}
+
+void BenchDPrintPreviewWidget::generatePreview()
+{
+    QFETCH(int, imposition);
+    setImposition(imposition);
+
+    QBENCHMARK {
+        QVERIFY(waitPreview());
+    }
+}
+
+void BenchDPrintPreviewWidget::renderWaterMark_data()
+{
+    generatePreview_data();
+}
+
+void BenchDPrintPreviewWidget::renderWaterMark()
+{
+    QFETCH(int, imposition);
+    setImposition(imposition);
+
+    // 平铺的文字水印
+    preview->refreshBegin();
+    preview->setWaterMarkType(1);
+    preview->setTextWaterMark(QStringLiteral("Confidential"));
+    preview->setWaterMarkRotate(30);
+    preview->setWaterMarkLayout(1);
+    preview->setWaterMarkOpacity(0.3);
+    preview->refreshEnd();
+
+    QImage canvas(preview->size(), QImage::Format_ARGB32_Premultiplied);
+    QBENCHMARK {
+        preview->updateWaterMark();
+        preview->render(&canvas);
+    }
+
+    preview->setWaterMarkType(0);
+}
+
+DTK_BENCHMARK_MAIN(BenchDPrintPreviewWidget)
+
+#include "bench_dprintpreviewwidget.moc"
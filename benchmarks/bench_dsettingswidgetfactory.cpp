@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbenchmark.h"
+
+#include <DSettingsOption>
+#include <dsettingswidgetfactory.h>
+
+#include <QJsonObject>
+#include <QPointer>
+
+DCORE_USE_NAMESPACE
+DWIDGET_USE_NAMESPACE
+
+static const int ShortcutCount = 2000;
+
+class BenchDSettingsWidgetFactory : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void cleanup();
+
+    void createShortcuts();
+    void importShortcuts();
+    void resetShortcuts();
+
+private:
+    static QString shortcut(int index);
+    void createItems(DSettingsWidgetFactory *factory);
+
+    QList<QPointer<DSettingsOption>> options;
+    QList<QWidget *> widgets;
+};
+
+// 生成互不相同的快捷键，形如 "Ctrl+K, X"
+QString BenchDSettingsWidgetFactory::shortcut(int index)
+{
+    static const char *prefixes[] = {"Ctrl", "Alt", "Ctrl+Shift", "Ctrl+Alt"};
+    const QChar first('A' + (index / 26) % 26);
+    const QChar second('A' + index % 26);
+    return QStringLiteral("%1+%2, %3").arg(prefixes[index / (26 * 26)]).arg(first).arg(second);
+}
+
+void BenchDSettingsWidgetFactory::createItems(DSettingsWidgetFactory *factory)
+{
+    for (int i = 0; i < ShortcutCount; ++i) {
+        QJsonObject opt;
+        opt["key"] = QStringLiteral("action%1").arg(i);
+        opt["type"] = "shortcut";
+        opt["default"] = shortcut(i);
+        QPointer<DSettingsOption> option = DSettingsOption::fromJson("keymap", opt);
+        options << option;
+        widgets << factory->createItem(option).second;
+    }
+}
+
+void BenchDSettingsWidgetFactory::cleanup()
+{
+    qDeleteAll(widgets);
+    widgets.clear();
+    for (const auto &option : options)
+        delete option.data();
+    options.clear();
+}
+
+void BenchDSettingsWidgetFactory::createShortcuts()
+{
+    DSettingsWidgetFactory factory;
+
+    QBENCHMARK_ONCE {
+        createItems(&factory);
+    }
+}
+
+void BenchDSettingsWidgetFactory::importShortcuts()
+{
+    DSettingsWidgetFactory factory;
+    createItems(&factory);
+
+    // 每轮将所有快捷键整体移动一位，每个配置项都会被修改且不产生冲突
+    int shift = 0;
+    QBENCHMARK {
+        ++shift;
+        QMap<QString, QString> keymap;
+        for (int i = 0; i < ShortcutCount; ++i)
+            keymap.insert(options.at(i)->key(), shortcut((i + shift) % ShortcutCount));
+        const QStringList rejected = factory.importShortcuts(keymap);
+        QVERIFY(rejected.isEmpty());
+    }
+}
+
+void BenchDSettingsWidgetFactory::resetShortcuts()
+{
+    DSettingsWidgetFactory factory;
+    createItems(&factory);
+
+    // 模拟恢复默认设置，逐个修改配置项的值
+    int shift = 0;
+    QBENCHMARK {
+        ++shift;
+        for (int i = 0; i < ShortcutCount; ++i)
+            options.at(i)->setValue(shortcut((i + shift) % ShortcutCount));
+    }
+}
+
+DTK_BENCHMARK_MAIN(BenchDSettingsWidgetFactory)
+
+#include "bench_dsettingswidgetfactory.moc"
@@ -0,0 +1,215 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbenchmark.h"
+
+#include <DSimpleListItem>
+#include <DSimpleListView>
+
+#include <QElapsedTimer>
+#include <QWheelEvent>
+
+DWIDGET_USE_NAMESPACE
+
+class BenchListItem : public DSimpleListItem
+{
+public:
+    explicit BenchListItem(int value)
+        : value(value)
+        , name(QStringLiteral("process-%1").arg(value))
+    {
+    }
+
+    bool sameAs(DSimpleListItem *item) override
+    {
+        return value == static_cast<BenchListItem *>(item)->value;
+    }
+
+    void drawBackground(QRect rect, QPainter *painter, int index, bool isSelect, bool isHover) override
+    {
+        if (isSelect)
+            painter->fillRect(rect, QColor(0, 129, 255));
+        else if (isHover)
+            painter->fillRect(rect, QColor(0, 0, 0, 20));
+        else if (index % 2)
+            painter->fillRect(rect, QColor(0, 0, 0, 8));
+    }
+
+    void drawForeground(QRect rect, QPainter *painter, int column, int, bool isSelect, bool) override
+    {
+        painter->setPen(isSelect ? Qt::white : Qt::black);
+        const QString text = column == 0 ? name : QString::number(value * (column + 1));
+        painter->drawText(rect.adjusted(8, 0, -8, 0), Qt::AlignVCenter | Qt::AlignLeft, text);
+    }
+
+    static bool sortByValue(const DSimpleListItem *item1, const DSimpleListItem *item2, bool descendingSort)
+    {
+        const int v1 = static_cast<const BenchListItem *>(item1)->value;
+        const int v2 = static_cast<const BenchListItem *>(item2)->value;
+        return descendingSort ? v1 > v2 : v1 < v2;
+    }
+
+    int value;
+    QString name;
+};
+
+class BenchDSimpleListView : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void addItems();
+    void paint();
+    void wheelScroll();
+    void wheelStorm();
+    void hover();
+    void sort();
+
+private:
+    static QList<DSimpleListItem *> createItems(int count);
+
+    DSimpleListView *view = nullptr;
+    QList<SortAlgorithm> sortAlgorithms;
+};
+
+static const int ItemCount = 10000;
+
+QList<DSimpleListItem *> BenchDSimpleListView::createItems(int count)
+{
+    QList<DSimpleListItem *> items;
+    items.reserve(count);
+    for (int i = 0; i < count; ++i)
+        items << new BenchListItem((i * 7919) % count);
+    return items;
+}
+
+void BenchDSimpleListView::initTestCase()
+{
+    view = new DSimpleListView;
+    view->resize(800, 600);
+    view->setRowHeight(36);
+    view->setColumnTitleInfo({"Name", "CPU", "Memory"}, {-1, 120, 120}, 36);
+    sortAlgorithms = {&BenchListItem::sortByValue, &BenchListItem::sortByValue, &BenchListItem::sortByValue};
+    view->setColumnSortingAlgorithms(&sortAlgorithms, 0);
+    view->addItems(createItems(ItemCount));
+    view->show();
+    QVERIFY(QTest::qWaitForWindowExposed(view));
+}
+
+void BenchDSimpleListView::cleanupTestCase()
+{
+    delete view;
+    view = nullptr;
+}
+
+void BenchDSimpleListView::addItems()
+{
+    DSimpleListView listView;
+    listView.resize(800, 600);
+    listView.setColumnTitleInfo({"Name", "CPU", "Memory"}, {-1, 120, 120}, 36);
+
+    QBENCHMARK_ONCE {
+        listView.addItems(createItems(ItemCount));
+    }
+}
+
+void BenchDSimpleListView::paint()
+{
+    QImage canvas(view->size(), QImage::Format_ARGB32_Premultiplied);
+    QBENCHMARK {
+        view->render(&canvas);
+    }
+}
+
+void BenchDSimpleListView::wheelScroll()
+{
+    const QPointF pos(view->width() / 2, view->height() / 2);
+    int direction = -1;
+    int steps = 0;
+
+    QBENCHMARK {
+        // 每滚动到一端后反向，保证每次都触发重绘
+        if (++steps % 200 == 0)
+            direction = -direction;
+        QWheelEvent event(pos, view->mapToGlobal(pos.toPoint()), QPoint(), QPoint(0, 120 * direction),
+                          Qt::NoButton, Qt::NoModifier, Qt::NoScrollPhase, false);
+        QCoreApplication::sendEvent(view, &event);
+        QCoreApplication::processEvents();
+    }
+}
+
+// 统计控件收到的绘制事件数量
+class PaintCounter : public QObject
+{
+public:
+    using QObject::QObject;
+
+    int paints = 0;
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (event->type() == QEvent::Paint)
+            ++paints;
+        return QObject::eventFilter(watched, event);
+    }
+};
+
+void BenchDSimpleListView::wheelStorm()
+{
+    // 模拟触摸板一次产生大量滚轮事件，事件之间不处理绘制，检查重绘能否合并
+    const QPointF pos(view->width() / 2, view->height() / 2);
+    PaintCounter counter;
+    view->installEventFilter(&counter);
+    int direction = -1;
+    int storms = 0;
+    QElapsedTimer timer;
+    timer.start();
+
+    QBENCHMARK {
+        if (++storms % 10 == 0)
+            direction = -direction;
+        for (int i = 0; i < 20; ++i) {
+            QWheelEvent event(pos, view->mapToGlobal(pos.toPoint()), QPoint(), QPoint(0, 30 * direction),
+                              Qt::NoButton, Qt::NoModifier, Qt::NoScrollPhase, false);
+            QCoreApplication::sendEvent(view, &event);
+        }
+        QCoreApplication::processEvents();
+    }
+
+    view->removeEventFilter(&counter);
+    qInfo("wheel storm: %d storms, %d paints, %.1f fps", storms, counter.paints,
+          counter.paints * 1000.0 / qMax<qint64>(1, timer.elapsed()));
+}
+
+void BenchDSimpleListView::hover()
+{
+    // 在相邻两行之间来回移动鼠标，每次都会改变悬停行
+    const QPoint first(view->width() / 2, 36 + 18);
+    const QPoint second(view->width() / 2, 36 + 54);
+    bool atFirst = false;
+
+    QBENCHMARK {
+        atFirst = !atFirst;
+        QTest::mouseMove(view, atFirst ? first : second);
+        QCoreApplication::processEvents();
+    }
+}
+
+void BenchDSimpleListView::sort()
+{
+    // 点击 CPU 列标题，每次点击都会反转排序顺序并完整排序一次
+    const QPoint titlePos(view->width() - 180, 18);
+    QBENCHMARK {
+        QTest::mousePress(view, Qt::LeftButton, Qt::NoModifier, titlePos);
+        QTest::mouseRelease(view, Qt::LeftButton, Qt::NoModifier, titlePos);
+    }
+}
+
+DTK_BENCHMARK_MAIN(BenchDSimpleListView)
+
+#include "bench_dsimplelistview.moc"
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbenchmark.h"
+
+#include <DMainWindow>
+#include <DStartupTimeline>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QTextStream>
+
+#include <algorithm>
+
+DWIDGET_USE_NAMESPACE
+
+static const char *StartupChildArgument = "--startup-child";
+
+// 最简单的 DMainWindow 程序，第一帧完成后输出启动记录并退出
+static int runStartupChild(int argc, char *argv[])
+{
+    DApplication app(argc, argv);
+    app.setApplicationName("dtk-startup-benchmark");
+    app.loadTranslator();
+    app.setSingleInstance(QString("dtk-startup-benchmark-%1").arg(app.applicationPid()));
+
+    DMainWindow window;
+    window.resize(640, 480);
+    window.show();
+
+    QObject::connect(DStartupTimeline::instance(), &DStartupTimeline::firstFrameShown, &app, [&app] {
+        QTextStream(stdout) << DStartupTimeline::instance()->toJson();
+        app.quit();
+    });
+
+    return app.exec();
+}
+
+class BenchDStartup : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void coldStart();
+    void firstFrame();
+
+private:
+    static QJsonObject runChild();
+};
+
+QJsonObject BenchDStartup::runChild()
+{
+    QProcess process;
+    process.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    process.start(QCoreApplication::applicationFilePath(), {StartupChildArgument});
+    if (!process.waitForFinished(30000) || process.exitCode() != 0)
+        return QJsonObject();
+
+    return QJsonDocument::fromJson(process.readAllStandardOutput()).object();
+}
+
+void BenchDStartup::coldStart()
+{
+    // 包含进程启动和退出的总时长
+    QBENCHMARK {
+        QVERIFY(!runChild().isEmpty());
+    }
+}
+
+void BenchDStartup::firstFrame()
+{
+    // 取多次启动的中位数作为第一帧的时间
+    QList<qint64> samples;
+    for (int i = 0; i < 5; ++i) {
+        const QJsonObject timeline = runChild();
+        QVERIFY(!timeline.isEmpty());
+        samples << qint64(timeline.value("firstFrameNsecs").toDouble());
+    }
+
+    std::sort(samples.begin(), samples.end());
+    QTest::setBenchmarkResult(samples.at(samples.size() / 2) / 1000000.0, QTest::WalltimeMilliseconds);
+}
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    if (argc > 1 && qstrcmp(argv[1], StartupChildArgument) == 0)
+        return runStartupChild(argc, argv);
+
+    DApplication app(argc, argv);
+    BenchDStartup tc;
+    return QTest::qExec(&tc, argc, argv);
+}
+
+#include "bench_dstartup.moc"
@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbenchmark.h"
+
+#include <DStyle>
+#include <DStyleOption>
+
+#include <QPainter>
+#include <QWidget>
+
+DWIDGET_USE_NAMESPACE
+
+class BenchDStyle : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void itemBackground_data();
+    void itemBackground();
+    void iconButtonPanel_data();
+    void iconButtonPanel();
+    void switchButton();
+    void floatingWidget();
+    void actionIcons_data();
+    void actionIcons();
+    void styleHints_data();
+    void styleHints();
+
+private:
+    QWidget widget;
+    QImage canvas;
+};
+
+void BenchDStyle::initTestCase()
+{
+    widget.resize(400, 300);
+    canvas = QImage(widget.size(), QImage::Format_ARGB32_Premultiplied);
+    canvas.fill(Qt::transparent);
+}
+
+void BenchDStyle::itemBackground_data()
+{
+    QTest::addColumn<int>("position");
+
+    QTest::newRow("OnlyOne") << int(DStyleOptionBackgroundGroup::OnlyOne);
+    QTest::newRow("Beginning") << int(DStyleOptionBackgroundGroup::Beginning);
+    QTest::newRow("Middle") << int(DStyleOptionBackgroundGroup::Middle);
+    QTest::newRow("End") << int(DStyleOptionBackgroundGroup::End);
+}
+
+void BenchDStyle::itemBackground()
+{
+    QFETCH(int, position);
+
+    DStyleOptionBackgroundGroup opt;
+    opt.init(&widget);
+    opt.rect = QRect(0, 0, 300, 36);
+    opt.directions = Qt::Vertical;
+    opt.position = DStyleOptionBackgroundGroup::ItemBackgroundPosition(position);
+
+    QPainter p(&canvas);
+    QBENCHMARK {
+        DStyle::drawPrimitive(widget.style(), DStyle::PE_ItemBackground, &opt, &p, &widget);
+    }
+}
+
+void BenchDStyle::iconButtonPanel_data()
+{
+    QTest::addColumn<int>("features");
+
+    QTest::newRow("Flat") << int(QStyleOptionButton::Flat);
+    QTest::newRow("Floating") << int(DStyleOptionButton::FloatingButton);
+    QTest::newRow("Circle") << int(DStyleOptionButton::CircleButton);
+    QTest::newRow("FloatingCircle") << int(DStyleOptionButton::FloatingButton | DStyleOptionButton::CircleButton);
+}
+
+void BenchDStyle::iconButtonPanel()
+{
+    QFETCH(int, features);
+
+    DStyleOptionButton opt;
+    opt.init(&widget);
+    opt.rect = QRect(0, 0, 36, 36);
+    opt.state = QStyle::State_Enabled | QStyle::State_Raised;
+    opt.features = QStyleOptionButton::ButtonFeatures(features);
+
+    QPainter p(&canvas);
+    QBENCHMARK {
+        DStyle::drawPrimitive(widget.style(), DStyle::PE_IconButtonPanel, &opt, &p, &widget);
+    }
+}
+
+void BenchDStyle::switchButton()
+{
+    DStyleOptionButton opt;
+    opt.init(&widget);
+    opt.rect = QRect(0, 0, 50, 24);
+    opt.state = QStyle::State_Enabled | QStyle::State_On;
+
+    QPainter p(&canvas);
+    QBENCHMARK {
+        DStyle::drawPrimitive(widget.style(), DStyle::PE_SwitchButtonGroove, &opt, &p, &widget);
+        DStyle::drawPrimitive(widget.style(), DStyle::PE_SwitchButtonHandle, &opt, &p, &widget);
+    }
+}
+
+void BenchDStyle::floatingWidget()
+{
+    DStyleOptionFloatingWidget opt;
+    opt.init(&widget);
+    opt.rect = QRect(0, 0, 300, 200);
+    opt.noBackground = false;
+
+    QPainter p(&canvas);
+    QBENCHMARK {
+        DStyle::drawPrimitive(widget.style(), DStyle::PE_FloatingWidget, &opt, &p, &widget);
+    }
+}
+
+void BenchDStyle::actionIcons_data()
+{
+    QTest::addColumn<int>("pixmap");
+
+    QTest::newRow("ArrowEnter") << int(DStyle::SP_ArrowEnter);
+    QTest::newRow("SelectElement") << int(DStyle::SP_SelectElement);
+    QTest::newRow("IndicatorChecked") << int(DStyle::SP_IndicatorChecked);
+}
+
+void BenchDStyle::actionIcons()
+{
+    QFETCH(int, pixmap);
+
+    QStyleOption opt;
+    opt.init(&widget);
+
+    // 与列表中的 action 一样，每次绘制时重新获取图标
+    QPainter p(&canvas);
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i) {
+            const QIcon icon = DStyle::standardIcon(widget.style(), DStyle::StandardPixmap(pixmap), &opt, &widget);
+            p.drawPixmap(QPoint((i % 20) * 20, (i / 20 % 15) * 20), icon.pixmap(QSize(16, 16)));
+        }
+    }
+}
+
+void BenchDStyle::styleHints_data()
+{
+    QTest::addColumn<int>("hint");
+
+    QTest::newRow("UnderlineShortcut") << int(QStyle::SH_UnderlineShortcut);
+    QTest::newRow("MenuKeyboardSearch") << int(QStyle::SH_Menu_KeyboardSearch);
+    QTest::newRow("PasswordCharacter") << int(QStyle::SH_LineEdit_PasswordCharacter);
+}
+
+void BenchDStyle::styleHints()
+{
+    QFETCH(int, hint);
+
+    // 绘制菜单时每个菜单项都会查询这些风格策略
+    DStyle style;
+    int result = 0;
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i)
+            result += style.styleHint(QStyle::StyleHint(hint), nullptr, &widget);
+    }
+    Q_UNUSED(result)
+}
+
+DTK_BENCHMARK_MAIN(BenchDStyle)
+
+#include "bench_dstyle.moc"
@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbenchmark.h"
+
+#include <DListView>
+#include <DStyledItemDelegate>
+
+#include <QPainter>
+#include <QStandardItemModel>
+
+DWIDGET_USE_NAMESPACE
+
+class BenchDStyledItemDelegate : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void paint_data();
+    void paint();
+    void sizeHint_data();
+    void sizeHint();
+
+private:
+    void addRows(bool withActions);
+    QStyleOptionViewItem viewOption(const QModelIndex &index) const;
+
+    DListView *view = nullptr;
+    QStandardItemModel *model = nullptr;
+    DStyledItemDelegate *delegate = nullptr;
+};
+
+static const int RowCount = 200;
+
+void BenchDStyledItemDelegate::initTestCase()
+{
+    view = new DListView;
+    model = new QStandardItemModel(view);
+    delegate = new DStyledItemDelegate(view);
+    delegate->setBackgroundType(DStyledItemDelegate::RoundedBackground);
+    view->setItemDelegate(delegate);
+    view->setModel(model);
+    view->resize(400, 600);
+
+    // 前半部分为纯文本，后半部分带有左右两侧的 action
+    addRows(false);
+    addRows(true);
+}
+
+void BenchDStyledItemDelegate::cleanupTestCase()
+{
+    delete view;
+    view = nullptr;
+}
+
+void BenchDStyledItemDelegate::addRows(bool withActions)
+{
+    const QIcon icon = view->style()->standardIcon(QStyle::SP_DirIcon);
+    for (int i = 0; i < RowCount; ++i) {
+        auto item = new DStandardItem(icon, QStringLiteral("Item %1 with some descriptive text").arg(i));
+        if (withActions) {
+            auto left = new DViewItemAction(Qt::AlignVCenter, QSize(16, 16), QSize(), true);
+            left->setIcon(icon);
+            auto right = new DViewItemAction(Qt::AlignVCenter, QSize(16, 16), QSize(), false);
+            right->setText(QStringLiteral("%1 KB").arg(i * 3));
+            item->setActionList(Qt::LeftEdge, {left});
+            item->setActionList(Qt::RightEdge, {right});
+        }
+        model->appendRow(item);
+    }
+}
+
+QStyleOptionViewItem BenchDStyledItemDelegate::viewOption(const QModelIndex &index) const
+{
+    QStyleOptionViewItem option;
+    option.initFrom(view);
+    option.rect = view->visualRect(index);
+    if (!option.rect.isValid())
+        option.rect = QRect(0, 0, view->width(), 36);
+    option.state |= QStyle::State_Enabled;
+    option.decorationSize = QSize(24, 24);
+    return option;
+}
+
+void BenchDStyledItemDelegate::paint_data()
+{
+    QTest::addColumn<int>("firstRow");
+
+    QTest::newRow("Text") << 0;
+    QTest::newRow("Actions") << RowCount;
+}
+
+void BenchDStyledItemDelegate::paint()
+{
+    QFETCH(int, firstRow);
+
+    QImage canvas(view->width(), 40, QImage::Format_ARGB32_Premultiplied);
+    canvas.fill(Qt::transparent);
+    QPainter p(&canvas);
+
+    QBENCHMARK {
+        for (int row = firstRow; row < firstRow + RowCount; ++row) {
+            const QModelIndex index = model->index(row, 0);
+            QStyleOptionViewItem option = viewOption(index);
+            option.rect.moveTop(0);
+            delegate->paint(&p, option, index);
+        }
+    }
+}
+
+void BenchDStyledItemDelegate::sizeHint_data()
+{
+    paint_data();
+}
+
+void BenchDStyledItemDelegate::sizeHint()
+{
+    QFETCH(int, firstRow);
+
+    QBENCHMARK {
+        for (int row = firstRow; row < firstRow + RowCount; ++row) {
+            const QModelIndex index = model->index(row, 0);
+            delegate->sizeHint(viewOption(index), index);
+        }
+    }
+}
+
+DTK_BENCHMARK_MAIN(BenchDStyledItemDelegate)
+
+#include "bench_dstyleditemdelegate.moc"
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbenchmark.h"
+
+#include <DGuiApplicationHelper>
+#include <dswitchbutton.h>
+
+#include <QGridLayout>
+
+DGUI_USE_NAMESPACE
+DWIDGET_USE_NAMESPACE
+
+// 模拟一个包含大量开关的设置页面
+static const int SwitchCount = 60;
+
+class BenchDSwitchButton : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void createAndPaint();
+    void toggle();
+    void themeChanged();
+
+private:
+    void createSwitches();
+
+    QWidget *page = nullptr;
+    QList<DSwitchButton *> switches;
+};
+
+void BenchDSwitchButton::init()
+{
+    page = new QWidget;
+    page->resize(800, 600);
+}
+
+void BenchDSwitchButton::cleanup()
+{
+    delete page;
+    page = nullptr;
+    switches.clear();
+}
+
+void BenchDSwitchButton::createSwitches()
+{
+    auto layout = new QGridLayout(page);
+    for (int i = 0; i < SwitchCount; ++i) {
+        auto button = new DSwitchButton(page);
+        button->setChecked(i % 2);
+        layout->addWidget(button, i / 6, i % 6);
+        switches << button;
+    }
+}
+
+void BenchDSwitchButton::createAndPaint()
+{
+    QImage canvas(page->size(), QImage::Format_ARGB32_Premultiplied);
+    QBENCHMARK_ONCE {
+        createSwitches();
+        page->render(&canvas);
+    }
+}
+
+void BenchDSwitchButton::toggle()
+{
+    createSwitches();
+    QImage canvas(page->size(), QImage::Format_ARGB32_Premultiplied);
+    page->render(&canvas);
+
+    QBENCHMARK {
+        for (auto button : switches)
+            button->click();
+        page->render(&canvas);
+    }
+}
+
+void BenchDSwitchButton::themeChanged()
+{
+    createSwitches();
+    QImage canvas(page->size(), QImage::Format_ARGB32_Premultiplied);
+    page->render(&canvas);
+
+    auto helper = DGuiApplicationHelper::instance();
+    QBENCHMARK {
+        Q_EMIT helper->themeTypeChanged(helper->themeType());
+        page->render(&canvas);
+    }
+}
+
+DTK_BENCHMARK_MAIN(BenchDSwitchButton)
+
+#include "bench_dswitchbutton.moc"
@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dbenchmark.h"
+
+#include <dwatermarkwidget.h>
+
+#include <QLabel>
+#include <QScrollArea>
+#include <QScrollBar>
+#include <QVBoxLayout>
+
+DWIDGET_USE_NAMESPACE
+
+class BenchDWaterMarkWidget : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void paint_data();
+    void paint();
+    void exposeStrip_data();
+    void exposeStrip();
+    void scroll_data();
+    void scroll();
+
+private:
+    void addRotations();
+    void setRotation(qreal rotation);
+
+    QWidget *window = nullptr;
+    QScrollArea *scrollArea = nullptr;
+    DWaterMarkWidget *watermark = nullptr;
+};
+
+void BenchDWaterMarkWidget::initTestCase()
+{
+    window = new QWidget;
+    window->resize(1280, 800);
+    auto layout = new QVBoxLayout(window);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    QString text;
+    for (int i = 0; i < 2000; ++i)
+        text += QStringLiteral("line %1 of the scrolled document\n").arg(i);
+    scrollArea = new QScrollArea(window);
+    scrollArea->setWidget(new QLabel(text));
+    layout->addWidget(scrollArea);
+
+    // 水印覆盖在整个窗口上，下方内容的任何重绘都会引起水印重绘
+    watermark = new DWaterMarkWidget(window);
+    watermark->resize(window->size());
+    watermark->raise();
+
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window));
+}
+
+void BenchDWaterMarkWidget::cleanupTestCase()
+{
+    delete window;
+    window = nullptr;
+}
+
+void BenchDWaterMarkWidget::addRotations()
+{
+    QTest::addColumn<qreal>("rotation");
+
+    QTest::newRow("0") << qreal(0);
+    QTest::newRow("-30") << qreal(-30);
+    QTest::newRow("45") << qreal(45);
+}
+
+void BenchDWaterMarkWidget::setRotation(qreal rotation)
+{
+    WaterMarkData data = watermark->data();
+    data.setType(WaterMarkData::Text);
+    data.setLayout(WaterMarkData::Tiled);
+    data.setText(QStringLiteral("deepin water mark"));
+    data.setSpacing(40);
+    data.setLineSpacing(80);
+    data.setColor(Qt::gray);
+    data.setOpacity(0.3);
+    data.setRotation(rotation);
+    watermark->setData(data);
+    QCoreApplication::processEvents();
+}
+
+void BenchDWaterMarkWidget::paint_data()
+{
+    addRotations();
+}
+
+void BenchDWaterMarkWidget::paint()
+{
+    QFETCH(qreal, rotation);
+    setRotation(rotation);
+
+    QImage canvas(watermark->size(), QImage::Format_ARGB32_Premultiplied);
+    QBENCHMARK {
+        watermark->render(&canvas);
+    }
+}
+
+void BenchDWaterMarkWidget::exposeStrip_data()
+{
+    addRotations();
+}
+
+void BenchDWaterMarkWidget::exposeStrip()
+{
+    QFETCH(qreal, rotation);
+    setRotation(rotation);
+
+    // 滚动一行时只有新露出的一条需要重绘
+    QImage canvas(watermark->size(), QImage::Format_ARGB32_Premultiplied);
+    const QRegion strip(0, watermark->height() - 40, watermark->width(), 40);
+    QBENCHMARK {
+        watermark->render(&canvas, QPoint(), strip);
+    }
+}
+
+void BenchDWaterMarkWidget::scroll_data()
+{
+    addRotations();
+}
+
+void BenchDWaterMarkWidget::scroll()
+{
+    QFETCH(qreal, rotation);
+    setRotation(rotation);
+
+    QScrollBar *bar = scrollArea->verticalScrollBar();
+    int direction = 1;
+    QBENCHMARK {
+        // 到达一端后反向，保证每次都触发重绘
+        if (bar->value() + direction * 40 > bar->maximum() || bar->value() + direction * 40 < 0)
+            direction = -direction;
+        bar->setValue(bar->value() + direction * 40);
+        QCoreApplication::processEvents();
+    }
+}
+
+DTK_BENCHMARK_MAIN(BenchDWaterMarkWidget)
+
+#include "bench_dwatermarkwidget.moc"
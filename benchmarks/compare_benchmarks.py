@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+# SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+#
+# SPDX-License-Identifier: LGPL-3.0-or-later
+
+"""Collect Qt Test benchmark results and compare them with a baseline.
+
+Each benchmark executable writes a csv file (``-o <file>,csv``) into the
+results directory. This script merges them into one JSON document, optionally
+stores it as the new baseline, and reports every benchmark whose per-iteration
+cost grew by more than the allowed threshold. The exit code is non-zero when a
+regression is found, so it can be used as a CI gate.
+"""
+
+import argparse
+import csv
+import json
+import os
+import sys
+
+
+def is_number(text):
+    try:
+        float(text)
+        return True
+    except ValueError:
+        return False
+
+
+def parse_csv(path):
+    """Return {name: {"metric": str, "value": float, "iterations": int}}."""
+    results = {}
+    suite = os.path.splitext(os.path.basename(path))[0]
+    with open(path, newline='') as f:
+        for row in csv.reader(f):
+            # Qt prints "function","tag","metric",value,total,iterations,...
+            # The columns are read by position because data tags may be numbers.
+            if len(row) < 6 or not is_number(row[3]) or not is_number(row[5]):
+                continue
+            function, tag, metric = row[0], row[1], row[2]
+            name = '%s:%s' % (function, tag) if tag else function
+            results['%s::%s' % (suite, name)] = {
+                'metric': metric,
+                'value': float(row[3]),
+                'iterations': int(float(row[5])),
+            }
+    return results
+
+
+def collect(results_dir):
+    results = {}
+    for entry in sorted(os.listdir(results_dir)):
+        if entry.endswith('.csv'):
+            results.update(parse_csv(os.path.join(results_dir, entry)))
+    return results
+
+
+def compare(baseline, results, threshold):
+    regressions = []
+    improvements = []
+    for name, current in sorted(results.items()):
+        base = baseline.get(name)
+        if base is None or base['metric'] != current['metric'] or base['value'] <= 0:
+            continue
+        change = (current['value'] - base['value']) / base['value'] * 100
+        if change > threshold:
+            regressions.append((name, base, current, change))
+        elif change < -threshold:
+            improvements.append((name, base, current, change))
+    return regressions, improvements
+
+
+def print_changes(title, changes):
+    if not changes:
+        return
+    print(title)
+    for name, base, current, change in changes:
+        print('  %-70s %14.4f -> %14.4f %s (%+.1f%%)'
+              % (name, base['value'], current['value'], current['metric'], change))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--results', required=True, help='directory containing the csv results')
+    parser.add_argument('--baseline', help='baseline json to compare with')
+    parser.add_argument('--threshold', type=float, default=10.0, help='allowed slowdown in percent (default: 10)')
+    parser.add_argument('--json', help='also write the merged results to this json file')
+    parser.add_argument('--write-baseline', help='store the merged results as a new baseline and exit')
+    args = parser.parse_args()
+
+    results = collect(args.results)
+    if not results:
+        print('No benchmark results found in %s' % args.results, file=sys.stderr)
+        return 2
+
+    document = {'benchmarks': results}
+    if args.json:
+        with open(args.json, 'w') as f:
+            json.dump(document, f, indent=2, sort_keys=True)
+
+    if args.write_baseline:
+        with open(args.write_baseline, 'w') as f:
+            json.dump(document, f, indent=2, sort_keys=True)
+        print('Baseline with %d benchmarks written to %s' % (len(results), args.write_baseline))
+        return 0
+
+    if not args.baseline or not os.path.exists(args.baseline):
+        print('No baseline found, run the benchmark-baseline target first. %d results collected.' % len(results))
+        return 0
+
+    with open(args.baseline) as f:
+        baseline = json.load(f).get('benchmarks', {})
+
+    regressions, improvements = compare(baseline, results, args.threshold)
+    missing = sorted(set(baseline) - set(results))
+
+    print_changes('Improvements:', improvements)
+    print_changes('Regressions:', regressions)
+    if missing:
+        print('Missing from this run:')
+        for name in missing:
+            print('  %s' % name)
+
+    print('%d benchmarks compared, %d regressions over %.1f%%'
+          % (len(set(baseline) & set(results)), len(regressions), args.threshold))
+    return 1 if regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DBENCHMARK_H
+#define DBENCHMARK_H
+
+#include <DApplication>
+
+#include <QTest>
+
+/**
+  基准测试入口，默认使用 offscreen 平台，使结果不依赖显示服务器.
+ */
+#define DTK_BENCHMARK_MAIN(TestObject) \
+int main(int argc, char *argv[]) \
+{ \
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) \
+        qputenv("QT_QPA_PLATFORM", "offscreen"); \
+    Dtk::Widget::DApplication app(argc, argv); \
+    TestObject tc; \
+    return QTest::qExec(&tc, argc, argv); \
+}
+
+#endif // DBENCHMARK_H
@@ -14,6 +14,7 @@ message(STATUS "Current Dtk Version: ${DTK_VERSION_MAJOR}")
 set(BUILD_EXAMPLES ON CACHE BOOL "Build examples")
 set(BUILD_VERSION "0" CACHE STRING "buildversion")
 set(BUILD_PLUGINS ON CACHE BOOL "Build plugin and plugin example")
+set(BUILD_BENCHMARKS OFF CACHE BOOL "Build benchmarks")
 
 set(INCLUDE_INSTALL_DIR
     "${CMAKE_INSTALL_INCLUDEDIR}/dtk${PROJECT_VERSION_MAJOR}/DWidget"
@@ -116,6 +117,13 @@ if(BUILD_TESTING)
   enable_testing()
   add_subdirectory(tests)
 endif()
+if(BUILD_BENCHMARKS)
+  message(STATUS "==================================")
+  message(STATUS "     Now Benchmarks are enabled   ")
+  message(STATUS "==================================")
+  enable_testing()
+  add_subdirectory(benchmarks)
+endif()
 if(BUILD_EXAMPLES)
   message(STATUS "===================================")
   message(STATUS "You can build and run examples now ")
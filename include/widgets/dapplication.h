@@ -37,6 +37,7 @@ class LIBDTKWIDGETSHARED_EXPORT DApplication : public QApplication, public DTK_C
     Q_PROPERTY(bool visibleMenuCheckboxWidget READ visibleMenuCheckboxWidget WRITE setVisibleMenuCheckboxWidget)
     Q_PROPERTY(bool visibleMenuIcon READ visibleMenuIcon WRITE setVisibleMenuIcon)
     Q_PROPERTY(bool autoActivateWindows READ autoActivateWindows WRITE setAutoActivateWindows)
+    Q_PROPERTY(bool virtualKeyboardPanOnly READ virtualKeyboardPanOnly WRITE setVirtualKeyboardPanOnly)
     Q_PROPERTY(QString applicationCreditsFile READ applicationCreditsFile WRITE setApplicationCreditsFile)
     Q_PROPERTY(QByteArray applicationCreditsContent READ applicationCreditsContent WRITE setApplicationCreditsContent)
     Q_PROPERTY(QString licensePath READ licensePath WRITE setLicensePath)
@@ -126,6 +127,8 @@ public:
     void acclimatizeVirtualKeyboard(QWidget *window);
     void ignoreVirtualKeyboard(QWidget *window);
     bool isAcclimatizedVirtualKeyboard(QWidget *window) const;
+    bool virtualKeyboardPanOnly() const;
+    void setVirtualKeyboardPanOnly(bool panOnly);
 
     QString applicationCreditsFile() const;
     void setApplicationCreditsFile(const QString &file);
@@ -172,6 +175,9 @@ protected:
 public:
     bool notify(QObject *obj, QEvent *event) Q_DECL_OVERRIDE;
 
+protected:
+    bool event(QEvent *event) Q_DECL_OVERRIDE;
+
 private:
     friend class DTitlebarPrivate;
     friend class DMainWindowPrivate;
@@ -129,6 +129,7 @@ public:
     ~DBlurEffectGroup();
 
     void setSourceImage(QImage image, int blurRadius = 35);
+    void setSourceImageAsync(QImage image, int blurRadius = 35);
     void addWidget(DBlurEffectWidget *widget, const QPoint &offset = QPoint(0, 0));
     void removeWidget(DBlurEffectWidget *widget);
 
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DCACHEREGISTRY_H
+#define DCACHEREGISTRY_H
+
+#include <dtkwidget_global.h>
+#include <DObject>
+
+#include <QObject>
+
+#include <functional>
+
+DWIDGET_BEGIN_NAMESPACE
+
+class DCacheRegistryPrivate;
+class LIBDTKWIDGETSHARED_EXPORT DCacheRegistry : public QObject, public DCORE_NAMESPACE::DObject
+{
+    Q_OBJECT
+    Q_PROPERTY(qint64 budget READ budget WRITE setBudget)
+    Q_PROPERTY(qint64 totalCost READ totalCost)
+
+public:
+    typedef std::function<void()> Evictor;
+
+    struct Statistics {
+        QString cacheName;
+        int entries = 0;
+        qint64 cost = 0;
+        quint64 accesses = 0;
+        quint64 evictions = 0;
+        qint64 evictedCost = 0;
+    };
+
+    static DCacheRegistry *instance();
+
+    quint64 registerEntry(const QString &cacheName, qint64 cost = 0, Evictor evictor = nullptr);
+    void unregisterEntry(quint64 id);
+    void updateCost(quint64 id, qint64 cost);
+    void touch(quint64 id);
+
+    qint64 budget() const;
+    void setBudget(qint64 bytes);
+    qint64 totalCost() const;
+
+    QList<Statistics> statistics() const;
+    qint64 trim(qint64 targetCost);
+
+public Q_SLOTS:
+    void notifyMemoryPressure();
+
+Q_SIGNALS:
+    void memoryPressure();
+
+private:
+    explicit DCacheRegistry(QObject *parent = nullptr);
+    ~DCacheRegistry() override;
+
+    D_DECLARE_PRIVATE(DCacheRegistry)
+};
+
+DWIDGET_END_NAMESPACE
+
+#endif // DCACHEREGISTRY_H
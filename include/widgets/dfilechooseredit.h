@@ -42,6 +42,12 @@ public:
 
     void initDialog();
 
+    void setCompletionEnabled(bool enabled);
+    bool completionEnabled() const;
+
+    void setPathValidationEnabled(bool enabled);
+    bool pathValidationEnabled() const;
+
 Q_SIGNALS:
     void fileChoosed(const QString &fileName);
     void dialogOpened();
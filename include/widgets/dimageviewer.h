@@ -9,6 +9,8 @@
 #include <DGraphicsView>
 #include <DObject>
 
+#include <QFuture>
+
 DWIDGET_BEGIN_NAMESPACE
 
 class DImageViewerPrivate;
@@ -28,6 +30,7 @@ public:
     ~DImageViewer() Q_DECL_OVERRIDE;
 
     QImage image() const;
+    QFuture<QImage> imageAsync() const;
     void setImage(const QImage &image);
     QString fileName() const;
     void setFileName(const QString &fileName);
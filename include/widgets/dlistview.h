@@ -26,6 +26,14 @@ public:
     bool insertRows(int row, int count, const QModelIndex &parent = QModelIndex()) Q_DECL_OVERRIDE;
     bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) Q_DECL_OVERRIDE;
 
+    bool insertItems(int row, const QVariantList &items);
+    bool insertItems(int row, QVariantList &&items);
+    bool appendItems(const QVariantList &items);
+    bool appendItems(QVariantList &&items);
+    void replaceAll(const QVariantList &items);
+    void replaceAll(QVariantList &&items);
+    bool removeItems(int row, int count);
+
 private:
     QList<QVariant> dataList;
 };
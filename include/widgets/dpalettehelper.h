@@ -27,6 +27,9 @@ public:
     void setPalette(QWidget *widget, const DPalette &palette);
     void resetPalette(QWidget *widget);
 
+    QBrush brush(const QWidget *widget, DPalette::ColorType type, QPalette::ColorGroup group = QPalette::Current) const;
+    QColor color(const QWidget *widget, DPalette::ColorType type, QPalette::ColorGroup group = QPalette::Current) const;
+
 private:
     DPaletteHelper(QObject *parent = nullptr);
     ~DPaletteHelper() override;
@@ -135,6 +135,7 @@ public Q_SLOTS:
     void turnEnd();
     void setCurrentPage(int page);
     void print(bool isSavedPicture = false);
+    void cancelPrint();
     void themeTypeChanged(DGuiApplicationHelper::ColorType themeType);
 
 Q_SIGNALS:
@@ -144,6 +145,8 @@ Q_SIGNALS:
     void currentPageChanged(int page);
     void totalPages(int);
     void pagesCountChanged(int pages);
+    void printProgressChanged(qint64 bytesSent, qint64 bytesTotal);
+    void printFinished(bool success);
 
 private:
     void timerEvent(QTimerEvent *event) override;
@@ -30,10 +30,14 @@ public:
     void setPlaceholderText(const QString &text);
     QString placeholderText() const;
 
+    void setSearchDelay(int msec);
+    int searchDelay() const;
+
 Q_SIGNALS:
     void voiceInputFinished();
     void searchAborted();
     void voiceChanged();
+    void searchRequested(const QString &text);
 
 protected:
     Q_DISABLE_COPY(DSearchEdit)
@@ -6,8 +6,10 @@
 
 #include <functional>
 
+#include <QMap>
 #include <QObject>
 #include <QScopedPointer>
+#include <QStringList>
 
 #include <dtkwidget_global.h>
 
@@ -41,6 +43,8 @@ public:
 #endif
     static QPair<QWidget*, QWidget*> createStandardItem(const QByteArray &translateContext, DTK_CORE_NAMESPACE::DSettingsOption *option, QWidget *rightWidget);
 
+    QStringList importShortcuts(const QMap<QString, QString> &keymap);
+
 private:
     QScopedPointer<DSettingsWidgetFactoryPrivate> dd_ptr;
     Q_DECLARE_PRIVATE_D(qGetPtrHelper(dd_ptr), DSettingsWidgetFactory)
@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DSTARTUPTIMELINE_H
+#define DSTARTUPTIMELINE_H
+
+#include <dtkwidget_global.h>
+#include <DObject>
+
+#include <QObject>
+
+#include <functional>
+
+DWIDGET_BEGIN_NAMESPACE
+
+class DStartupTimelinePrivate;
+class LIBDTKWIDGETSHARED_EXPORT DStartupTimeline : public QObject, public DCORE_NAMESPACE::DObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool firstFrameShown READ isFirstFrameShown NOTIFY firstFrameShown)
+
+public:
+    struct Phase {
+        QString name;
+        qint64 startNsecs = 0;
+        qint64 durationNsecs = 0;
+        bool deferred = false;
+    };
+
+    static DStartupTimeline *instance();
+
+    qint64 elapsed() const;
+    void beginPhase(const QString &name);
+    void endPhase(const QString &name);
+    void addPhase(const QString &name, qint64 startNsecs, qint64 durationNsecs, bool deferred = false);
+    QList<Phase> phases() const;
+
+    bool isFirstFrameShown() const;
+    qint64 firstFrameNsecs() const;
+    void callAfterFirstFrame(QObject *context, std::function<void()> function);
+
+    QByteArray toJson() const;
+
+Q_SIGNALS:
+    void firstFrameShown();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    explicit DStartupTimeline(QObject *parent = nullptr);
+    ~DStartupTimeline() override;
+
+    D_DECLARE_PRIVATE(DStartupTimeline)
+};
+
+DWIDGET_END_NAMESPACE
+
+#endif // DSTARTUPTIMELINE_H
@@ -447,6 +447,7 @@ public:
 
     typedef std::function<void(QPainter *, const QRectF &rect)> DrawFun;
     DStyledIconEngine(DrawFun drawFun, const QString &iconName = QString());
+    ~DStyledIconEngine() override;
 
     void bindDrawFun(DrawFun drawFun);
     void setIconName(const QString &name);
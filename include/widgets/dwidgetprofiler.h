@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DWIDGETPROFILER_H
+#define DWIDGETPROFILER_H
+
+#include <dtkwidget_global.h>
+#include <DObject>
+
+#include <QObject>
+#include <QVector>
+
+DWIDGET_BEGIN_NAMESPACE
+
+class DWidgetProfilerPrivate;
+class LIBDTKWIDGETSHARED_EXPORT DWidgetProfiler : public QObject, public DCORE_NAMESPACE::DObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool enabled READ isEnabled WRITE setEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(bool overlayEnabled READ isOverlayEnabled WRITE setOverlayEnabled)
+    Q_PROPERTY(int slowThreshold READ slowThreshold WRITE setSlowThreshold)
+
+public:
+    enum EventType {
+        PaintEvent,
+        LayoutRequestEvent,
+        ResizeEvent,
+        StyleChangeEvent,
+        EventTypeCount
+    };
+    Q_ENUM(EventType)
+
+    struct Record {
+        QString className;
+        QString objectName;
+        EventType eventType = PaintEvent;
+        quint64 count = 0;
+        qint64 totalNsecs = 0;
+        qint64 maxNsecs = 0;
+        QVector<quint64> histogram;
+    };
+
+    static DWidgetProfiler *instance();
+
+    bool isEnabled() const;
+    void setEnabled(bool enabled);
+
+    bool isOverlayEnabled() const;
+    void setOverlayEnabled(bool enabled);
+
+    int slowThreshold() const;
+    void setSlowThreshold(int usecs);
+
+    QList<Record> classRecords() const;
+    QList<Record> objectRecords() const;
+    static QVector<qint64> histogramBounds();
+
+    QByteArray toJson() const;
+    bool dumpJson(const QString &fileName) const;
+    void reset();
+
+Q_SIGNALS:
+    void enabledChanged(bool enabled);
+
+private:
+    explicit DWidgetProfiler(QObject *parent = nullptr);
+    ~DWidgetProfiler() override;
+
+    D_DECLARE_PRIVATE(DWidgetProfiler)
+};
+
+DWIDGET_END_NAMESPACE
+
+#endif // DWIDGETPROFILER_H
@@ -16,6 +16,8 @@
 #endif
 #include <QDebug>
 #include <QDir>
+#include <QFile>
+#include <QFutureWatcher>
 #include <QLocalSocket>
 #include <QLibraryInfo>
 #include <QTranslator>
@@ -23,6 +25,7 @@
 #include <QPixmapCache>
 #include <QProcess>
 #include <QMenu>
+#include <QLayout>
 #include <QStyleFactory>
 #include <QSystemSemaphore>
 #include <QtConcurrent/QtConcurrent>
@@ -44,6 +47,11 @@
 #include "dfeaturedisplaydialog.h"
 #include "dmainwindow.h"
 #include "dsizemode.h"
+#include "dstartuptimeline.h"
+#include "private/dstartuptimeline_p.h"
+#include "private/dpalettehelper_p.h"
+#include "private/dstyle_p.h"
+#include "private/dwidgetprofiler_p.h"
 
 #include <DPlatformHandle>
 #include <DGuiApplicationHelper>
@@ -109,6 +117,11 @@ DApplicationPrivate::DApplicationPrivate(DApplication *q) :
 
 DApplicationPrivate::~DApplicationPrivate()
 {
+    // 未使用的预加载翻译
+    if (dtkTranslatorPrefetching) {
+        delete dtkTranslatorFuture.result().translator;
+    }
+
     if (m_localServer) {
         m_localServer->close();
     }
@@ -233,11 +246,10 @@ bool DApplicationPrivate::setSingleInstanceByDbus(const QString &key)
 }
 #endif
 
-bool DApplicationPrivate::loadDtkTranslator(QList<QLocale> localeFallback)
+QList<QString> DApplicationPrivate::dtkTranslateDirs()
 {
     QList<QString> translateDirs;
     auto dtkwidgetDir = DWIDGET_TRANSLATIONS_DIR;
-    auto dtkwidgetName = "dtkwidget";
 
     //("/home/user/.local/share", "/usr/local/share", "/usr/share")
     auto dataDirs = DStandardPaths::standardLocations(QStandardPaths::GenericDataLocation);
@@ -250,7 +262,138 @@ bool DApplicationPrivate::loadDtkTranslator(QList<QLocale> localeFallback)
     translateDirs << QString(":/dtk/translations");
 #endif
 
-    return DGuiApplicationHelper::loadTranslator(dtkwidgetName, translateDirs, localeFallback);
+    return translateDirs;
+}
+
+/*!
+  \internal
+  \brief 在后台线程查找并加载 \a locale 对应的 dtkwidget 翻译.
+
+  只查找 DGuiApplicationHelper::loadTranslator 最先尝试的完整 locale 名称，找到后将翻译移动到 \a thread 中。
+ */
+static DtkTranslatorPrefetch prefetchDtkTranslator(const QList<QString> &translateDirs, const QLocale &locale, QThread *thread)
+{
+    DtkTranslatorPrefetch result;
+    result.locale = locale;
+    result.startNsecs = DStartupTimelinePrivate::processElapsed();
+
+    const QString fileName = QString("dtkwidget_%1").arg(locale.name());
+    for (const auto &path : translateDirs) {
+        const QString translatePath = path + QLatin1Char('/') + fileName;
+        if (!QFile::exists(translatePath + ".qm"))
+            continue;
+
+        QScopedPointer<QTranslator> translator(new QTranslator);
+        if (translator->load(translatePath)) {
+            translator->moveToThread(thread);
+            result.translator = translator.take();
+        }
+        break;
+    }
+
+    result.durationNsecs = DStartupTimelinePrivate::processElapsed() - result.startNsecs;
+    return result;
+}
+
+bool DApplicationPrivate::loadDtkTranslator(QList<QLocale> localeFallback)
+{
+    D_Q(DApplication);
+
+    // 优先使用构造时预先加载的翻译，语言不同或没有找到时再按顺序查找
+    if (dtkTranslatorPrefetching) {
+        dtkTranslatorPrefetching = false;
+        const DtkTranslatorPrefetch prefetch = dtkTranslatorFuture.result();
+        DStartupTimeline::instance()->addPhase("dtkTranslatorPrefetch", prefetch.startNsecs, prefetch.durationNsecs, true);
+
+        if (prefetch.translator) {
+            if (!localeFallback.isEmpty() && localeFallback.first() == prefetch.locale) {
+                prefetch.translator->setParent(q);
+                q->installTranslator(prefetch.translator);
+                return true;
+            }
+            delete prefetch.translator;
+        }
+    }
+
+    return DGuiApplicationHelper::loadTranslator("dtkwidget", dtkTranslateDirs(), localeFallback);
+}
+
+#if defined(Q_OS_LINUX) && QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+struct DApplicationSettings
+{
+    int pixmapCacheLimit = -1;
+    int longpressDuration = -1;
+    qint64 startNsecs = 0;
+    qint64 durationNsecs = 0;
+};
+
+static DApplicationSettings readApplicationSettings()
+{
+    DApplicationSettings settings;
+    settings.startNsecs = DStartupTimelinePrivate::processElapsed();
+
+    // qpixmap cache limit
+    if (QGSettings::isSchemaInstalled("com.deepin.dde.dapplication"))
+    {
+        QGSettings gsettings("com.deepin.dde.dapplication", "/com/deepin/dde/dapplication/");
+        if (gsettings.keys().contains("qpixmapCacheLimit"))
+            settings.pixmapCacheLimit = gsettings.get("qpixmap-cache-limit").toInt();
+    }
+
+    // QTapAndHoldGesture::timeout
+    if (QGSettings::isSchemaInstalled("com.deepin.dde.touchscreen")) {
+        QGSettings gsettings("com.deepin.dde.touchscreen");
+        if (gsettings.keys().contains("longpressDuration"))
+            settings.longpressDuration = gsettings.get("longpress-duration").toInt();
+    }
+
+    settings.durationNsecs = DStartupTimelinePrivate::processElapsed() - settings.startNsecs;
+    return settings;
+}
+#endif
+
+/*!
+  \internal
+  \brief 启动显示窗口前不必须完成的工作在后台线程执行.
+
+  gsettings 的配置在读取完成后再应用，dtkwidget 的翻译在 loadTranslator 时再安装。
+ */
+void DApplicationPrivate::startDeferredStartupWork()
+{
+    D_Q(DApplication);
+
+#if defined(Q_OS_LINUX) && QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    auto settingsWatcher = new QFutureWatcher<DApplicationSettings>(q);
+    QObject::connect(settingsWatcher, &QFutureWatcherBase::finished, q, [settingsWatcher] {
+        const DApplicationSettings settings = settingsWatcher->result();
+        settingsWatcher->deleteLater();
+
+        if (settings.pixmapCacheLimit >= 0)
+            QPixmapCache::setCacheLimit(settings.pixmapCacheLimit);
+
+        if (settings.longpressDuration >= 0)
+            // NOTE(hualet): -100 is a workaround against the situation that that sometimes longpress
+            // and release on Dock cause App launches which should be avoided.
+            //
+            // I guess it happens like this: longpress happens on Dock,
+            // Dock menu shows(doesn't grab the mouse which is a bug can't be fixed easily),
+            // user ends the longpress, DDE Dock recevies mouseReleaseEvent and checks for
+            // QTapAndHoldGesture  which is still not happening (maybe because the timer used is
+            // a CoarseTimer?), so Dock treats the event as a normal mouseReleaseEvent, launches the
+            // App or triggers the action.
+            //
+            // see: https://github.com/linuxdeepin/internal-discussion/issues/430
+            //
+            // This workaround hopefully can fix most of this situations.
+            QTapAndHoldGesture::setTimeout(settings.longpressDuration - 100);
+
+        DStartupTimeline::instance()->addPhase("gsettings", settings.startNsecs, settings.durationNsecs, true);
+    });
+    settingsWatcher->setFuture(QtConcurrent::run(readApplicationSettings));
+#endif
+
+    dtkTranslatorFuture = QtConcurrent::run(prefetchDtkTranslator, dtkTranslateDirs(), QLocale::system(), q->thread());
+    dtkTranslatorPrefetching = true;
 }
 
 // 自动激活DMainWindow类型的窗口
@@ -271,23 +414,75 @@ void DApplicationPrivate::_q_onNewInstanceStarted()
     }
 }
 
+// 输入法的通知合并到一帧内处理
+static const int VirtualKeyboardAdjustInterval = 16;
+
+// 与 Qt 判断焦点对象是否接受输入法的方式一致
+static bool acceptsInputMethod(QWidget *widget)
+{
+    QInputMethodQueryEvent query(Qt::ImEnabled);
+    QCoreApplication::sendEvent(widget, &query);
+    return query.value(Qt::ImEnabled).toBool();
+}
+
+QPlatformInputContext *DApplicationPrivate::platformInputContext() const
+{
+    if (inputContextOverride)
+        return inputContextOverride;
+
+    return QGuiApplicationPrivate::platformIntegration()->inputContext();
+}
+
+void DApplicationPrivate::restoreActiveInputWindow()
+{
+    if (!activeInputWindow)
+        return;
+
+    if (activeInputWindow->contentsMargins() != activeInputWindowContentsMargins)
+        activeInputWindow->setContentsMargins(activeInputWindowContentsMargins);
+
+    // 平移模式下只移动了布局区域，恢复到原来的位置
+    QLayout *layout = activeInputWindow->layout();
+    if (virtualKeyboardPanOnly && layout && layout->geometry() != activeInputWindow->contentsRect())
+        layout->setGeometry(activeInputWindow->contentsRect());
+
+    virtualKeyboardPan = 0;
+    activeInputWindow = nullptr;
+}
+
+/*
+ * 布局被激活时(如子控件显示隐藏引起的 LayoutRequest、窗口 Resize)会把布局区域重置为 contentsRect，
+ * 虚拟键盘仍然显示时在事件处理后重新平移，窗口尺寸变化时还需要重新计算平移的距离.
+ */
+void DApplicationPrivate::reapplyVirtualKeyboardPan(QEvent *event)
+{
+    if (event->type() != QEvent::LayoutRequest && event->type() != QEvent::Resize)
+        return;
+
+    QLayout *layout = activeInputWindow->layout();
+    const QRect &panned = activeInputWindow->contentsRect().translated(0, -virtualKeyboardPan);
+    if (layout && layout->geometry() != panned)
+        layout->setGeometry(panned);
+
+    if (event->type() == QEvent::Resize)
+        scheduleVirtualKeyboardAdjustment();
+}
+
 void DApplicationPrivate::doAcclimatizeVirtualKeyboard(QWidget *window, QWidget *widget, bool allowResizeContentsMargins)
 {
     // 如果新激活的输入窗口跟已经在处理中的窗口不一致，则恢复旧窗口的状态
     if (activeInputWindow && activeInputWindow != window) {
-        activeInputWindow->setContentsMargins(activeInputWindowContentsMargins);
-        activeInputWindow = nullptr;
+        restoreActiveInputWindow();
     }
 
-    auto platform_context = QGuiApplicationPrivate::platformIntegration()->inputContext();
+    auto platform_context = platformInputContext();
     auto input_method = QGuiApplication::inputMethod();
     // 先检查输入面板的状态
-    if (!platform_context->inputMethodAccepted() || !input_method->isVisible()) {
-        if (activeInputWindow) {
-            activeInputWindow->setContentsMargins(activeInputWindowContentsMargins);
-            activeInputWindow = nullptr;
-        }
-        widget->setProperty("_dtk_selectHandleMargins", 0);
+    if (!platform_context || !platform_context->isInputPanelVisible()
+            || !acceptsInputMethod(widget)) {
+        restoreActiveInputWindow();
+        if (widget->property("_dtk_selectHandleMargins").toInt() != 0)
+            widget->setProperty("_dtk_selectHandleMargins", 0);
         return;
     }
 
@@ -296,7 +491,7 @@ void DApplicationPrivate::doAcclimatizeVirtualKeyboard(QWidget *window, QWidget
         return;
 
     // 虚拟键盘相对于当前窗口的geometry
-    const QRectF &kRect = input_method->keyboardRectangle().translated(-window->mapToGlobal(QPoint(0, 0)));
+    const QRectF &kRect = platform_context->keyboardRect().translated(-window->mapToGlobal(QPoint(0, 0)));
     if (kRect.isEmpty() || !kRect.isValid())
         return;
 
@@ -351,16 +546,36 @@ void DApplicationPrivate::doAcclimatizeVirtualKeyboard(QWidget *window, QWidget
 
     QRectF cursor = input_method->anchorRectangle();
     QPointF cursorPoint = cursor.topLeft();
+    QLayout *layout = window->layout();
+    const bool panOnly = virtualKeyboardPanOnly && resizeHeight == 0 && layout;
 
     if (cursorPoint.y() < kRect.y()) {
-        if (window->contentsMargins() != QMargins())
+        virtualKeyboardPan = 0;
+        if (panOnly) {
+            if (layout->geometry() != window->contentsRect())
+                layout->setGeometry(window->contentsRect());
+        } else if (window->contentsMargins() != QMargins()) {
             window->setContentsMargins(QMargins());
+        }
         return;
     }
 
     // 更新窗口内容显示区域以确保虚拟键盘能正常显示
-    window->setContentsMargins(0, -panValue, 0, resizeHeight + panValue);
-    widget->setProperty("_dtk_selectHandleMargins", panValue);
+    if (panOnly) {
+        // 布局区域的尺寸不变，只移动子控件的位置，不需要重新计算布局
+        const QRect &panned = window->contentsRect().translated(0, -panValue);
+        virtualKeyboardPan = panValue;
+        if (layout->geometry() != panned)
+            layout->setGeometry(panned);
+    } else {
+        virtualKeyboardPan = 0;
+        const QMargins margins(0, -panValue, 0, resizeHeight + panValue);
+        if (window->contentsMargins() != margins)
+            window->setContentsMargins(margins);
+    }
+
+    if (widget->property("_dtk_selectHandleMargins").toInt() != panValue)
+        widget->setProperty("_dtk_selectHandleMargins", panValue);
 }
 
 void DApplicationPrivate::acclimatizeVirtualKeyboardForFocusWidget(bool allowResizeContentsMargins)
@@ -376,32 +591,155 @@ void DApplicationPrivate::acclimatizeVirtualKeyboardForFocusWidget(bool allowRes
     }
 }
 
+void DApplicationPrivate::scheduleVirtualKeyboardAdjustment()
+{
+    if (!virtualKeyboardTimer) {
+        D_Q(DApplication);
+
+        virtualKeyboardTimer = new QTimer(q);
+        virtualKeyboardTimer->setSingleShot(true);
+        virtualKeyboardTimer->setInterval(VirtualKeyboardAdjustInterval);
+        QObject::connect(virtualKeyboardTimer, &QTimer::timeout, q, [this] {
+            // TODO(zccrs): 暂时不支持压缩窗口高度适应虚拟键盘的模式
+            // 需要做到ScrollArea中的输入控件能在改变窗口高度之后还处于可见状态
+            acclimatizeVirtualKeyboardForFocusWidget(false);
+        });
+    }
+
+    // 输入时光标区域每次按键都会变化，已有待处理的调整时不再重新计时
+    if (!virtualKeyboardTimer->isActive())
+        virtualKeyboardTimer->start();
+}
+
 void DApplicationPrivate::_q_panWindowContentsForVirtualKeyboard()
 {
-    acclimatizeVirtualKeyboardForFocusWidget(false);
+    scheduleVirtualKeyboardAdjustment();
 }
 
 void DApplicationPrivate::_q_resizeWindowContentsForVirtualKeyboard()
 {
-    // TODO(zccrs): 暂时不支持压缩窗口高度适应虚拟键盘的模式
-    // 需要做到ScrollArea中的输入控件能在改变窗口高度之后还处于可见状态
-    acclimatizeVirtualKeyboardForFocusWidget(false);
+    scheduleVirtualKeyboardAdjustment();
 }
 
+// 尺寸模式切换时每批次处理的时长，避免控件过多时长时间阻塞事件循环
+static const int SizeModeTimeSlice = 8;
+
 void DApplicationPrivate::_q_sizeModeChanged()
 {
-    QEvent ev(QEvent::StyleChange);
-    for (auto item : qApp->topLevelWidgets()) {
-        handleSizeModeChangeEvent(item, &ev);
+    D_Q(DApplication);
+
+    // 重新开始，未处理完的上一次切换直接作废
+    pendingSizeModeWidgets.clear();
+    pendingSizeModeIndex = 0;
+    staleSizeModeWidgets.clear();
+
+    // 优先更新激活窗口
+    QWidgetList windows = qApp->topLevelWidgets();
+    if (QWidget *activeWindow = qApp->activeWindow()) {
+        if (windows.removeOne(activeWindow))
+            windows.prepend(activeWindow);
     }
+    for (auto item : windows) {
+        collectSizeModeWidgets(item, pendingSizeModeWidgets);
+    }
+
+    if (!sizeModeTimer) {
+        sizeModeTimer = new QTimer(q);
+        sizeModeTimer->setSingleShot(true);
+        sizeModeTimer->setInterval(0);
+        QObject::connect(sizeModeTimer, &QTimer::timeout, q, [this] {
+            processSizeModeWidgets();
+        });
+    }
+
+    sizeModeUpdating = true;
+    processSizeModeWidgets();
 }
 
-void DApplicationPrivate::handleSizeModeChangeEvent(QWidget *widget, QEvent *event)
+void DApplicationPrivate::collectSizeModeWidgets(QWidget *widget, QList<QPointer<QWidget>> &widgets)
 {
+    // 隐藏的控件(包括其子控件)标记为待更新，在收到 Show 事件时再处理
+    if (!widget->isVisible()) {
+        staleSizeModeWidgets.insert(widget, widget);
+        return;
+    }
+
     // 深度优先遍历，事件接受顺序：子 -> 父， 若parentWidget先处理event，可能存在布局没更新问题
-    for (auto w : widget->findChildren<QWidget *>(QString(), Qt::FindDirectChildrenOnly)) {
-        handleSizeModeChangeEvent(w, event);
+    for (auto child : widget->children()) {
+        if (child->isWidgetType())
+            collectSizeModeWidgets(static_cast<QWidget *>(child), widgets);
+    }
+    widgets.append(widget);
+}
+
+void DApplicationPrivate::processSizeModeWidgets()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QEvent ev(QEvent::StyleChange);
+    while (pendingSizeModeIndex < pendingSizeModeWidgets.size()) {
+        QWidget *widget = pendingSizeModeWidgets.at(pendingSizeModeIndex++);
+        if (widget)
+            handleSizeModeChangeEvent(widget, &ev);
+
+        // 剩余的控件在下一次事件循环中继续处理
+        if (timer.elapsed() >= SizeModeTimeSlice && pendingSizeModeIndex < pendingSizeModeWidgets.size()) {
+            sizeModeTimer->start();
+            return;
+        }
+    }
+
+    finishSizeModeChange();
+}
+
+void DApplicationPrivate::finishSizeModeChange()
+{
+    pendingSizeModeWidgets.clear();
+    pendingSizeModeIndex = 0;
+    sizeModeUpdating = false;
+
+    // 更新过程中合并的布局请求，每个控件只请求一次
+    const auto requests = deferredLayoutRequests;
+    deferredLayoutRequests.clear();
+    for (const QPointer<QWidget> &widget : requests) {
+        if (widget)
+            QCoreApplication::postEvent(widget, new QEvent(QEvent::LayoutRequest));
     }
+}
+
+bool DApplicationPrivate::deferLayoutRequest(QObject *obj)
+{
+    if (!sizeModeUpdating || !obj->isWidgetType())
+        return false;
+
+    QWidget *widget = static_cast<QWidget *>(obj);
+    deferredLayoutRequests.insert(widget, widget);
+    return true;
+}
+
+void DApplicationPrivate::restyleStaleWidget(QObject *obj)
+{
+    if (!obj->isWidgetType())
+        return;
+
+    // 记录的控件已被销毁时，相同地址上的是新控件，不需要更新
+    if (!staleSizeModeWidgets.take(static_cast<QWidget *>(obj)))
+        return;
+
+    // 在控件显示前更新其尺寸模式，其中仍隐藏的子控件继续延迟处理
+    QList<QPointer<QWidget>> widgets;
+    collectSizeModeWidgets(static_cast<QWidget *>(obj), widgets);
+
+    QEvent ev(QEvent::StyleChange);
+    for (const QPointer<QWidget> &widget : widgets) {
+        if (widget)
+            handleSizeModeChangeEvent(widget, &ev);
+    }
+}
+
+void DApplicationPrivate::handleSizeModeChangeEvent(QWidget *widget, QEvent *event)
+{
     if (widget->isWindow()) {
         // TODO 顶层窗口需要延迟，否则内部控件布局出现异常，例如DDialog, 若send事件，导致
         // 从compact -> normal -> campact时，DDialog内部控件布局的两次campact大小不一致.
@@ -431,6 +769,8 @@ bool DApplicationPrivate::isUserManualExists()
   - 自动根据 applicationName 和 系统 locale 加载对应的翻译文件；
   - 会根据系统gsettings中 com.deepin.dde.dapplication 的 qpixmapCacheLimit 值来设置 QPixmapCache::cacheLimit ；
   - 会根据系统gsettings中 com.deepin.dde.touchscreen longpress-duration 的值来设置 QTapAndHoldGesture::timeout ；
+    gsettings 在后台线程读取，读取完成后再应用，不阻塞程序启动；
+  - 启动过程中各阶段的耗时记录在 DStartupTimeline 中；
   - 方便地通过 setSingleInstance 来实现程序的单实例。
   
   \note DApplication 设置的 QTapAndHoldGesture::timeout 会比 gsettings
@@ -573,40 +913,16 @@ DApplication::DApplication(int &argc, char **argv) :
         setAttribute(Qt::AA_ForceRasterWidgets);
     }
 
-#ifdef Q_OS_LINUX
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-    // set qpixmap cache limit
-    if (QGSettings::isSchemaInstalled("com.deepin.dde.dapplication"))
-    {
-        QGSettings gsettings("com.deepin.dde.dapplication", "/com/deepin/dde/dapplication/");
-        if (gsettings.keys().contains("qpixmapCacheLimit"))
-            QPixmapCache::setCacheLimit(gsettings.get("qpixmap-cache-limit").toInt());
-    }
-
-    // set QTapAndHoldGesture::timeout
-    if (QGSettings::isSchemaInstalled("com.deepin.dde.touchscreen")) {
-        QGSettings gsettings("com.deepin.dde.touchscreen");
-        if (gsettings.keys().contains("longpressDuration"))
-            // NOTE(hualet): -100 is a workaround against the situation that that sometimes longpress
-            // and release on Dock cause App launches which should be avoided.
-            //
-            // I guess it happens like this: longpress happens on Dock,
-            // Dock menu shows(doesn't grab the mouse which is a bug can't be fixed easily),
-            // user ends the longpress, DDE Dock recevies mouseReleaseEvent and checks for
-            // QTapAndHoldGesture  which is still not happening (maybe because the timer used is
-            // a CoarseTimer?), so Dock treats the event as a normal mouseReleaseEvent, launches the
-            // App or triggers the action.
-            //
-            // see: https://github.com/linuxdeepin/internal-discussion/issues/430
-            //
-            // This workaround hopefully can fix most of this situations.
-            QTapAndHoldGesture::setTimeout(gsettings.get("longpress-duration").toInt() - 100);
-    }
-#endif
-#endif
+    // gsettings 和翻译等不影响显示窗口的工作在后台执行
+    D_D(DApplication);
+    d->startDeferredStartupWork();
 
     connect(DGuiApplicationHelper::instance(), SIGNAL(sizeModeChanged(DGuiApplicationHelper::SizeMode)),
             this, SLOT(_q_sizeModeChanged()));
+
+    DWidgetProfilerPrivate::initFromEnvironment();
+
+    DStartupTimeline::instance()->addPhase("DApplication", 0, DStartupTimelinePrivate::processElapsed());
 }
 
 DApplication::~DApplication() {
@@ -710,7 +1026,7 @@ bool DApplication::setSingleInstance(const QString &key)
  */
 bool DApplication::setSingleInstance(const QString &key, SingleScope singleScope)
 {
-    D_D(DApplication);
+    DStartupPhaseScope phase("setSingleInstance");
 
     auto scope = singleScope == SystemScope ? DGuiApplicationHelper::WorldScope : DGuiApplicationHelper::UserScope;
     connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::newProcessInstance,
@@ -756,6 +1072,7 @@ bool DApplication::setSingleInstance(const QString &key, SingleScope singleScope
 bool DApplication::loadTranslator(QList<QLocale> localeFallback)
 {
     D_D(DApplication);
+    DStartupPhaseScope phase("loadTranslator");
 
     bool loadDtkTranslator =  d->loadDtkTranslator(localeFallback);
     // qt && qtbase && appName
@@ -1222,6 +1539,33 @@ void DApplication::setAutoActivateWindows(bool autoActivateWindows)
     }
 }
 
+/*!
+  \brief 虚拟键盘遮挡输入控件时是否只平移窗口内容.
+
+  开启后，如果不需要压缩窗口的布局空间，将直接移动窗口顶层布局的区域，
+  而不再通过 QWidget::setContentsMargins 使整个窗口重新布局，窗口没有
+  顶层布局时仍使用 contentsMargins。默认地，该属性为 false.
+  \sa DApplication::acclimatizeVirtualKeyboard
+ */
+bool DApplication::virtualKeyboardPanOnly() const
+{
+    D_DC(DApplication);
+
+    return d->virtualKeyboardPanOnly;
+}
+
+void DApplication::setVirtualKeyboardPanOnly(bool panOnly)
+{
+    D_D(DApplication);
+
+    if (d->virtualKeyboardPanOnly == panOnly)
+        return;
+
+    // 切换前恢复正在处理的窗口，下次调整时使用新的方式
+    d->restoreActiveInputWindow();
+    d->virtualKeyboardPanOnly = panOnly;
+}
+
 /*!
   \brief 用于窗口中可输入控件自适应虚拟键盘.
   
@@ -1519,6 +1863,15 @@ static inline bool basePrintPropertiesDialog(const QWidget *w)
     return false;
 }
 
+bool DApplication::event(QEvent *event)
+{
+    // 该事件只发送给 qApp，通过 qApp->setProperty 修改的风格属性在这里刷新 DStyle 的缓存
+    if (event->type() == QEvent::DynamicPropertyChange)
+        dstylePreferencePropertyChanged(static_cast<QDynamicPropertyChangeEvent *>(event)->propertyName());
+
+    return QApplication::event(event);
+}
+
 bool DApplication::notify(QObject *obj, QEvent *event)
 {
     if (event->type() == QEvent::FocusIn) {
@@ -1536,12 +1889,44 @@ bool DApplication::notify(QObject *obj, QEvent *event)
         }
     }
 
+    switch (event->type()) {
+    case QEvent::LayoutRequest:
+        // 尺寸模式分批更新期间合并布局请求，全部更新后再统一布局
+        if (d_func()->deferLayoutRequest(obj))
+            return true;
+        break;
+    case QEvent::Show:
+        if (!d_func()->staleSizeModeWidgets.isEmpty())
+            d_func()->restyleStaleWidget(obj);
+        break;
+    case QEvent::PaletteChange:
+    case QEvent::ParentChange:
+    case QEvent::ApplicationPaletteChange:
+        // DPaletteHelper 的缓存在这里统一失效，不需要为每个控件安装事件过滤器
+        DPaletteHelperPrivate::notify(obj, event);
+        break;
+    default:
+        break;
+    }
+
     if (event->type() == QEvent::ApplicationFontChange) {
         // ApplicationFontChange 调用 font() 是 ok 的，如果在 fontChanged 中调用在某些版本中会出现 deadlock
         DFontSizeManager::instance()->setFontGenericPixelSize(static_cast<quint16>(DFontSizeManager::fontPixelSize(font())));
     }
 
-    return QApplication::notify(obj, event);
+    bool result;
+    if (Q_UNLIKELY(DWidgetProfilerPrivate::isActive())) {
+        DWidgetProfilerScope scope(obj, event);
+        result = QApplication::notify(obj, event);
+    } else {
+        result = QApplication::notify(obj, event);
+    }
+
+    // 布局在事件分发中被激活，需要在分发之后再恢复虚拟键盘的平移
+    if (Q_UNLIKELY(d_func()->virtualKeyboardPan != 0) && obj == d_func()->activeInputWindow.data())
+        d_func()->reapplyVirtualKeyboardPan(event);
+
+    return result;
 }
 
 int DtkBuildVersion::value = 0;
@@ -5,6 +5,7 @@
 #include "dblureffectwidget.h"
 #include "private/dblureffectwidget_p.h"
 #include "dplatformwindowhandle.h"
+#include "dcacheregistry.h"
 
 #include <DWindowManagerHelper>
 #include <DGuiApplicationHelper>
@@ -12,6 +13,8 @@
 #include <QPainter>
 #include <QBackingStore>
 #include <QPaintEvent>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 #include <QDebug>
 
 #include <qpa/qplatformbackingstore.h>
@@ -1137,6 +1140,20 @@ bool DBlurEffectWidget::eventFilter(QObject *watched, QEvent *event)
     return QWidget::eventFilter(watched, event);
 }
 
+static QImage blurSourceImage(QImage image, int blurRadius)
+{
+    if (blurRadius <= 0)
+        return image;
+
+    QImage tmp(image.size(), image.format());
+    QPainter pa(&tmp);
+    qt_blurImage(&pa, image, blurRadius, false, false);
+    pa.end();
+    tmp.setDevicePixelRatio(image.devicePixelRatio());
+
+    return tmp;
+}
+
 class DBlurEffectGroupPrivate : public DTK_CORE_NAMESPACE::DObjectPrivate
 {
 public:
@@ -1146,9 +1163,51 @@ public:
 
     }
 
+    ~DBlurEffectGroupPrivate() override
+    {
+        // 丢弃尚未完成的模糊结果，工作线程只持有自己的图片副本
+        delete blurWatcher;
+    }
+
+    void updateCacheCost()
+    {
+        // 模糊后的图片无法重新生成，只计入总占用而不参与淘汰
+        const qint64 cost = qint64(blurPixmap.width()) * blurPixmap.height() * blurPixmap.depth() / 8;
+        if (!cacheId) {
+            if (cost <= 0)
+                return;
+            cacheId = DCacheRegistry::instance()->registerEntry(QStringLiteral("DBlurEffectGroup"));
+        }
+
+        DCacheRegistry::instance()->updateCost(cacheId, cost);
+    }
+
+    void setBlurImage(const QImage &image)
+    {
+        const QRect oldRect = blurPixmap.rect();
+        blurPixmap = image.isNull() ? QPixmap() : QPixmap::fromImage(image);
+        if (!blurPixmap.isNull())
+            blurPixmap.setDevicePixelRatio(image.devicePixelRatio());
+        updateCacheCost();
+
+        // 只重绘各个模糊控件从图片中取样的区域
+        const QRect changedRect = oldRect | blurPixmap.rect();
+        for (auto begin = effectWidgetMap.constBegin(); begin != effectWidgetMap.constEnd(); ++begin) {
+            const QRect sourceRect = begin.key()->geometry().translated(begin.value());
+            const QRect dirtyRect = sourceRect & changedRect;
+            if (!dirtyRect.isEmpty())
+                begin.key()->update(dirtyRect.translated(-sourceRect.topLeft()));
+        }
+    }
+
     D_DECLARE_PUBLIC(DBlurEffectGroup)
     QHash<DBlurEffectWidget*, QPoint> effectWidgetMap;
     QPixmap blurPixmap;
+    quint64 cacheId = 0;
+    // 每次设置图片时递增，用于丢弃过期的异步模糊结果
+    quint64 sourceGeneration = 0;
+    quint64 asyncGeneration = 0;
+    QFutureWatcher<QImage> *blurWatcher = nullptr;
 };
 
 DBlurEffectGroup::DBlurEffectGroup()
@@ -1165,34 +1224,48 @@ DBlurEffectGroup::~DBlurEffectGroup()
         widget->d_func()->group = nullptr;
         widget->update();
     }
+
+    if (d->cacheId)
+        DCacheRegistry::instance()->unregisterEntry(d->cacheId);
 }
 
 void DBlurEffectGroup::setSourceImage(QImage image, int blurRadius)
 {
     D_D(DBlurEffectGroup);
 
+    ++d->sourceGeneration;
+    d->setBlurImage(image.isNull() ? image : blurSourceImage(image, blurRadius));
+}
+
+/*!
+  \brief DBlurEffectGroup::setSourceImageAsync 在工作线程中模糊图片，完成前继续显示之前的模糊结果.
+
+  完成后只重绘各个模糊控件取样的区域，连续调用时只使用最后一次的结果，
+  之后调用的 setSourceImage 会使尚未完成的结果失效.
+
+  \a image 模糊的源图片
+  \a blurRadius 模糊半径
+ */
+void DBlurEffectGroup::setSourceImageAsync(QImage image, int blurRadius)
+{
+    D_D(DBlurEffectGroup);
+
+    const quint64 generation = ++d->sourceGeneration;
     if (image.isNull()) {
-        d->blurPixmap = QPixmap();
+        d->setBlurImage(image);
         return;
     }
 
-
-    if (blurRadius > 0) {
-        QImage tmp(image.size(), image.format());
-        QPainter pa(&tmp);
-        qt_blurImage(&pa, image, blurRadius, false, false);
-        pa.end();
-        d->blurPixmap = QPixmap::fromImage(tmp);
-    } else {
-        d->blurPixmap = QPixmap::fromImage(image);
+    if (!d->blurWatcher) {
+        d->blurWatcher = new QFutureWatcher<QImage>();
+        QObject::connect(d->blurWatcher, &QFutureWatcher<QImage>::finished, d->blurWatcher, [d] {
+            if (d->asyncGeneration == d->sourceGeneration)
+                d->setBlurImage(d->blurWatcher->result());
+        });
     }
 
-    d->blurPixmap.setDevicePixelRatio(image.devicePixelRatio());
-
-    // 重绘制模糊控件
-    for (auto begin = d->effectWidgetMap.constBegin(); begin != d->effectWidgetMap.constEnd(); ++begin) {
-        begin.key()->update();
-    }
+    d->asyncGeneration = generation;
+    d->blurWatcher->setFuture(QtConcurrent::run(QThreadPool::globalInstance(), blurSourceImage, image, blurRadius));
 }
 
 void DBlurEffectGroup::addWidget(DBlurEffectWidget *widget, const QPoint &offset)
@@ -1223,6 +1296,9 @@ void DBlurEffectGroup::paint(QPainter *pa, DBlurEffectWidget *widget) const
     D_DC(DBlurEffectGroup);
 
     pa->drawPixmap(widget->rect(), d->blurPixmap, widget->geometry().translated(d->effectWidgetMap[widget]));
+
+    if (d->cacheId)
+        DCacheRegistry::instance()->touch(d->cacheId);
 }
 
 DWIDGET_END_NAMESPACE
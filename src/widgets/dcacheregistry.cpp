@@ -0,0 +1,291 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dcacheregistry.h"
+#include "private/dcacheregistry_p.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QPixmapCache>
+#include <QSocketNotifier>
+#include <QTimer>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <vector>
+
+DWIDGET_BEGIN_NAMESPACE
+
+static const char *PressureFile = "/proc/pressure/memory";
+// 两秒内内存阻塞总时长超过 150ms 时通知，非特权进程的统计窗口必须是两秒的整数倍
+static const char PressureTrigger[] = "some 150000 2000000";
+// 不支持触发器时定时读取最近 10 秒的阻塞比例
+static const int PressurePollInterval = 10000;
+static const double PressureAvg10Limit = 10.0;
+// 连续的内存压力通知之间至少间隔的时长
+static const int PressureMinInterval = 2000;
+
+static DCacheRegistry *g_instance = nullptr;
+
+DCacheRegistryPrivate::DCacheRegistryPrivate(DCacheRegistry *qq)
+    : DObjectPrivate(qq)
+    , budget(defaultBudget())
+{
+}
+
+DCacheRegistryPrivate::~DCacheRegistryPrivate()
+{
+    if (pressureFd >= 0)
+        ::close(pressureFd);
+}
+
+qint64 DCacheRegistryPrivate::defaultBudget()
+{
+    // D_DTK_CACHE_BUDGET 以 MiB 为单位指定总预算，否则取物理内存的 1/32，限制在 32MiB~256MiB 之间
+    bool ok = false;
+    const qint64 env = qEnvironmentVariableIntValue("D_DTK_CACHE_BUDGET", &ok);
+    if (ok && env > 0)
+        return env * 1024 * 1024;
+
+    const qint64 pages = sysconf(_SC_PHYS_PAGES);
+    const qint64 pageSize = sysconf(_SC_PAGESIZE);
+    const qint64 memory = pages > 0 && pageSize > 0 ? pages * pageSize : 0;
+
+    return qBound<qint64>(32ll * 1024 * 1024, memory / 32, 256ll * 1024 * 1024);
+}
+
+qint64 DCacheRegistryPrivate::evictUntil(qint64 targetCost, quint64 keepId)
+{
+    if (evicting || totalCost <= targetCost)
+        return 0;
+
+    evicting = true;
+    qint64 freed = 0;
+    // 淘汰回调中可能注销其他条目，先取出候选列表再逐个查找
+    const std::vector<quint64> candidates(lru.begin(), lru.end());
+    for (quint64 id : candidates) {
+        if (totalCost <= targetCost)
+            break;
+
+        auto it = entries.find(id);
+        if (it == entries.end() || id == keepId || it->cost <= 0 || !it->evictor)
+            continue;
+
+        const qint64 cost = it->cost;
+        const DCacheRegistry::Evictor evictor = it->evictor;
+        CacheCounters &counter = counters[it->cacheName];
+        ++counter.evictions;
+        counter.evictedCost += cost;
+        it->cost = 0;
+        totalCost -= cost;
+        freed += cost;
+
+        evictor();
+    }
+    evicting = false;
+
+    return freed;
+}
+
+void DCacheRegistryPrivate::startPressureMonitor()
+{
+    if (pressureMonitorStarted)
+        return;
+
+    pressureMonitorStarted = true;
+    D_Q(DCacheRegistry);
+
+    const int fd = ::open(PressureFile, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd >= 0) {
+        // 触发器内容需要包含结尾的 '\0'
+        if (::write(fd, PressureTrigger, sizeof(PressureTrigger)) > 0) {
+            pressureFd = fd;
+            pressureNotifier = new QSocketNotifier(fd, QSocketNotifier::Exception, q);
+            QObject::connect(pressureNotifier, &QSocketNotifier::activated, q, &DCacheRegistry::notifyMemoryPressure);
+            return;
+        }
+        ::close(fd);
+    }
+
+    if (!QFile::exists(PressureFile))
+        return;
+
+    pressureTimer = new QTimer(q);
+    pressureTimer->setInterval(PressurePollInterval);
+    QObject::connect(pressureTimer, &QTimer::timeout, q, [this] {
+        readPressure();
+    });
+    pressureTimer->start();
+}
+
+void DCacheRegistryPrivate::readPressure()
+{
+    D_Q(DCacheRegistry);
+
+    QFile file(PressureFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    // 格式为 "some avg10=0.00 avg60=0.00 avg300=0.00 total=0"
+    const QByteArray line = file.readLine();
+    const int begin = line.indexOf("avg10=");
+    if (!line.startsWith("some") || begin < 0)
+        return;
+
+    const int end = line.indexOf(' ', begin);
+    const double avg10 = line.mid(begin + 6, end - begin - 6).toDouble();
+    if (avg10 >= PressureAvg10Limit)
+        q->notifyMemoryPressure();
+}
+
+DCacheRegistry::DCacheRegistry(QObject *parent)
+    : QObject(parent)
+    , DObject(*new DCacheRegistryPrivate(this))
+{
+}
+
+DCacheRegistry::~DCacheRegistry()
+{
+    if (g_instance == this)
+        g_instance = nullptr;
+}
+
+DCacheRegistry *DCacheRegistry::instance()
+{
+    if (!g_instance)
+        g_instance = new DCacheRegistry(qApp);
+
+    return g_instance;
+}
+
+quint64 DCacheRegistry::registerEntry(const QString &cacheName, qint64 cost, Evictor evictor)
+{
+    D_D(DCacheRegistry);
+
+    d->startPressureMonitor();
+
+    const quint64 id = d->nextId++;
+    DCacheRegistryPrivate::Entry &entry = d->entries[id];
+    entry.cacheName = cacheName;
+    entry.evictor = std::move(evictor);
+    entry.lruPosition = d->lru.insert(d->lru.end(), id);
+
+    if (cost > 0)
+        updateCost(id, cost);
+
+    return id;
+}
+
+void DCacheRegistry::unregisterEntry(quint64 id)
+{
+    D_D(DCacheRegistry);
+
+    auto it = d->entries.find(id);
+    if (it == d->entries.end())
+        return;
+
+    d->totalCost -= it->cost;
+    d->lru.erase(it->lruPosition);
+    d->entries.erase(it);
+}
+
+void DCacheRegistry::updateCost(quint64 id, qint64 cost)
+{
+    D_D(DCacheRegistry);
+
+    auto it = d->entries.find(id);
+    if (it == d->entries.end())
+        return;
+
+    cost = qMax<qint64>(0, cost);
+    d->totalCost += cost - it->cost;
+    it->cost = cost;
+    touch(id);
+
+    // 超出预算时淘汰最久未使用的其他条目
+    if (d->totalCost > d->budget)
+        d->evictUntil(d->budget, id);
+}
+
+void DCacheRegistry::touch(quint64 id)
+{
+    D_D(DCacheRegistry);
+
+    auto it = d->entries.find(id);
+    if (it == d->entries.end())
+        return;
+
+    ++d->counters[it->cacheName].accesses;
+    d->lru.splice(d->lru.end(), d->lru, it->lruPosition);
+}
+
+qint64 DCacheRegistry::budget() const
+{
+    D_DC(DCacheRegistry);
+
+    return d->budget;
+}
+
+void DCacheRegistry::setBudget(qint64 bytes)
+{
+    D_D(DCacheRegistry);
+
+    d->budget = qMax<qint64>(0, bytes);
+    d->evictUntil(d->budget);
+}
+
+qint64 DCacheRegistry::totalCost() const
+{
+    D_DC(DCacheRegistry);
+
+    return d->totalCost;
+}
+
+QList<DCacheRegistry::Statistics> DCacheRegistry::statistics() const
+{
+    D_DC(DCacheRegistry);
+
+    QHash<QString, Statistics> result;
+    for (auto it = d->counters.constBegin(); it != d->counters.constEnd(); ++it) {
+        Statistics &stats = result[it.key()];
+        stats.cacheName = it.key();
+        stats.accesses = it->accesses;
+        stats.evictions = it->evictions;
+        stats.evictedCost = it->evictedCost;
+    }
+
+    for (const DCacheRegistryPrivate::Entry &entry : d->entries) {
+        Statistics &stats = result[entry.cacheName];
+        stats.cacheName = entry.cacheName;
+        ++stats.entries;
+        stats.cost += entry.cost;
+    }
+
+    return result.values();
+}
+
+qint64 DCacheRegistry::trim(qint64 targetCost)
+{
+    D_D(DCacheRegistry);
+
+    return d->evictUntil(qMax<qint64>(0, targetCost));
+}
+
+void DCacheRegistry::notifyMemoryPressure()
+{
+    D_D(DCacheRegistry);
+
+    if (d->lastPressure.isValid() && d->lastPressure.elapsed() < PressureMinInterval)
+        return;
+    d->lastPressure.start();
+
+    // 释放一半的预算，同时清空 QPixmapCache 中的阴影等缓存
+    d->evictUntil(qMin(d->totalCost, d->budget) / 2);
+    QPixmapCache::clear();
+
+    Q_EMIT memoryPressure();
+}
+
+DWIDGET_END_NAMESPACE
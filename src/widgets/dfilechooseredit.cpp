@@ -12,8 +12,45 @@
 #include <QGuiApplication>
 #include <private/qguiapplication_p.h>
 #include <QWindow>
+#include <QCache>
+#include <QCompleter>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QStringListModel>
+#include <QThreadPool>
+#include <QTimer>
+#include <QtConcurrent>
 DWIDGET_BEGIN_NAMESPACE
 
+// 输入停顿多久后开始检查路径
+static const int PathCheckDelay = 150;
+// 单个目录最多列出的条目数
+static const int DefaultMaxCompletionCount = 1000;
+// 缓存最近列出的目录个数及其有效时长
+static const int ListingCacheSize = 16;
+static const int ListingCacheLifetime = 5000;
+
+struct DFileChooserListing
+{
+    QStringList entries;
+    QElapsedTimer age;
+};
+typedef QCache<QString, DFileChooserListing> DFileChooserListingCache;
+
+// 网络或移动存储上的目录可能长时间阻塞，使用独立的线程池以免占满全局线程池
+class DFileChooserThreadPool : public QThreadPool
+{
+public:
+    DFileChooserThreadPool()
+    {
+        setMaxThreadCount(2);
+    }
+};
+
+Q_GLOBAL_STATIC(DFileChooserThreadPool, _d_fileChooserThreadPool)
+Q_GLOBAL_STATIC_WITH_ARGS(DFileChooserListingCache, _d_fileChooserListings, (ListingCacheSize))
+
 /*!
 @~english
   @class Dtk::Widget::DFileChooserEdit
@@ -22,6 +59,7 @@ DWIDGET_BEGIN_NAMESPACE
   
   This control is basically the same as DLineEdit, but at the same time provides a button on the right side of the edit box, click the button will appear a select file dialog box, when the selection is completed in the dialog box click OK, the selection result will appear in the text edit box.
   There are also ways to customize the functionality of the control by setting where the dialog box appears, selecting the type of file, or setting a filename filter.
+  Typed absolute paths are completed from directory listings made on a worker thread, and can optionally be validated against the file mode.
   
   @sa DLineEdit QFileDialog
  */
@@ -230,12 +268,89 @@ QUrl DFileChooserEdit::directoryUrl()
     return d->dialog->directoryUrl();
 }
 
+/*!
+@~english
+  @brief Enable or disable completion of typed paths
+  \a enabled Whether to complete paths
+
+  Directory listings are made on a worker thread, so slow or network mounts never block the interface.
+  Completion is enabled by default.
+  @sa DFileChooserEdit::completionEnabled
+ */
+void DFileChooserEdit::setCompletionEnabled(bool enabled)
+{
+    D_D(DFileChooserEdit);
+
+    if (d->completionEnabled == enabled)
+        return;
+
+    d->completionEnabled = enabled;
+    lineEdit()->setCompleter(enabled ? d->completer : nullptr);
+    if (!enabled) {
+        d->listedDirectory.clear();
+        d->completionModel->setStringList(QStringList());
+    }
+    d->checkTimer->start();
+}
+
+/*!
+@~english
+  @brief Whether typed paths are completed
+  @sa DFileChooserEdit::setCompletionEnabled
+ */
+bool DFileChooserEdit::completionEnabled() const
+{
+    D_DC(DFileChooserEdit);
+
+    return d->completionEnabled;
+}
+
+/*!
+@~english
+  @brief Enable or disable validation of the typed path
+  \a enabled Whether to validate the path
+
+  When enabled, the path is checked on a worker thread after typing pauses. A path that does not match
+  the file mode, such as a missing file or a file where a directory is expected, is reported through
+  DLineEdit::setAlert and DLineEdit::showAlertMessage. Validation is disabled by default.
+  @sa DFileChooserEdit::pathValidationEnabled DFileChooserEdit::fileMode
+ */
+void DFileChooserEdit::setPathValidationEnabled(bool enabled)
+{
+    D_D(DFileChooserEdit);
+
+    if (d->pathValidationEnabled == enabled)
+        return;
+
+    d->pathValidationEnabled = enabled;
+    d->checkTimer->start();
+}
+
+/*!
+@~english
+  @brief Whether the typed path is validated
+  @sa DFileChooserEdit::setPathValidationEnabled
+ */
+bool DFileChooserEdit::pathValidationEnabled() const
+{
+    D_DC(DFileChooserEdit);
+
+    return d->pathValidationEnabled;
+}
 
 DFileChooserEditPrivate::DFileChooserEditPrivate(DFileChooserEdit *q)
     : DLineEditPrivate(q)
+    , checkGeneration(new QAtomicInt(0))
+    , maxCompletionCount(DefaultMaxCompletionCount)
 {
 }
 
+DFileChooserEditPrivate::~DFileChooserEditPrivate()
+{
+    // 让仍在工作线程中列目录的任务尽快退出
+    checkGeneration->fetchAndAddOrdered(1);
+}
+
 void DFileChooserEditPrivate::init()
 {
     D_Q(DFileChooserEdit);
@@ -260,6 +375,181 @@ void DFileChooserEditPrivate::init()
     q->setClearButtonEnabled(true);
 
     q->connect(btn, SIGNAL(clicked()), q, SLOT(_q_showFileChooserDialog()));
+
+    completionModel = new QStringListModel(q);
+    completer = new QCompleter(completionModel, q);
+    completer->setCaseSensitivity(Qt::CaseSensitive);
+    q->lineEdit()->setCompleter(completer);
+
+    checkTimer = new QTimer(q);
+    checkTimer->setSingleShot(true);
+    checkTimer->setInterval(PathCheckDelay);
+    q->connect(q, &DLineEdit::textChanged, checkTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    q->connect(checkTimer, &QTimer::timeout, q, [this] {
+        startPathCheck();
+    });
+}
+
+// 只补全绝对路径，返回最后一个 "/" 之前（含）的部分
+QString DFileChooserEditPrivate::directoryOf(const QString &path)
+{
+    if (!QDir::isAbsolutePath(path))
+        return QString();
+
+    return path.left(path.lastIndexOf(QLatin1Char('/')) + 1);
+}
+
+// 在工作线程中执行，directory 非空时最多列出 limit 个条目，发现有更新的检查时放弃列表
+DFileChooserPathCheck DFileChooserEditPrivate::checkPath(const QString &path, bool check, const QString &directory, int limit,
+                                                         int generation, const QSharedPointer<QAtomicInt> &currentGeneration)
+{
+    DFileChooserPathCheck result;
+    result.path = path;
+
+    if (check) {
+        const QFileInfo info(path);
+        result.checked = true;
+        result.exists = info.exists();
+        result.isDir = info.isDir();
+        result.parentExists = result.exists || info.absoluteDir().exists();
+    }
+
+    if (directory.isEmpty())
+        return result;
+
+    result.directory = directory;
+    QDirIterator it(directory, QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot);
+    while (it.hasNext()) {
+        if (currentGeneration->loadAcquire() != generation)
+            return result;
+
+        if (result.entries.size() >= limit) {
+            result.truncated = true;
+            break;
+        }
+
+        it.next();
+        const QString entry = directory + it.fileName();
+        result.entries << (it.fileInfo().isDir() ? entry + QLatin1Char('/') : entry);
+    }
+
+    result.entries.sort();
+    result.listed = true;
+    return result;
+}
+
+void DFileChooserEditPrivate::startPathCheck()
+{
+    D_Q(DFileChooserEdit);
+
+    // 递增编号，使仍在运行的旧任务放弃
+    const int generation = checkGeneration->fetchAndAddOrdered(1) + 1;
+    const QString path = q->text();
+    const bool check = pathValidationEnabled && !path.isEmpty();
+
+    if (!check && pathAlert) {
+        pathAlert = false;
+        q->setAlert(false);
+        q->hideAlertMessage();
+    }
+
+    QString directory = completionEnabled ? directoryOf(path) : QString();
+    if (!directory.isEmpty()) {
+        const DFileChooserListing *listing = _d_fileChooserListings->object(directory);
+        if (listing && listing->age.elapsed() < ListingCacheLifetime) {
+            applyListing(directory, listing->entries);
+            directory.clear();
+        }
+    }
+
+    if (!check && directory.isEmpty())
+        return;
+
+    auto watcher = new QFutureWatcher<DFileChooserPathCheck>(q);
+    q->connect(watcher, &QFutureWatcherBase::finished, q, [this, watcher, generation] {
+        watcher->deleteLater();
+
+        // 完整的列表即使已经过期也可以留给之后的输入使用
+        const DFileChooserPathCheck result = watcher->result();
+        if (result.listed) {
+            auto listing = new DFileChooserListing;
+            listing->entries = result.entries;
+            listing->age.start();
+            _d_fileChooserListings->insert(result.directory, listing);
+        }
+
+        if (generation == checkGeneration->loadAcquire())
+            applyPathCheck(result);
+    });
+
+    const QSharedPointer<QAtomicInt> currentGeneration = checkGeneration;
+    const int limit = maxCompletionCount;
+    watcher->setFuture(QtConcurrent::run(_d_fileChooserThreadPool(), [path, check, directory, limit, generation, currentGeneration] {
+        return checkPath(path, check, directory, limit, generation, currentGeneration);
+    }));
+}
+
+void DFileChooserEditPrivate::applyPathCheck(const DFileChooserPathCheck &result)
+{
+    if (result.listed)
+        applyListing(result.directory, result.entries);
+
+    if (result.checked)
+        updatePathAlert(result);
+}
+
+void DFileChooserEditPrivate::applyListing(const QString &directory, const QStringList &entries)
+{
+    D_Q(DFileChooserEdit);
+
+    if (directory == listedDirectory && completionModel->stringList() == entries)
+        return;
+
+    listedDirectory = directory;
+    completionModel->setStringList(entries);
+
+    // 更换模型后 QCompleter 不会自动弹出，需要在输入时主动弹出
+    if (q->lineEdit()->hasFocus())
+        completer->complete();
+}
+
+void DFileChooserEditPrivate::updatePathAlert(const DFileChooserPathCheck &result)
+{
+    D_Q(DFileChooserEdit);
+
+    const QFileDialog::FileMode mode = q->fileMode();
+    const bool wantDirectory = mode == QFileDialog::Directory || (dialog && dialog->testOption(QFileDialog::ShowDirsOnly));
+
+    QString message;
+    if (wantDirectory) {
+        if (!result.exists)
+            message = DFileChooserEdit::tr("The directory does not exist");
+        else if (!result.isDir)
+            message = DFileChooserEdit::tr("The path is not a directory");
+    } else if (mode == QFileDialog::AnyFile) {
+        if (result.isDir)
+            message = DFileChooserEdit::tr("The path is a directory");
+        else if (!result.parentExists)
+            message = DFileChooserEdit::tr("The parent directory does not exist");
+    } else {
+        if (!result.exists)
+            message = DFileChooserEdit::tr("The file does not exist");
+        else if (result.isDir)
+            message = DFileChooserEdit::tr("The path is a directory");
+    }
+
+    if (message.isEmpty()) {
+        if (pathAlert) {
+            pathAlert = false;
+            q->setAlert(false);
+            q->hideAlertMessage();
+        }
+        return;
+    }
+
+    pathAlert = true;
+    q->setAlert(true);
+    q->showAlertMessage(message);
 }
 
 void DFileChooserEditPrivate::_q_showFileChooserDialog()
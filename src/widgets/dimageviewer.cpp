@@ -15,6 +15,7 @@
 #include <QPinchGesture>
 #include <QVariantAnimation>
 #include <QGraphicsRectItem>
+#include <QtConcurrent>
 #include <qmath.h>
 
 DGUI_USE_NAMESPACE
@@ -186,6 +187,118 @@ QImage DImageViewerPrivate::loadImage(const QString &fileName, ImageType type) c
     return image;
 }
 
+// Square block edge used by rotation kernels, 32 x 32 pixels of 32 bits fit in L1 cache.
+static const int RotateBlockSize = 32;
+
+template<typename T>
+static void rotatePixels(const QImage &src, const QRect &rect, QImage &dst, int angle)
+{
+    const int width = rect.width();
+    const int height = rect.height();
+    const uchar *srcBits = src.constBits() + rect.y() * qptrdiff(src.bytesPerLine()) + rect.x() * qptrdiff(sizeof(T));
+    const qptrdiff srcStride = src.bytesPerLine();
+    uchar *dstBits = dst.bits();
+    const qptrdiff dstStride = dst.bytesPerLine();
+
+    if (180 == angle) {
+        for (int y = 0; y < height; ++y) {
+            const T *s = reinterpret_cast<const T *>(srcBits + y * srcStride);
+            T *d = reinterpret_cast<T *>(dstBits + (height - 1 - y) * dstStride) + width - 1;
+            for (int x = 0; x < width; ++x) {
+                *d-- = s[x];
+            }
+        }
+        return;
+    }
+
+    // 90 degrees: (x, y) -> (height - 1 - y, x), 270 degrees: (x, y) -> (y, width - 1 - x).
+    // Source column x is written to destination row, step between rows depends on direction.
+    const qptrdiff dstStep = (90 == angle) ? dstStride : -dstStride;
+    uchar *dstOrigin = (90 == angle) ? dstBits : dstBits + (width - 1) * dstStride;
+
+    // Transpose by blocks, so that both source and destination lines stay in cache.
+    for (int by = 0; by < height; by += RotateBlockSize) {
+        const int blockBottom = qMin(by + RotateBlockSize, height);
+        for (int bx = 0; bx < width; bx += RotateBlockSize) {
+            const int blockRight = qMin(bx + RotateBlockSize, width);
+            for (int y = by; y < blockBottom; ++y) {
+                const T *s = reinterpret_cast<const T *>(srcBits + y * srcStride);
+                const int column = (90 == angle) ? (height - 1 - y) : y;
+                uchar *d = dstOrigin + column * qptrdiff(sizeof(T));
+                for (int x = bx; x < blockRight; ++x) {
+                    *reinterpret_cast<T *>(d + x * dstStep) = s[x];
+                }
+            }
+        }
+    }
+}
+
+/*! \internal */
+QImage DImageViewerPrivate::transformImage(const QImage &image, const QRect &cropRect, int angle)
+{
+    const QRect rect = cropRect.isEmpty() ? image.rect() : cropRect.intersected(image.rect());
+    if (image.isNull() || rect.isEmpty()) {
+        return QImage();
+    }
+
+    if (0 == angle % 90) {
+        return rotateImageOrthogonal(image, rect, angle);
+    }
+
+    QImage result = (rect == image.rect()) ? image : image.copy(rect);
+    QTransform rotateMatrix;
+    rotateMatrix.rotate(angle);
+    return result.transformed(rotateMatrix, Qt::SmoothTransformation);
+}
+
+/*! \internal
+  Lossless rotation for multiple of 90 degrees, pixels are moved without resampling,
+  the crop \a rect is read in place.
+ */
+QImage DImageViewerPrivate::rotateImageOrthogonal(const QImage &image, const QRect &rect, int angle)
+{
+    angle = ((angle % 360) + 360) % 360;
+    if (0 == angle) {
+        return (rect == image.rect()) ? image : image.copy(rect);
+    }
+
+    const int depth = image.depth();
+    if (8 != depth && 16 != depth && 32 != depth && 64 != depth) {
+        // Formats with bytes unaligned pixels, Qt handles exact rotations without resampling.
+        QTransform rotateMatrix;
+        rotateMatrix.rotate(angle);
+        return image.copy(rect).transformed(rotateMatrix, Qt::FastTransformation);
+    }
+
+    const bool transposed = (180 != angle);
+    QImage result(transposed ? rect.size().transposed() : rect.size(), image.format());
+    if (result.isNull()) {
+        return result;
+    }
+
+    result.setColorTable(image.colorTable());
+    result.setDevicePixelRatio(image.devicePixelRatio());
+    result.setDotsPerMeterX(transposed ? image.dotsPerMeterY() : image.dotsPerMeterX());
+    result.setDotsPerMeterY(transposed ? image.dotsPerMeterX() : image.dotsPerMeterY());
+
+    switch (depth) {
+        case 8:
+            rotatePixels<quint8>(image, rect, result, angle);
+            break;
+        case 16:
+            rotatePixels<quint16>(image, rect, result, angle);
+            break;
+        case 32:
+            rotatePixels<quint32>(image, rect, result, angle);
+            break;
+        default:
+            rotatePixels<quint64>(image, rect, result, angle);
+            break;
+    }
+
+    return result;
+}
+
 /*! \internal */
 void DImageViewerPrivate::updateItemAndSceneRect()
 {
@@ -497,20 +610,21 @@ QImage DImageViewer::image() const
 {
     D_DC(DImageViewer);
 
-    QImage result = d->contentImage;
-    if (d->cropData && !d->cropData->cropRect.isEmpty()) {
-        result = result.copy(d->cropData->cropRect);
-    }
+    // Return cut out and rotate image.
+    return DImageViewerPrivate::transformImage(d->contentImage, d->cropData ? d->cropData->cropRect : QRect(), rotateAngle());
+}
 
-    int angle = rotateAngle();
-    if (0 != angle) {
-        QTransform rotateMatrix;
-        rotateMatrix.rotate(angle);
-        result = result.transformed(rotateMatrix, Qt::SmoothTransformation);
-    }
+QFuture<QImage> DImageViewer::imageAsync() const
+{
+    D_DC(DImageViewer);
 
-    // Return cut out and rotate image.
-    return result;
+    // QImage is implicitly shared, the worker thread gets a cheap snapshot of current state.
+    const QImage contentImage = d->contentImage;
+    const QRect cropRect = d->cropData ? d->cropData->cropRect : QRect();
+    const int angle = rotateAngle();
+
+    return QtConcurrent::run(
+        [contentImage, cropRect, angle]() { return DImageViewerPrivate::transformImage(contentImage, cropRect, angle); });
 }
 
 void DImageViewer::setImage(const QImage &image)
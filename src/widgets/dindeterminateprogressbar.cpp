@@ -8,86 +8,155 @@
 #include <DGuiApplicationHelper>
 
 #include <QPainter>
-#include <QTimer>
-#include <QPropertyAnimation>
+#include <QEasingCurve>
 #include <QDebug>
 #include <QPainterPath>
+#include <QWindow>
 
 DGUI_USE_NAMESPACE
 
 const int SPOT_WIDGET_WIDTH = 200;
+const int SLIDER_WIDTH = 150;
+// 滑块每秒移动的像素数
+const int SLIDER_SPEED = 200;
+// 光斑从左到右扫过一次的时长
+const int SPOT_DURATION = 3000;
+
+DIndeterminateProgressbarClock::DIndeterminateProgressbarClock(DIndeterminateProgressbarPrivate *d, QObject *parent)
+    : QAbstractAnimation(parent)
+    , d(d)
+{
+}
+
+int DIndeterminateProgressbarClock::duration() const
+{
+    return -1;
+}
+
+void DIndeterminateProgressbarClock::updateCurrentTime(int currentTime)
+{
+    d->advance(currentTime);
+}
 
 DIndeterminateProgressbarPrivate::DIndeterminateProgressbarPrivate(DIndeterminateProgressbar *qq)
     : DObjectPrivate(qq)
-    , m_sliderWidget(new QWidget(qq))
-    , m_timer(new QTimer(qq))
-    , m_leftToRight(true)
-    , m_spotWidget(nullptr)
-    , m_animation(nullptr)
+    , m_clock(new DIndeterminateProgressbarClock(this, qq))
+    , m_sliderX(0)
+    , m_spotX(-SPOT_WIDGET_WIDTH)
+    , m_spotEnabled(ENABLE_ANIMATIONS && ENABLE_ANIMATION_PROGRESSBAR)
+{
+}
+
+// 控件隐藏、所在窗口未曝光（如最小化）或被完全遮挡时不需要继续动画
+bool DIndeterminateProgressbarPrivate::isObscured() const
 {
-    if (!ENABLE_ANIMATIONS && !ENABLE_ANIMATION_PROGRESSBAR)
+    D_QC(DIndeterminateProgressbar);
+    if (!q->isVisible())
+        return true;
+
+    const QWindow *window = q->window()->windowHandle();
+    if (window && !window->isExposed())
+        return true;
+
+    return q->visibleRegion().isEmpty();
+}
+
+// 可见时启动或恢复时钟，隐藏时暂停；被遮挡时由 advance 暂停，重新绘制时再恢复
+void DIndeterminateProgressbarPrivate::updateClock()
+{
+    D_Q(DIndeterminateProgressbar);
+    if (!q->isVisible()) {
+        if (m_clock->state() == QAbstractAnimation::Running)
+            m_clock->pause();
         return;
+    }
 
-    m_spotWidget = new QWidget(qq);
-    m_animation = new QPropertyAnimation(m_spotWidget, "pos", qq);
+    if (m_clock->state() == QAbstractAnimation::Stopped)
+        m_clock->start();
+    else if (m_clock->state() == QAbstractAnimation::Paused)
+        m_clock->resume();
 }
 
-DIndeterminateProgressbar::DIndeterminateProgressbar(QWidget *parent)
-    : QWidget(parent)
-    , DObject(*new DIndeterminateProgressbarPrivate(this))
+// 滑块和光斑的位置只由时间和控件宽度决定，帧率变化或暂停都不会影响速度
+void DIndeterminateProgressbarPrivate::updatePositions(int time)
 {
-    D_D(DIndeterminateProgressbar);
+    D_Q(DIndeterminateProgressbar);
+    const int range = q->width() - SLIDER_WIDTH;
+    if (range > 0) {
+        const int distance = int(qint64(time) * SLIDER_SPEED / 1000 % (2 * range));
+        m_sliderX = distance <= range ? distance : 2 * range - distance;
+    } else {
+        m_sliderX = 0;
+    }
 
-    if (ENABLE_ANIMATIONS && ENABLE_ANIMATION_PROGRESSBAR) {
-        d->m_spotWidget->setFixedSize(SPOT_WIDGET_WIDTH, height());
-        d->m_spotWidget->move(-SPOT_WIDGET_WIDTH, 0);
+    if (m_spotEnabled) {
+        const qreal progress = (time % SPOT_DURATION) / qreal(SPOT_DURATION);
+        const qreal eased = QEasingCurve(QEasingCurve::InQuad).valueForProgress(progress);
+        m_spotX = -SPOT_WIDGET_WIDTH + qRound(eased * (q->rect().right() + SPOT_WIDGET_WIDTH));
     }
+}
 
-    d->m_sliderWidget->setFixedWidth(150);
-    d->m_sliderWidget->move(0, 0);
-
-    d->m_timer->setInterval(10);
-    static int step = 0;
-    connect(d->m_timer, &QTimer::timeout, this, [this, d]() {
-        if (d->m_sliderWidget->geometry().right() >= rect().right()) {
-            d->m_leftToRight = false;
-        }
-
-        if (d->m_sliderWidget->geometry().left() <= rect().left()) {
-            d->m_leftToRight = true;
-        }
-
-        d->m_leftToRight ? step += 2 : step -= 2;
-        d->m_sliderWidget->move(step, 0);
-        update();
-    });
-    d->m_timer->start();
+void DIndeterminateProgressbarPrivate::advance(int time)
+{
+    D_Q(DIndeterminateProgressbar);
+    if (isObscured()) {
+        m_clock->pause();
+        return;
+    }
+
+    const QRect oldRect = sliderRect();
+    updatePositions(time);
+    const QRect newRect = sliderRect();
+
+    // 光斑被裁剪在滑块内，只需重绘滑块移动前后覆盖的区域，左右各留出 1 像素给抗锯齿的边框
+    if (oldRect != newRect || m_spotEnabled)
+        q->update(oldRect.united(newRect).adjusted(-1, 0, 1, 0));
 }
 
-void DIndeterminateProgressbar::resizeEvent(QResizeEvent *e)
+QRect DIndeterminateProgressbarPrivate::sliderRect() const
 {
-    D_D(DIndeterminateProgressbar);
-    d->m_sliderWidget->setFixedHeight(height());
+    D_QC(DIndeterminateProgressbar);
+    return QRect(m_sliderX, 0, SLIDER_WIDTH, q->height());
+}
 
-    if (!ENABLE_ANIMATIONS || !ENABLE_ANIMATION_PROGRESSBAR)
-        QWidget::resizeEvent(e);
+QRect DIndeterminateProgressbarPrivate::spotRect() const
+{
+    D_QC(DIndeterminateProgressbar);
+    return QRect(m_spotX, 0, SPOT_WIDGET_WIDTH, q->height());
+}
 
-    d->m_spotWidget->setFixedSize(SPOT_WIDGET_WIDTH, height());
+DIndeterminateProgressbar::DIndeterminateProgressbar(QWidget *parent)
+    : QWidget(parent)
+    , DObject(*new DIndeterminateProgressbarPrivate(this))
+{
+}
 
-    d->m_animation->setStartValue(QPoint(-SPOT_WIDGET_WIDTH, 0));
-    d->m_animation->setEndValue(QPoint(rect().right(), 0));
-    d->m_animation->setDuration(3000);
-    d->m_animation->setEasingCurve(QEasingCurve::InQuad);
-    d->m_animation->start();
-    connect(d->m_animation, &QPropertyAnimation::finished, this, [d]() {
-        d->m_animation->start();
-    });
+void DIndeterminateProgressbar::resizeEvent(QResizeEvent *e)
+{
+    D_D(DIndeterminateProgressbar);
+    d->updatePositions(d->m_clock->currentTime());
     QWidget::resizeEvent(e);
 }
 
+void DIndeterminateProgressbar::showEvent(QShowEvent *e)
+{
+    D_D(DIndeterminateProgressbar);
+    d->updateClock();
+    QWidget::showEvent(e);
+}
+
+void DIndeterminateProgressbar::hideEvent(QHideEvent *e)
+{
+    D_D(DIndeterminateProgressbar);
+    d->updateClock();
+    QWidget::hideEvent(e);
+}
+
 void DIndeterminateProgressbar::paintEvent(QPaintEvent *e)
 {
     D_D(DIndeterminateProgressbar);
+    // 被遮挡时暂停的时钟在重新曝光后恢复
+    d->updateClock();
     QWidget::paintEvent(e);
     QPainter p(this);
 
@@ -113,7 +182,8 @@ void DIndeterminateProgressbar::paintEvent(QPaintEvent *e)
 
     p.setPen(Qt::NoPen);
     p.setBrush(palette().highlight().color());
-    p.drawRoundedRect(d->m_sliderWidget->geometry(), radius, radius);
+    const QRect sliderRect = d->sliderRect();
+    p.drawRoundedRect(sliderRect, radius, radius);
 
     QColor highLightColor(palette().highlight().color());
     auto borderColor = isDarkType ? DGuiApplicationHelper::adjustColor(highLightColor, 0, 0, +10, 0, 0, 0, 0)
@@ -121,16 +191,17 @@ void DIndeterminateProgressbar::paintEvent(QPaintEvent *e)
     pen.setColor(borderColor);
     p.setBrush(Qt::NoBrush);
     p.setPen(pen);
-    p.drawRoundedRect(d->m_sliderWidget->geometry(), radius, radius);
+    p.drawRoundedRect(sliderRect, radius, radius);
 
-    if (!ENABLE_ANIMATIONS || !ENABLE_ANIMATION_PROGRESSBAR)
+    if (!d->m_spotEnabled)
         return;
 
-    if (d->m_sliderWidget->width() < d->m_spotWidget->width() / 2)
+    const QRect spotRect = d->spotRect();
+    if (!spotRect.intersects(sliderRect))
         return;
 
-    QPointF pointStart(d->m_spotWidget->geometry().left(), d->m_spotWidget->geometry().center().y());
-    QPointF pointEnd(d->m_spotWidget->geometry().right(), d->m_spotWidget->geometry().center().y());
+    QPointF pointStart(spotRect.left(), spotRect.center().y());
+    QPointF pointEnd(spotRect.right(), spotRect.center().y());
 
     QColor spotColor = DGuiApplicationHelper::adjustColor(highLightColor, 0, +30, +30, 0, 0, 0, 0);
 
@@ -145,9 +216,9 @@ void DIndeterminateProgressbar::paintEvent(QPaintEvent *e)
     p.setPen(Qt::NoPen);
 
     QPainterPath clipPath;
-    clipPath.addRoundedRect(d->m_sliderWidget->geometry().marginsRemoved(QMargins(1, 1, 1, 1)), radius - 1, radius - 1);
+    clipPath.addRoundedRect(sliderRect.marginsRemoved(QMargins(1, 1, 1, 1)), radius - 1, radius - 1);
     p.setClipPath(clipPath);
     p.setClipping(true);
-    p.drawRoundedRect(d->m_spotWidget->geometry(), radius, radius);
+    p.drawRoundedRect(spotRect, radius, radius);
     p.setClipping(false);
 }
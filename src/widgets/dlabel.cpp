@@ -128,7 +128,7 @@ void DLabel::initPainter(QPainter *painter) const
     D_DC(DLabel);
     QLabel::initPainter(painter);
     if (d->color != DPalette::NoType) {
-        QBrush color = DPaletteHelper::instance()->palette(this).brush(d->color);
+        QBrush color = DPaletteHelper::instance()->brush(this, d->color);
         painter->setPen(QPen(color.color()));
     }
 }
@@ -181,7 +181,7 @@ void DLabel::paintEvent(QPaintEvent *event)
             context.palette = opt.palette;
 
             if (d_func()->color != DPalette::NoType) {
-                context.palette.setBrush(QPalette::Text, DPaletteHelper::instance()->palette(this).brush(d_func()->color));
+                context.palette.setBrush(QPalette::Text, DPaletteHelper::instance()->brush(this, d_func()->color));
             } else if (foregroundRole() != QPalette::Text && isEnabled()) {
                 context.palette.setColor(QPalette::Text, context.palette.color(foregroundRole()));
             }
@@ -204,7 +204,7 @@ void DLabel::paintEvent(QPaintEvent *event)
             QPalette palette = opt.palette;
 
             if (d_func()->color != DPalette::NoType) {
-                palette.setBrush(foregroundRole(), DPaletteHelper::instance()->palette(this).brush(d_func()->color));
+                palette.setBrush(foregroundRole(), DPaletteHelper::instance()->brush(this, d_func()->color));
             }
 
             QString text = d->text;
@@ -55,14 +55,12 @@ bool DVariantListModel::insertRows(int row, int count, const QModelIndex &parent
     if (count < 1 || row < 0 || row > rowCount(parent))
         return false;
 
-    beginInsertRows(QModelIndex(), row, row + count - 1);
-
+    QVariantList items;
+    items.reserve(count);
     for (int r = 0; r < count; ++r)
-        dataList.insert(row, QVariant());
-
-    endInsertRows();
+        items.append(QVariant());
 
-    return true;
+    return insertItems(row, std::move(items));
 }
 
 bool DVariantListModel::removeRows(int row, int count, const QModelIndex &parent)
@@ -70,11 +68,88 @@ bool DVariantListModel::removeRows(int row, int count, const QModelIndex &parent
     if (count <= 0 || row < 0 || (row + count) > rowCount(parent))
         return false;
 
-    beginRemoveRows(QModelIndex(), row, row + count - 1);
+    return removeItems(row, count);
+}
 
-    for (int r = 0; r < count; ++r)
-        dataList.removeAt(row);
+/*!
+  @~english
+  \brief Insert \a items before \a row with a single rowsInserted notification
+  \return false if \a items is empty or \a row is out of range
+ */
+bool DVariantListModel::insertItems(int row, const QVariantList &items)
+{
+    return insertItems(row, QVariantList(items));
+}
 
+bool DVariantListModel::insertItems(int row, QVariantList &&items)
+{
+    if (items.isEmpty() || row < 0 || row > dataList.count())
+        return false;
+
+    beginInsertRows(QModelIndex(), row, row + items.count() - 1);
+
+    if (dataList.isEmpty()) {
+        dataList = std::move(items);
+    } else if (row == dataList.count()) {
+        dataList.append(items);
+    } else {
+        // 一次性拼接，避免逐个插入时反复移动后面的数据
+        QVariantList result;
+        result.reserve(dataList.count() + items.count());
+        result.append(dataList.mid(0, row));
+        result.append(items);
+        result.append(dataList.mid(row));
+        dataList.swap(result);
+    }
+
+    endInsertRows();
+
+    return true;
+}
+
+/*!
+  @~english
+  \brief Append \a items to the end of the model
+  \sa DVariantListModel::insertItems
+ */
+bool DVariantListModel::appendItems(const QVariantList &items)
+{
+    return insertItems(dataList.count(), items);
+}
+
+bool DVariantListModel::appendItems(QVariantList &&items)
+{
+    return insertItems(dataList.count(), std::move(items));
+}
+
+/*!
+  @~english
+  \brief Replace all data of the model with \a items, the model is reset once
+ */
+void DVariantListModel::replaceAll(const QVariantList &items)
+{
+    replaceAll(QVariantList(items));
+}
+
+void DVariantListModel::replaceAll(QVariantList &&items)
+{
+    beginResetModel();
+    dataList = std::move(items);
+    endResetModel();
+}
+
+/*!
+  @~english
+  \brief Remove \a count items starting at \a row with a single rowsRemoved notification
+  \return false if the range is out of the model
+ */
+bool DVariantListModel::removeItems(int row, int count)
+{
+    if (count <= 0 || row < 0 || (row + count) > dataList.count())
+        return false;
+
+    beginRemoveRows(QModelIndex(), row, row + count - 1);
+    dataList.erase(dataList.begin() + row, dataList.begin() + row + count);
     endRemoveRows();
 
     return true;
@@ -459,6 +534,9 @@ bool DListView::addItems(const QVariantList &datas)
  */
 bool DListView::insertItem(int index, const QVariant &data)
 {
+    if (auto variantModel = dynamic_cast<DVariantListModel *>(model()))
+        return variantModel->insertItems(index, QVariantList() << data);
+
     if (!model()->insertRow(index))
         return false;
 
@@ -474,6 +552,10 @@ bool DListView::insertItem(int index, const QVariant &data)
  */
 bool DListView::insertItems(int index, const QVariantList &datas)
 {
+    // DVariantListModel 可以一次插入全部数据，只产生一次插入通知
+    if (auto variantModel = dynamic_cast<DVariantListModel *>(model()))
+        return variantModel->insertItems(index, datas);
+
     if (!model()->insertRows(index, datas.count()))
         return false;
 
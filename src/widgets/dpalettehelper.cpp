@@ -6,6 +6,7 @@
 #include <DGuiApplicationHelper>
 
 #include "dpalettehelper.h"
+#include "dapplication.h"
 #include "dstyleoption.h"
 #include "private/dpalettehelper_p.h"
 
@@ -15,9 +16,102 @@ static DPaletteHelper *g_instance = nullptr;
 
 DPaletteHelperPrivate::DPaletteHelperPrivate(DPaletteHelper *qq)
     : DTK_CORE_NAMESPACE::DObjectPrivate(qq)
+    , useEventFilter(!qobject_cast<DApplication *>(QCoreApplication::instance()))
 {
 }
 
+/*!
+  \internal
+  \brief 由 DApplication::notify 调用，统一处理调色板缓存的失效，不再为每个控件安装事件过滤器
+ */
+void DPaletteHelperPrivate::notify(QObject *obj, QEvent *event)
+{
+    if (g_instance)
+        g_instance->d_func()->invalidate(obj, event->type());
+}
+
+const DPalette &DPaletteHelperPrivate::resolve(const QWidget *widget)
+{
+    // 先从缓存中取数据
+    auto it = paletteCache.find(widget);
+    if (it != paletteCache.end() && it->widget && (it->explicitPalette || it->generation == generation))
+        return it->palette;
+
+    DPalette palette;
+    if (QWidget *parent = widget->parentWidget()) {
+        palette = resolve(parent);
+    } else {
+        palette = DGuiApplicationHelper::instance()->applicationPalette();
+    }
+
+    // 判断widget对象有没有被设置过palette
+    if (widget->testAttribute(Qt::WA_SetPalette)) {
+        // 存在自定义palette时应该根据其自定义的palette获取对应色调的DPalette
+        const QPalette &wp = widget->palette();
+
+        // 判断控件自己的palette色调是否和要继承调色板色调一致
+        if (DGuiApplicationHelper::instance()->toColorType(palette) != DGuiApplicationHelper::instance()->toColorType(wp)) {
+            // 不一致时则fallback到标准的palette
+            palette = DGuiApplicationHelper::instance()->standardPalette(DGuiApplicationHelper::instance()->toColorType(wp));
+        }
+    }
+
+    if (paletteCache.size() >= purgeThreshold)
+        removeDestroyedEntries();
+
+    // 缓存数据
+    CacheEntry &entry = paletteCache[widget];
+    entry.palette = palette;
+    entry.widget = const_cast<QWidget *>(widget);
+    entry.generation = generation;
+    entry.explicitPalette = false;
+
+    if (useEventFilter) {
+        D_Q(DPaletteHelper);
+        // 关注控件palette改变的事件
+        const_cast<QWidget *>(widget)->installEventFilter(q);
+    }
+
+    return entry.palette;
+}
+
+void DPaletteHelperPrivate::invalidate(QObject *obj, QEvent::Type type)
+{
+    if (type == QEvent::ApplicationPaletteChange) {
+        // 控件也会收到此事件，只在应用本身收到时处理一次
+        if (obj == QCoreApplication::instance())
+            ++generation;
+        return;
+    }
+
+    if (paletteCache.isEmpty() || !obj->isWidgetType())
+        return;
+
+    auto it = paletteCache.find(static_cast<QWidget *>(obj));
+    if (it == paletteCache.end() || it->explicitPalette)
+        return;
+
+    // 清理缓存
+    paletteCache.erase(it);
+
+    // 父控件改变后子控件继承的数据也需要重新获取
+    if (type == QEvent::ParentChange)
+        ++generation;
+}
+
+void DPaletteHelperPrivate::removeDestroyedEntries()
+{
+    for (auto it = paletteCache.begin(); it != paletteCache.end();) {
+        if (it->widget) {
+            ++it;
+        } else {
+            it = paletteCache.erase(it);
+        }
+    }
+
+    purgeThreshold = qMax(64, paletteCache.size() * 2);
+}
+
 DPaletteHelper::DPaletteHelper(QObject *parent)
     : QObject(parent)
     , DTK_CORE_NAMESPACE::DObject(*new DPaletteHelperPrivate(this))
@@ -51,42 +145,11 @@ DPalette DPaletteHelper::palette(const QWidget *widget, const QPalette &base) co
 {
     D_DC(DPaletteHelper);
 
-    DPalette palette;
-
     if (!widget) {
         return DGuiApplicationHelper::instance()->applicationPalette();
     }
 
-    do {
-        // 先从缓存中取数据
-        if (d->paletteCache.contains(widget)) {
-            palette = d->paletteCache.value(widget);
-            break;
-        }
-
-        if (QWidget *parent = widget->parentWidget()) {
-            palette = this->palette(parent, base);
-        } else {
-            palette = DGuiApplicationHelper::instance()->applicationPalette();
-        }
-
-        // 判断widget对象有没有被设置过palette
-        if (widget->testAttribute(Qt::WA_SetPalette)) {
-            // 存在自定义palette时应该根据其自定义的palette获取对应色调的DPalette
-            const QPalette &wp = widget->palette();
-
-            // 判断控件自己的palette色调是否和要继承调色板色调一致
-            if (DGuiApplicationHelper::instance()->toColorType(palette) != DGuiApplicationHelper::instance()->toColorType(wp)) {
-                // 不一致时则fallback到标准的palette
-                palette = DGuiApplicationHelper::instance()->standardPalette(DGuiApplicationHelper::instance()->toColorType(wp));
-            }
-        }
-
-        // 缓存数据
-        const_cast<DPaletteHelperPrivate *>(d)->paletteCache.insert(widget, palette);
-        // 关注控件palette改变的事件
-        const_cast<QWidget *>(widget)->installEventFilter(const_cast<DPaletteHelper *>(this));
-    } while (false);
+    DPalette palette = const_cast<DPaletteHelperPrivate *>(d)->resolve(widget);
     palette.QPalette::operator=(
 #if QT_VERSION < QT_VERSION_CHECK(6,0,0)
     base.resolve()
@@ -106,8 +169,13 @@ void DPaletteHelper::setPalette(QWidget *widget, const DPalette &palette)
 {
     D_D(DPaletteHelper);
 
-    d->paletteCache.insert(widget, palette);
-    widget->installEventFilter(const_cast<DPaletteHelper *>(this));
+    DPaletteHelperPrivate::CacheEntry &entry = d->paletteCache[widget];
+    entry.palette = palette;
+    entry.widget = widget;
+    entry.generation = d->generation;
+    entry.explicitPalette = true;
+    if (d->useEventFilter)
+        widget->installEventFilter(this);
     // 记录此控件被设置过palette
     widget->setProperty("_d_set_palette", true);
     widget->setPalette(palette);
@@ -127,24 +195,53 @@ void DPaletteHelper::resetPalette(QWidget *widget)
     widget->setAttribute(Qt::WA_SetPalette, false);
 }
 
+/*!
+  \brief DPaletteHelper::brush返回控件调色板中 \a type 对应的画刷
+  \a widget 控件
+  \a type 颜色类型
+  \a group 颜色组，为 QPalette::Current 时使用 widget->palette() 的当前颜色组，
+  即控件被禁用时为 Disabled，所在窗口未激活时为 Inactive，其余为 Active
+
+  palette(widget) 返回的调色板带有同样的当前颜色组，因此 brush(widget, type) 与 palette(widget).brush(type) 结果相同，
+  但不需要复制整个调色板，适合在绘制时频繁调用。
+  \return 画刷
+ */
+QBrush DPaletteHelper::brush(const QWidget *widget, DPalette::ColorType type, QPalette::ColorGroup group) const
+{
+    D_DC(DPaletteHelper);
+
+    if (!widget) {
+        const DPalette &palette = DGuiApplicationHelper::instance()->applicationPalette();
+        return palette.brush(group == QPalette::Current ? palette.currentColorGroup() : group, type);
+    }
+
+    // 与 palette(widget) 一样以控件自身调色板的当前颜色组为准
+    if (group == QPalette::Current)
+        group = widget->palette().currentColorGroup();
+
+    return const_cast<DPaletteHelperPrivate *>(d)->resolve(widget).brush(group, type);
+}
+
+/*!
+  \brief DPaletteHelper::color返回控件调色板中 \a type 对应的颜色
+  \a widget 控件
+  \a type 颜色类型
+  \a group 颜色组，为 QPalette::Current 时使用控件当前的颜色组
+  \return 颜色
+  \sa brush
+ */
+QColor DPaletteHelper::color(const QWidget *widget, DPalette::ColorType type, QPalette::ColorGroup group) const
+{
+    return brush(widget, type, group).color();
+}
+
 bool DPaletteHelper::eventFilter(QObject *watched, QEvent *event)
 {
     D_D(DPaletteHelper);
 
-    if (Q_UNLIKELY(event->type() == QEvent::PaletteChange)) {
-        if (QWidget *widget = qobject_cast<QWidget *>(watched)) {
-            if (!widget->property("_d_set_palette").toBool()) {
-                // 清理缓存
-                d->paletteCache.remove(widget);
-            }
-        }
-    } else if (Q_UNLIKELY(event->type() == QEvent::Destroy)) {
-        if (QWidget *widget = qobject_cast<QWidget *>(watched)) {
-            if (d->paletteCache.contains(widget)) {
-                // 清理缓存
-                d->paletteCache.remove(widget);
-            }
-        }
+    // 只有没有 DApplication 时才会安装事件过滤器
+    if (Q_UNLIKELY(event->type() == QEvent::PaletteChange || event->type() == QEvent::ParentChange)) {
+        d->invalidate(watched, event->type());
     }
 
     return QObject::eventFilter(watched, event);
@@ -0,0 +1,274 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "private/dprintjobsubmitter_p.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QLibrary>
+#include <QScopedPointer>
+#include <QtConcurrent>
+
+#include <cups/cups.h>
+
+DWIDGET_BEGIN_NAMESPACE
+
+// 每次写入 cupsd 的数据大小
+static const qint64 DefaultChunkSize = 64 * 1024;
+// 整个任务最多发送的进度通知次数，避免大文件时向界面线程投递过多事件
+static const int MaxProgressNotifications = 100;
+
+typedef int (*CupsCreateJobFunc)(http_t *http, const char *name, const char *title,
+                                 int num_options, cups_option_t *options);
+typedef http_status_t (*CupsStartDocumentFunc)(http_t *http, const char *name, int job_id,
+                                               const char *docname, const char *format, int last_document);
+typedef http_status_t (*CupsWriteRequestDataFunc)(http_t *http, const char *buffer, size_t length);
+typedef ipp_status_t (*CupsFinishDocumentFunc)(http_t *http, const char *name);
+typedef int (*CupsCancelJob2Func)(http_t *http, const char *name, int job_id, int purge);
+typedef const char *(*CupsLastErrorStringFunc)();
+
+Q_GLOBAL_STATIC(DPrintJobSubmitter::BackendFactory, _d_printJobBackendFactory)
+
+bool DCupsPrintJobBackend::resolve()
+{
+    if (cupsCreateJob)
+        return true;
+
+    //  libcups2-dev libcups2
+    QLibrary cupsLibrary("cups", "2");
+    if (!cupsLibrary.isLoaded() && !cupsLibrary.load()) {
+        error = QStringLiteral("Cups not found");
+        return false;
+    }
+
+    cupsStartDocument = cupsLibrary.resolve("cupsStartDocument");
+    cupsWriteRequestData = cupsLibrary.resolve("cupsWriteRequestData");
+    cupsFinishDocument = cupsLibrary.resolve("cupsFinishDocument");
+    cupsCancelJob2 = cupsLibrary.resolve("cupsCancelJob2");
+    cupsLastErrorString = cupsLibrary.resolve("cupsLastErrorString");
+    if (!cupsStartDocument || !cupsWriteRequestData || !cupsFinishDocument || !cupsCancelJob2 || !cupsLastErrorString) {
+        error = QStringLiteral("cups job functions load failed");
+        return false;
+    }
+
+    // 最后设置 cupsCreateJob，作为全部函数加载成功的标志
+    cupsCreateJob = cupsLibrary.resolve("cupsCreateJob");
+    if (!cupsCreateJob) {
+        error = QStringLiteral("cupsCreateJob function load failed");
+        return false;
+    }
+
+    return true;
+}
+
+int DCupsPrintJobBackend::createJob(const QByteArray &printer, const QByteArray &title, const PrintOptions &options)
+{
+    if (!resolve())
+        return 0;
+
+    QVector<cups_option_t> cupsOptStruct;
+    cupsOptStruct.reserve(options.size());
+    for (const auto &option : options) {
+        cups_option_t opt;
+        opt.name = const_cast<char *>(option.first.constData());
+        opt.value = const_cast<char *>(option.second.constData());
+        cupsOptStruct.append(opt);
+    }
+
+    cups_option_t *optPtr = cupsOptStruct.size() ? cupsOptStruct.data() : nullptr;
+    const int jobId = reinterpret_cast<CupsCreateJobFunc>(cupsCreateJob)(CUPS_HTTP_DEFAULT, printer.constData(), title.constData(),
+                                                                         cupsOptStruct.size(), optPtr);
+    if (jobId <= 0)
+        error = QString::fromUtf8(reinterpret_cast<CupsLastErrorStringFunc>(cupsLastErrorString)());
+
+    return qMax(jobId, 0);
+}
+
+bool DCupsPrintJobBackend::startDocument(const QByteArray &printer, int jobId, const QByteArray &docName)
+{
+    const http_status_t status = reinterpret_cast<CupsStartDocumentFunc>(cupsStartDocument)(CUPS_HTTP_DEFAULT, printer.constData(), jobId,
+                                                                                           docName.constData(), CUPS_FORMAT_AUTO, 1);
+    if (status != HTTP_STATUS_CONTINUE) {
+        error = QString::fromUtf8(reinterpret_cast<CupsLastErrorStringFunc>(cupsLastErrorString)());
+        return false;
+    }
+
+    return true;
+}
+
+bool DCupsPrintJobBackend::writeData(const char *data, qint64 size)
+{
+    const http_status_t status = reinterpret_cast<CupsWriteRequestDataFunc>(cupsWriteRequestData)(CUPS_HTTP_DEFAULT, data, size_t(size));
+    if (status != HTTP_STATUS_CONTINUE) {
+        error = QString::fromUtf8(reinterpret_cast<CupsLastErrorStringFunc>(cupsLastErrorString)());
+        return false;
+    }
+
+    return true;
+}
+
+bool DCupsPrintJobBackend::finishDocument(const QByteArray &printer)
+{
+    const ipp_status_t status = reinterpret_cast<CupsFinishDocumentFunc>(cupsFinishDocument)(CUPS_HTTP_DEFAULT, printer.constData());
+    if (status >= IPP_STATUS_REDIRECTION_OTHER_SITE) {
+        error = QString::fromUtf8(reinterpret_cast<CupsLastErrorStringFunc>(cupsLastErrorString)());
+        return false;
+    }
+
+    return true;
+}
+
+void DCupsPrintJobBackend::cancelJob(const QByteArray &printer, int jobId)
+{
+    if (cupsCancelJob2)
+        reinterpret_cast<CupsCancelJob2Func>(cupsCancelJob2)(CUPS_HTTP_DEFAULT, printer.constData(), jobId, 1);
+}
+
+QString DCupsPrintJobBackend::errorString() const
+{
+    return error;
+}
+
+/*!
+  \internal
+  \brief DPrintJobSubmitter 在工作线程中分块提交按路径打印的文件，避免上传大文件时阻塞界面.
+
+  每个对象同一时间只处理一个任务，进度和结果通过信号通知到对象所在的线程。
+ */
+DPrintJobSubmitter::DPrintJobSubmitter(QObject *parent)
+    : QObject(parent)
+    , chunk(DefaultChunkSize)
+{
+}
+
+DPrintJobSubmitter::~DPrintJobSubmitter()
+{
+    cancel();
+    waitForFinished();
+}
+
+/*!
+  \internal
+  \brief 替换创建打印后端的函数，传入空函数时恢复使用 libcups，用于在没有 cupsd 的环境中测试.
+ */
+void DPrintJobSubmitter::setBackendFactory(const BackendFactory &factory)
+{
+    *_d_printJobBackendFactory = factory;
+}
+
+DPrintJobBackend *DPrintJobSubmitter::createBackend()
+{
+    if (*_d_printJobBackendFactory)
+        return (*_d_printJobBackendFactory)();
+
+    return new DCupsPrintJobBackend;
+}
+
+bool DPrintJobSubmitter::submit(const QString &printer, const QString &filePath, const QString &title, const PrintOptions &options)
+{
+    if (isRunning()) {
+        qWarning() << "A print job is already being submitted";
+        return false;
+    }
+
+    canceled.storeRelaxed(0);
+    DPrintJobBackend *backend = createBackend();
+    future = QtConcurrent::run(QThreadPool::globalInstance(), [this, backend, printer, filePath, title, options] {
+        run(backend, printer.toLocal8Bit(), filePath, title.toLocal8Bit(), options);
+    });
+
+    return true;
+}
+
+bool DPrintJobSubmitter::isRunning() const
+{
+    return future.isRunning();
+}
+
+void DPrintJobSubmitter::cancel()
+{
+    canceled.storeRelaxed(1);
+}
+
+void DPrintJobSubmitter::waitForFinished()
+{
+    future.waitForFinished();
+}
+
+qint64 DPrintJobSubmitter::chunkSize() const
+{
+    return chunk;
+}
+
+void DPrintJobSubmitter::setChunkSize(qint64 size)
+{
+    chunk = qMax<qint64>(1, size);
+}
+
+void DPrintJobSubmitter::run(DPrintJobBackend *backend, const QByteArray &printer, const QString &filePath,
+                             const QByteArray &title, const PrintOptions &options)
+{
+    QScopedPointer<DPrintJobBackend> guard(backend);
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        Q_EMIT finished(false, file.errorString());
+        return;
+    }
+
+    const qint64 total = file.size();
+    Q_EMIT progressChanged(0, total);
+
+    const int jobId = backend->createJob(printer, title, options);
+    if (!jobId) {
+        Q_EMIT finished(false, backend->errorString());
+        return;
+    }
+
+    if (!backend->startDocument(printer, jobId, QFileInfo(filePath).fileName().toLocal8Bit())) {
+        const QString error = backend->errorString();
+        backend->cancelJob(printer, jobId);
+        Q_EMIT finished(false, error);
+        return;
+    }
+
+    QByteArray buffer(int(qMin(chunk, qMax<qint64>(total, 1))), Qt::Uninitialized);
+    const qint64 progressStep = qMax<qint64>(1, total / MaxProgressNotifications);
+    qint64 sent = 0;
+    qint64 notified = 0;
+    while (!file.atEnd()) {
+        if (canceled.loadRelaxed()) {
+            backend->cancelJob(printer, jobId);
+            Q_EMIT finished(false, QStringLiteral("Print job canceled"));
+            return;
+        }
+
+        const qint64 size = file.read(buffer.data(), buffer.size());
+        if (size < 0 || !backend->writeData(buffer.constData(), size)) {
+            const QString error = size < 0 ? file.errorString() : backend->errorString();
+            backend->cancelJob(printer, jobId);
+            Q_EMIT finished(false, error);
+            return;
+        }
+
+        sent += size;
+        if (sent - notified >= progressStep) {
+            notified = sent;
+            Q_EMIT progressChanged(sent, total);
+        }
+    }
+
+    if (notified != sent)
+        Q_EMIT progressChanged(sent, total);
+
+    if (!backend->finishDocument(printer)) {
+        Q_EMIT finished(false, backend->errorString());
+        return;
+    }
+
+    Q_EMIT finished(true, QString());
+}
+
+DWIDGET_END_NAMESPACE
@@ -40,6 +40,8 @@
 #include <QDebug>
 #include <QTime>
 #include <QFontDatabase>
+#include <QSet>
+#include <QStringListModel>
 #include <QDesktopServices>
 #include <QRegularExpression>
 #include <QRegularExpressionValidator>
@@ -854,6 +856,9 @@ void DPrintPreviewDialogPrivate::initWaterMarkui()
     QHBoxLayout *hlayout3 = new QHBoxLayout;
     fontCombo = new DComboBox;
     fontCombo->setObjectName(_d_printSettingNameMap[DPrintPreviewSettingInterface::SC_Watermark_TextFont]);
+    // 字体列表通过一次模型重置整体设置，避免逐个插入
+    fontModel = new QStringListModel(fontCombo);
+    fontCombo->setModel(fontModel);
 
     waterColorBtn = new DIconButton(textWatermarkWdg);
     waterColorBtn->setObjectName(_d_printSettingNameMap[DPrintPreviewSettingInterface::SC_Watermark_TextColor]);
@@ -1606,6 +1611,75 @@ void DPrintPreviewDialogPrivate::setTurnPageBtnStatus()
     }
 }
 
+/*!
+  \brief DPrintPreviewDialogPrivate::watermarkFontFamilies 返回可支持的所有字体
+  \return 去重后的字体列表，每个进程只获取一次
+ */
+const QStringList &DPrintPreviewDialogPrivate::watermarkFontFamilies()
+{
+    static const QStringList families = [] {
+#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
+        QFontDatabase fdb;
+        const QStringList fontList = fdb.families(QFontDatabase::Any);
+#else
+        const QStringList fontList = QFontDatabase::families(QFontDatabase::Any);
+#endif
+        QStringList result;
+        QSet<QString> added;
+        result.reserve(fontList.size());
+        added.reserve(fontList.size());
+        for (const QString &font : fontList) {
+            if (!added.contains(font)) {
+                added.insert(font);
+                result << font;
+            }
+        }
+        return result;
+    }();
+
+    return families;
+}
+
+/*!
+  \brief DPrintPreviewDialogPrivate::updateWatermarkFonts 将字体下拉框中缺少的字体添加到末尾
+ */
+void DPrintPreviewDialogPrivate::updateWatermarkFonts()
+{
+    QStringList fonts = fontModel->stringList();
+    QSet<QString> existing;
+    existing.reserve(fonts.size());
+    for (const QString &font : fonts)
+        existing.insert(font);
+
+    const int count = fonts.size();
+    for (const QString &font : watermarkFontFamilies()) {
+        if (!existing.contains(font))
+            fonts << font;
+    }
+
+    if (fonts.size() != count)
+        setWatermarkFontList(fonts);
+}
+
+/*!
+  \brief DPrintPreviewDialogPrivate::setWatermarkFontList 设置字体下拉框的字体列表
+  \a fonts 字体列表
+
+  保留当前选中的字体，不存在时选中第一个字体，选中的字体改变时发出一次 currentIndexChanged 信号。
+ */
+void DPrintPreviewDialogPrivate::setWatermarkFontList(const QStringList &fonts)
+{
+    const QString currentFont = fontCombo->currentText();
+    fontCombo->blockSignals(true);
+    fontModel->setStringList(fonts);
+    const int index = fontCombo->findText(currentFont);
+    fontCombo->setCurrentIndex(index >= 0 ? index : 0);
+    fontCombo->blockSignals(false);
+
+    if (fontCombo->currentText() != currentFont)
+        Q_EMIT fontCombo->currentIndexChanged(fontCombo->currentIndex());
+}
+
 /*!
   \brief DPrintPreviewDialogPrivate::watermarkTypeChoosed 选取水印类型
   \a index 判断选取的水印类型
@@ -1624,19 +1698,7 @@ void DPrintPreviewDialogPrivate::watermarkTypeChoosed(int index)
             settingHelper->setSubControlEnabled(DPrintPreviewSettingInterface::SC_Watermark_TextColor, true);
         _q_textWaterMarkModeChanged(waterTextCombo->currentIndex());
         initWaterSettings();
-        // 获取可支持的所有字体
-#if QT_VERSION < QT_VERSION_CHECK(6,0,0)
-        QFontDatabase fdb;
-        QStringList fontList = fdb.families(QFontDatabase::Any);
-#else
-        QStringList fontList = QFontDatabase::families(QFontDatabase::Any);
-#endif
-        Q_FOREACH (const QString &font, fontList) {
-            if (fontCombo->findText(font) != -1)
-                continue;
-
-            fontCombo->addItem(font);
-        }
+        updateWatermarkFonts();
 
         if (!q->property("_d_print_waterIsInit").toBool()) {
             // 初始化才使用系统默认字体 下次切换时保留上一次字体
@@ -1645,11 +1707,9 @@ void DPrintPreviewDialogPrivate::watermarkTypeChoosed(int index)
             QFontInfo fontName(font);
             QString defaultFontName = fontName.family();
             //默认初始化水印字体是系统当前字体
-            for (QString itemName : fontList) {
-                if (itemName == defaultFontName) {
-                    fontCombo->setCurrentText(itemName);
-                }
-            }
+            int defaultIndex = fontCombo->findText(defaultFontName);
+            if (defaultIndex >= 0)
+                fontCombo->setCurrentIndex(defaultIndex);
             q->setProperty("_d_print_waterIsInit", true);
         }
         pview->setWaterMarkType(Type_Text);
@@ -2906,8 +2966,7 @@ DPrintPreviewSettingInfo *PreviewSettingsPluginHelper::loadInfo(DPrintPreviewSet
                 break;
             }
             watermarkInfo->customText = d->waterTextEdit->text();
-            for (int index = 0; index < d->fontCombo->count(); ++index)
-                watermarkInfo->fontList << d->fontCombo->itemText(index);
+            watermarkInfo->fontList << d->fontModel->stringList();
             watermarkInfo->textColor = d->pview->waterMarkColor();
         }
             break;
@@ -3098,19 +3157,19 @@ void PreviewSettingsPluginHelper::updateSettingInfo(DPrintPreviewSettingInfo *in
             d->waterTextCombo->setCurrentIndex(watermarkInfo->textType);
             d->waterTextEdit->setText(watermarkInfo->customText);
             d->_q_customTextWatermarkFinished();
-            QStringList targetFonts, sourceFonts;
-            for (int index = 0; index < d->fontCombo->count(); ++index) {
-                const QString &font = d->fontCombo->itemText(index);
-                sourceFonts << font;
-                if (watermarkInfo->fontList.contains(font))
+            QStringList targetFonts;
+            const QStringList sourceFonts = d->fontModel->stringList();
+            QSet<QString> settingFonts;
+            settingFonts.reserve(watermarkInfo->fontList.size());
+            for (const QString &font : watermarkInfo->fontList)
+                settingFonts.insert(font);
+            for (const QString &font : sourceFonts) {
+                if (settingFonts.contains(font))
                    targetFonts << font;
             }
 
             if (!targetFonts.isEmpty() && targetFonts != sourceFonts) {
-                d->fontCombo->blockSignals(true);
-                d->fontCombo->clear();
-                d->fontCombo->blockSignals(false);
-                d->fontCombo->addItems(targetFonts);
+                d->setWatermarkFontList(targetFonts);
             }
 
             if (d->supportedColorMode)
@@ -798,42 +798,24 @@ PrintOptions DPrintPreviewWidgetPrivate::printerOptions()
 
 void DPrintPreviewWidgetPrivate::printByCups()
 {
-    //  libcups2-dev libcups2
-    QLibrary cupsLibrary("cups", "2");
-    if (!cupsLibrary.isLoaded()) {
-        if (!cupsLibrary.load()) {
-            qWarning() << "Cups not found";
-            return;
-        }
-    }
+    Q_Q(DPrintPreviewWidget);
 
-    int (*cupsPrintFile)(const char *name, const char *filename,
-                         const char *title, int num_options,
-                         cups_option_t *options) = nullptr;
-    cupsPrintFile = reinterpret_cast<decltype(cupsPrintFile)>(cupsLibrary.resolve("cupsPrintFile"));
-    if (!cupsPrintFile) {
-        qWarning() << "cupsPrintFile function load failed";
+    if (printJob && printJob->isRunning()) {
+        qWarning() << "The previous print job is still being submitted";
         return;
     }
 
-    PrintOptions options = printerOptions();
-    const int numOptions = options.size();
-
-    QVector<cups_option_t> cupsOptStruct;
-    cupsOptStruct.reserve(numOptions);
-
-    for (int c = 0; c < numOptions; ++c) {
-        cups_option_t opt;
-        opt.name = options[c].first.data();
-        opt.value = options[c].second.data();
-        cupsOptStruct.append(opt);
-    }
-
-    QString printerName = previewPrinter->printerName();
-    cups_option_t *optPtr = cupsOptStruct.size() ? &cupsOptStruct.first() : nullptr;
+    // 在工作线程中分块上传文件，任务对象不随控件销毁，提交完成后自行释放
+    printJob = new DPrintJobSubmitter;
+    QObject::connect(printJob, &DPrintJobSubmitter::progressChanged, q, &DPrintPreviewWidget::printProgressChanged);
+    QObject::connect(printJob, &DPrintJobSubmitter::finished, q, [q](bool success, const QString &errorString) {
+        if (!success)
+            qWarning() << "Print by cups failed:" << errorString;
+        Q_EMIT q->printFinished(success);
+    });
+    QObject::connect(printJob, &DPrintJobSubmitter::finished, printJob, &QObject::deleteLater);
 
-    cupsPrintFile(printerName.toLocal8Bit().constData(), printFromPath.toLocal8Bit().constData(),
-                  previewPrinter->docName().toLocal8Bit().constData(), numOptions, optPtr);
+    printJob->submit(previewPrinter->printerName(), printFromPath, previewPrinter->docName(), printerOptions());
 }
 
 void DPrintPreviewWidgetPrivate::generatePreviewPicture()
@@ -2054,6 +2036,20 @@ void DPrintPreviewWidget::print(bool isSavedPicture)
     }
 }
 
+/*!
+  \brief 取消正在提交的按路径打印任务.
+
+  通过 setPrintFromPath 打印时文件在后台线程中分块上传到 cups, 上传过程中通过 printProgressChanged
+  通知进度, 结束后发送 printFinished.
+ */
+void DPrintPreviewWidget::cancelPrint()
+{
+    Q_D(DPrintPreviewWidget);
+
+    if (d->printJob)
+        d->printJob->cancel();
+}
+
 void DPrintPreviewWidget::themeTypeChanged(DGuiApplicationHelper::ColorType themeType)
 {
     Q_D(DPrintPreviewWidget);
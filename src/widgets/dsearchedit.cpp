@@ -42,6 +42,7 @@ DGUI_USE_NAMESPACE
 
 constexpr int ANI_DURATION = 200;
 constexpr int HIDE_CURSOR_MARGIN = -4;
+constexpr int DEFAULT_SEARCH_DELAY = 300;
 
 #ifdef ENABLE_AI
 class VoiceDevice : public QIODevice
@@ -269,6 +270,44 @@ QString DSearchEdit::placeholderText() const
     return d_func()->placeholderText;
 }
 
+/*!
+@~english
+  @brief set the delay before searchRequested is emitted
+  @param[in] msec is the time in milliseconds the text must stay unchanged
+
+  Each change of the text restarts the delay, so queries for text that has
+  already been replaced are never requested. The default delay is 300 ms.
+  @sa searchRequested()
+ */
+void DSearchEdit::setSearchDelay(int msec)
+{
+    D_D(DSearchEdit);
+
+    d->searchTimer->setInterval(qMax(0, msec));
+}
+
+/*!
+@~english
+  @brief return the delay before searchRequested is emitted
+  @return delay in milliseconds
+ */
+int DSearchEdit::searchDelay() const
+{
+    D_DC(DSearchEdit);
+
+    return d->searchTimer->interval();
+}
+
+/*!
+@~english
+  @fn void DSearchEdit::searchRequested(const QString &text)
+  @brief emitted when \a text should be searched
+
+  The signal is emitted once the text has stayed unchanged for searchDelay()
+  milliseconds and differs from the last requested text. Pressing Return
+  requests the current text immediately.
+ */
+
 DSearchEditPrivate::DSearchEditPrivate(DSearchEdit *q)
     : DLineEditPrivate(q)
     , action(nullptr)
@@ -325,11 +364,40 @@ void DSearchEditPrivate::init()
     label->setAccessibleName("DSearchEditPlaceHolderLabel");
 
     q->connect(q, SIGNAL(focusChanged(bool)), q, SLOT(_q_toEditMode(bool)));
-    q->connect(q, &DLineEdit::textChanged, q, [ = ](QString text) {
+    q->connect(q, &DLineEdit::textChanged, q, [this](const QString &text) {
         if (!text.isEmpty())
             _q_toEditMode(false);
+
+        // 每次输入都重新计时，被后续输入替换的文本不再请求搜索
+        searchTimer->start();
+    });
+
+    searchTimer = new QTimer(q);
+    searchTimer->setSingleShot(true);
+    searchTimer->setInterval(DEFAULT_SEARCH_DELAY);
+    q->connect(searchTimer, &QTimer::timeout, q, [this] {
+        requestSearch(false);
+    });
+    q->connect(q, &DLineEdit::returnPressed, q, [this] {
+        requestSearch(true);
     });
 
+    if (animation) {
+        // 只连接一次，动画结束时恢复动画开始前的文本边距
+        q->connect(animation, &QPropertyAnimation::finished, q, [q, this]() {
+            q->lineEdit()->setTextMargins(textMarginsBeforeAnimation);
+            if (animation->direction() == QPropertyAnimation::Direction::Forward) {
+                iconWidget->setVisible(false);
+                action->defaultWidget()->setVisible(true);
+                lineEdit->setPlaceholderText(placeholderText);
+            } else {
+                iconWidget->setVisible(true);
+                lineEdit->setPlaceholderText(QString());
+                iconWidget->move(QPoint(q->lineEdit()->geometry().center().x() - iconWidget->width() / 2, iconWidget->pos().y()));
+            }
+        });
+    }
+
     QHBoxLayout *layout = new QHBoxLayout(q->lineEdit());
 
     iconWidget = new QWidget;
@@ -398,7 +466,10 @@ void DSearchEditPrivate::_q_toEditMode(bool focus)
         if (animation->state() == QPropertyAnimation::Running)
             return;
 
-        auto textMargins = q->lineEdit()->textMargins();
+        // 有文本时保持编辑状态，输入过程中不做任何处理
+        if (!q->lineEdit()->text().isEmpty())
+            return;
+
         QMargins marginsInAnimation(HIDE_CURSOR_MARGIN, 0, 0, 0);
 
         if (!animation->parent())
@@ -408,22 +479,6 @@ void DSearchEditPrivate::_q_toEditMode(bool focus)
         animation->setStartValue(QPoint(q->lineEdit()->geometry().center().x() - iconWidget->width() / 2, iconWidget->pos().y()));
         animation->setEndValue(QPoint(10, iconWidget->pos().y()));
 
-        q->connect(animation, &QPropertyAnimation::finished, q, [q, this, textMargins]() {
-            q->lineEdit()->setTextMargins(textMargins);
-            if (animation->direction() == QPropertyAnimation::Direction::Forward) {
-                iconWidget->setVisible(false);
-                action->defaultWidget()->setVisible(true);
-                lineEdit->setPlaceholderText(placeholderText);
-            } else {
-                iconWidget->setVisible(true);
-                lineEdit->setPlaceholderText(QString());
-                iconWidget->move(QPoint(q->lineEdit()->geometry().center().x() - iconWidget->width() / 2, iconWidget->pos().y()));
-            }
-        });
-
-        if (!q->lineEdit()->text().isEmpty())
-            return;
-
         if (focus) {
             animation->setDirection(QPropertyAnimation::Direction::Forward);
         } else {
@@ -432,6 +487,7 @@ void DSearchEditPrivate::_q_toEditMode(bool focus)
         }
 
         iconWidget->setVisible(true);
+        textMarginsBeforeAnimation = q->lineEdit()->textMargins();
         q->lineEdit()->setTextMargins(marginsInAnimation);
         animation->start();
     } else {
@@ -457,6 +513,20 @@ void DSearchEditPrivate::_q_toEditMode(bool focus)
 
 }
 
+void DSearchEditPrivate::requestSearch(bool force)
+{
+    D_Q(DSearchEdit);
+
+    searchTimer->stop();
+
+    const QString &text = q->text();
+    if (!force && text == lastSearchText)
+        return;
+
+    lastSearchText = text;
+    Q_EMIT q->searchRequested(text);
+}
+
 void DSearchEditPrivate::_q_onVoiceActionTrigger(bool checked)
 {
 #if (!defined DTK_NO_MULTIMEDIA) && (defined ENABLE_AI)
@@ -5,6 +5,7 @@
 #include "dsettingswidgetfactory.h"
 
 #include <QDebug>
+#include <QHash>
 #include <QMap>
 #include <QFrame>
 #include <QLabel>
@@ -55,12 +56,83 @@ private:
     DTK_CORE_NAMESPACE::DSettingsOption *m_poption = nullptr;
 };
 
-static QMap<QString, KeySequenceEdit *> shortcutMap;
+// 快捷键与编辑控件的双向索引，每个 DSettingsWidgetFactory 对象各自维护一份
+class ShortcutIndex
+{
+public:
+    explicit ShortcutIndex(QObject *context)
+        : context(context)
+    {
+    }
+
+    KeySequenceEdit *edit(const QString &sequence) const
+    {
+        return editBySequence.value(sequence);
+    }
+
+    KeySequenceEdit *editForOption(const QString &key) const
+    {
+        return editByOption.value(key);
+    }
+
+    QString sequence(KeySequenceEdit *edit) const
+    {
+        return sequenceByEdit.value(edit);
+    }
+
+    const QHash<QString, KeySequenceEdit *> &bindings() const
+    {
+        return editBySequence;
+    }
+
+    void addEdit(KeySequenceEdit *edit)
+    {
+        const QString key = edit->option()->key();
+        editByOption.insert(key, edit);
+        QObject::connect(edit, &QObject::destroyed, context, [this, edit, key] {
+            unbind(edit);
+            if (editByOption.value(key) == edit)
+                editByOption.remove(key);
+        });
+    }
+
+    // 绑定后 sequence 只对应 edit，原先占用该快捷键的控件失去绑定
+    void bind(const QString &sequence, KeySequenceEdit *edit)
+    {
+        unbind(edit);
+        if (sequence.isEmpty())
+            return;
+
+        if (KeySequenceEdit *old = editBySequence.value(sequence))
+            sequenceByEdit.remove(old);
+        editBySequence.insert(sequence, edit);
+        sequenceByEdit.insert(edit, sequence);
+    }
+
+    void unbind(KeySequenceEdit *edit)
+    {
+        auto it = sequenceByEdit.find(edit);
+        if (it == sequenceByEdit.end())
+            return;
+
+        auto sequence = editBySequence.find(it.value());
+        if (sequence != editBySequence.end() && sequence.value() == edit)
+            editBySequence.erase(sequence);
+        sequenceByEdit.erase(it);
+    }
+
+private:
+    QObject *context;
+    QHash<QString, KeySequenceEdit *> editBySequence;
+    QHash<KeySequenceEdit *, QString> sequenceByEdit;
+    QHash<QString, KeySequenceEdit *> editByOption;
+};
 
 class ChangeDDialog : public DDialog
 {
 public:
-    ChangeDDialog(QString key, KeySequenceEdit *edit, QString text = QString())
+    ChangeDDialog(ShortcutIndex *shortcuts, QString key, KeySequenceEdit *edit, QString text = QString())
+        : shortcuts(shortcuts)
     {
         QPushButton *cancel = new QPushButton(qApp->translate("DSettingsDialog", "Cancel"));
         DSuggestButton *replace = new DSuggestButton(qApp->translate("DSettingsDialog", "Replace"));
@@ -73,9 +145,9 @@ public:
         insertButton(0, cancel);
         insertButton(1, replace);
         connect(replace, &DSuggestButton::clicked, [ = ] {  //替换
-            auto value = shortcutMap.value(key);
+            auto value = this->shortcuts->edit(key);
+            this->shortcuts->unbind(value);
             value->option()->setValue(SHORTCUT_VALUE);
-            shortcutMap.remove(key);
 
             edit->option()->setValue(key);
         });
@@ -92,12 +164,14 @@ public:
 private:
     void cancelSettings(KeySequenceEdit *edit)
     {
-        if (shortcutMap.key(edit).isEmpty()) {  //第一次被设置
+        if (shortcuts->sequence(edit).isEmpty()) {  //第一次被设置
             edit->clear();
         } else {
             edit->setKeySequence(edit->option()->value().toString());
         }
     }
+
+    ShortcutIndex *shortcuts;
 };
 
 /*!
@@ -186,20 +260,15 @@ QPair<QWidget *, QWidget *> DSettingsWidgetFactory::createStandardItem(const QBy
     return qMakePair(new QLabel(label), rightWidget);
 }
 
-QPair<QWidget *, QWidget *> createShortcutEditOptionHandle(DSettingsWidgetFactoryPrivate *p, QObject *opt)
+QPair<QWidget *, QWidget *> createShortcutEditOptionHandle(ShortcutIndex *shortcuts, QObject *opt)
 {
-    static DSettingsWidgetFactoryPrivate *pFlg = nullptr;
-    if (pFlg != p) {
-        shortcutMap.clear();
-        pFlg = p;
-    }
-
     auto option = qobject_cast<DTK_CORE_NAMESPACE::DSettingsOption *>(opt);
     auto rightWidget = new KeySequenceEdit(option);
 
     rightWidget->setObjectName("OptionShortcutEdit");
     rightWidget->setAccessibleName("OptionShortcutEdit");
     rightWidget->ShortcutDirection(Qt::AlignLeft);
+    shortcuts->addEdit(rightWidget);
 
     auto optionValue = option->value();
     auto translateContext = opt->property(PRIVATE_PROPERTY_translateContext).toByteArray();
@@ -207,16 +276,16 @@ QPair<QWidget *, QWidget *> createShortcutEditOptionHandle(DSettingsWidgetFactor
     option->connect(rightWidget, &KeySequenceEdit::editingFinished, [ = ](const QKeySequence & sequence) {
 
         QString keyseq = sequence.toString();
-        if (shortcutMap.value(sequence.toString()) == rightWidget) //键位于自己相同
+        KeySequenceEdit *owner = shortcuts->edit(keyseq);
+        if (owner == rightWidget) //键位于自己相同
             return;
 
-        if (shortcutMap.value(keyseq)) {
-            ChangeDDialog frame(keyseq, rightWidget, rightWidget->text());
+        if (owner) {
+            ChangeDDialog frame(shortcuts, keyseq, rightWidget, rightWidget->text());
             frame.setAccessibleName("ChangeDDialog");
             frame.exec();
         } else {
-            shortcutMap.remove(shortcutMap.key(rightWidget));
-            shortcutMap.insert(keyseq, rightWidget);
+            shortcuts->bind(keyseq, rightWidget);
             option->setValue(keyseq);
         }
     });
@@ -225,12 +294,12 @@ QPair<QWidget *, QWidget *> createShortcutEditOptionHandle(DSettingsWidgetFactor
         QKeySequence sequence(optionValue.toString());
         QString keyseq = sequence.toString();
 
-        if (shortcutMap.value(keyseq)) {
+        if (shortcuts->edit(keyseq)) {
             return;
         }
 
         if (rightWidget->setKeySequence(sequence)) {
-            shortcutMap.insert(keyseq, rightWidget);
+            shortcuts->bind(keyseq, rightWidget);
             opt->setValue(keyseq);
         }
     };
@@ -239,17 +308,22 @@ QPair<QWidget *, QWidget *> createShortcutEditOptionHandle(DSettingsWidgetFactor
     option->connect(option, &DTK_CORE_NAMESPACE::DSettingsOption::valueChanged, rightWidget, [ = ](const QVariant & value) {
 
         if (value.toString() == SHORTCUT_VALUE) {
+            shortcuts->unbind(rightWidget);
             rightWidget->clear();
             return;
         }
         QKeySequence sequence(value.toString());
         QString keyseq = sequence.toString();
 
-        shortcutMap.remove(shortcutMap.key(rightWidget));
+        // 规范化后的值写回时会再次触发 valueChanged，已经绑定的快捷键不需要重新设置
+        if (!keyseq.isEmpty() && shortcuts->sequence(rightWidget) == keyseq)
+            return;
+
+        shortcuts->unbind(rightWidget);
 
         if (rightWidget->setKeySequence(sequence)) {    //设置快捷键
 
-            shortcutMap.insert(keyseq, rightWidget);
+            shortcuts->bind(keyseq, rightWidget);
             option->setValue(keyseq);
         }
     });
@@ -618,12 +692,14 @@ QWidget *createUnsupportHandle(QObject *opt)
 class DSettingsWidgetFactoryPrivate
 {
 public:
-    DSettingsWidgetFactoryPrivate(DSettingsWidgetFactory *parent) : q_ptr(parent)
+    DSettingsWidgetFactoryPrivate(DSettingsWidgetFactory *parent)
+        : shortcuts(parent)
+        , q_ptr(parent)
     {
         itemCreateHandles.insert("checkbox", createCheckboxOptionHandle);
         itemCreateHandles.insert("lineedit", createLineEditOptionHandle);
         itemCreateHandles.insert("combobox", createComboBoxOptionHandle);
-        itemCreateHandles.insert("shortcut", std::bind(createShortcutEditOptionHandle, this, std::placeholders::_1));
+        itemCreateHandles.insert("shortcut", std::bind(createShortcutEditOptionHandle, &shortcuts, std::placeholders::_1));
         itemCreateHandles.insert("spinbutton", createSpinButtonOptionHandle);
         itemCreateHandles.insert("buttongroup", createButtonGroupOptionHandle);
         itemCreateHandles.insert("radiogroup", createRadioGroupOptionHandle);
@@ -635,6 +711,7 @@ public:
 
     QMap<QString, std::function<DSettingsWidgetFactory::WidgetCreateHandler> > widgetCreateHandles;
     QMap<QString, std::function<DSettingsWidgetFactory::ItemCreateHandler> > itemCreateHandles;
+    ShortcutIndex shortcuts;
 
     DSettingsWidgetFactory *q_ptr;
     Q_DECLARE_PUBLIC(DSettingsWidgetFactory)
@@ -719,4 +796,65 @@ QPair<QWidget *, QWidget *> DSettingsWidgetFactory::createItem(const QByteArray
     return qMakePair(nullptr, nullptr);
 }
 
+/*!
+  \brief DSettingsWidgetFactory::importShortcuts 批量设置由该对象创建的快捷键配置项.
+
+  先在一次遍历中检查所有快捷键的冲突，再依次修改配置项的值。与未修改的配置项或者 keymap 中
+  排在前面的配置项冲突的快捷键不会被设置，该配置项保留原有的快捷键，原有的快捷键被其他配置项
+  占用时清除. 空字符串表示清除该配置项的快捷键.
+
+  \a keymap 配置项的 key 到快捷键文本的映射
+  \return 未能设置的配置项的 key，包括冲突的快捷键和未通过该对象创建控件的配置项
+ */
+QStringList DSettingsWidgetFactory::importShortcuts(const QMap<QString, QString> &keymap)
+{
+    Q_D(DSettingsWidgetFactory);
+
+    QStringList rejected;
+    QList<KeySequenceEdit *> conflicts;
+    QList<QPair<KeySequenceEdit *, QString>> changes;
+    changes.reserve(keymap.size());
+
+    // 导入后的快捷键占用情况，先移除所有将被修改的配置项原有的快捷键
+    QHash<QString, KeySequenceEdit *> bindings = d->shortcuts.bindings();
+    for (auto it = keymap.constBegin(); it != keymap.constEnd(); ++it) {
+        if (KeySequenceEdit *edit = d->shortcuts.editForOption(it.key()))
+            bindings.remove(d->shortcuts.sequence(edit));
+    }
+
+    for (auto it = keymap.constBegin(); it != keymap.constEnd(); ++it) {
+        KeySequenceEdit *edit = d->shortcuts.editForOption(it.key());
+        if (!edit) {
+            rejected << it.key();
+            continue;
+        }
+
+        const QString keyseq = QKeySequence(it.value()).toString();
+        if (keyseq.isEmpty()) {
+            changes << qMakePair(edit, QString(SHORTCUT_VALUE));
+            continue;
+        }
+
+        if (bindings.contains(keyseq)) {
+            rejected << it.key();
+            conflicts << edit;
+            continue;
+        }
+
+        bindings.insert(keyseq, edit);
+        changes << qMakePair(edit, keyseq);
+    }
+
+    for (KeySequenceEdit *edit : conflicts) {
+        const QString keyseq = d->shortcuts.sequence(edit);
+        if (!keyseq.isEmpty() && bindings.contains(keyseq))
+            changes << qMakePair(edit, QString(SHORTCUT_VALUE));
+    }
+
+    for (const auto &change : changes)
+        change.first->option()->setValue(change.second);
+
+    return rejected;
+}
+
 DWIDGET_END_NAMESPACE
@@ -32,6 +32,13 @@ public:
     int getTopRenderOffset();
     void sortItemsByColumn(int column, bool descendingSort);
 
+    QRect rowRect(int row) const;
+    void updateItem(DSimpleListItem *item);
+    void updateScrollbar();
+    void scrollContents(int oldRenderOffset);
+    void invalidateContents();
+    void updateContentCache(const QRegion &paintRegion, const QList<int> &renderWidths);
+
     QPointer<DSimpleListItem> lastHoverItem = nullptr;
     QPointer<DSimpleListItem> lastSelectItem = nullptr;
     QPointer<DSimpleListItem> drawHoverItem = nullptr;
@@ -73,6 +80,15 @@ public:
     int titlePadding = 0;
     int titlePressColumn = 0;
 
+    // 已绘制的行内容，滚动时移动缓存，只绘制新露出的行
+    QPixmap contentCache;
+    bool contentCacheValid = false;
+    int contentCacheOffset = 0;
+    // 需要重新绘制的行，纵坐标相对于列表顶部，滚动后仍然有效
+    QRegion contentDirty;
+    // 行内容没有变化、只需要从缓存中重新合成的重绘区域（滚动和滚动条状态变化）
+    QRegion cachedRegion;
+
     D_DECLARE_PUBLIC(DSimpleListView)
 };
 
@@ -319,7 +335,7 @@ void DSimpleListView::addItems(QList<DSimpleListItem*> items)
     }
 
     // Repaint after add items.
-    repaint();
+    d->invalidateContents();
 }
 
 /*!
@@ -338,7 +354,7 @@ void DSimpleListView::removeItem(DSimpleListItem* item)
         d->renderOffset = adjustRenderOffset(d->renderOffset - d->rowHeight);
     }
 
-    repaint();
+    d->invalidateContents();
 }
 
 /*!
@@ -466,7 +482,7 @@ void DSimpleListView::refreshItems(QList<DSimpleListItem*> items)
     d->renderOffset = adjustRenderOffset(d->renderOffset);
 
     // Render.
-    repaint();
+    d->invalidateContents();
 }
 
 /*!
@@ -491,7 +507,7 @@ void DSimpleListView::search(QString content)
         d->renderItems->append(searchItems);
     }
 
-    repaint();
+    d->invalidateContents();
 }
 
 /*!
@@ -537,7 +553,7 @@ void DSimpleListView::selectAllItems()
         d->renderOffset = d->getTopRenderOffset();
 
         // Repaint.
-        repaint();
+        d->invalidateContents();
     }
 
 }
@@ -563,7 +579,7 @@ void DSimpleListView::selectFirstItem()
     d->renderOffset = d->getTopRenderOffset();
 
     // Repaint.
-    repaint();
+    d->invalidateContents();
 }
 
 /*!
@@ -587,7 +603,7 @@ void DSimpleListView::selectLastItem()
     d->renderOffset = getBottomRenderOffset();
 
     // Repaint.
-    repaint();
+    d->invalidateContents();
 }
 
 /*!
@@ -652,7 +668,7 @@ void DSimpleListView::shiftSelectToEnd()
             d->renderOffset = getBottomRenderOffset();
 
             // Repaint.
-            repaint();
+            d->invalidateContents();
         }
     }
 
@@ -680,7 +696,7 @@ void DSimpleListView::shiftSelectToHome()
             d->renderOffset = d->getTopRenderOffset();
 
             // Repaint.
-            repaint();
+            d->invalidateContents();
         }
     }
 
@@ -734,42 +750,47 @@ void DSimpleListView::ctrlScrollPageUp()
 {
     D_D(DSimpleListView);
 
+    const int oldRenderOffset = d->renderOffset;
     d->renderOffset = adjustRenderOffset(d->renderOffset - getScrollAreaHeight());
 
-    repaint();
+    d->scrollContents(oldRenderOffset);
 }
 
 void DSimpleListView::ctrlScrollPageDown()
 {
     D_D(DSimpleListView);
 
+    const int oldRenderOffset = d->renderOffset;
     d->renderOffset = adjustRenderOffset(d->renderOffset + getScrollAreaHeight());
 
-    repaint();
+    d->scrollContents(oldRenderOffset);
 }
 
 void DSimpleListView::ctrlScrollToHome()
 {
     D_D(DSimpleListView);
 
+    const int oldRenderOffset = d->renderOffset;
     d->renderOffset = d->getTopRenderOffset();
 
-    repaint();
+    d->scrollContents(oldRenderOffset);
 }
 
 void DSimpleListView::ctrlScrollToEnd()
 {
     D_D(DSimpleListView);
 
+    const int oldRenderOffset = d->renderOffset;
     d->renderOffset = getBottomRenderOffset();
 
-    repaint();
+    d->scrollContents(oldRenderOffset);
 }
 
 void DSimpleListView::leaveEvent(QEvent * event)
 {
     D_D(DSimpleListView);
 
+    d->updateItem(d->drawHoverItem);
     d->lastHoverItem.clear();
     d->drawHoverItem.clear();
     d->mouseHoverItem.clear();
@@ -787,7 +808,7 @@ void DSimpleListView::hideScrollbar()
     d->mouseAtScrollArea = false;
     d->oldRenderOffset = d->renderOffset;
 
-    repaint();
+    d->updateScrollbar();
 }
 
 bool DSimpleListView::eventFilter(QObject *, QEvent *)
@@ -855,12 +876,13 @@ void DSimpleListView::mouseMoveEvent(QMouseEvent *mouseEvent)
     // Scroll if mouse drag at scrollbar.
     if (d->mouseDragScrollbar) {
         int barHeight = getScrollbarHeight();
+        const int oldRenderOffset = d->renderOffset;
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
         d->renderOffset = adjustRenderOffset((mouseEvent->y() - barHeight / 2 - d->titleHeight) / (getScrollAreaHeight() * 1.0) * d->getItemsTotalHeight());
 #else
         d->renderOffset = adjustRenderOffset((mouseEvent->position().y() - barHeight / 2 - d->titleHeight) / (getScrollAreaHeight() * 1.0) * d->getItemsTotalHeight());
 #endif
-        repaint();
+        d->scrollContents(oldRenderOffset);
     }
     // Update scrollbar status with mouse position.
 #if QT_VERSION < QT_VERSION_CHECK(6,0,0)
@@ -870,7 +892,7 @@ void DSimpleListView::mouseMoveEvent(QMouseEvent *mouseEvent)
     else if (isMouseAtScrollArea(mouseEvent->position().x()) != d->mouseAtScrollArea) {
         d->mouseAtScrollArea = isMouseAtScrollArea(mouseEvent->position().x());
 #endif
-        repaint();
+        d->updateScrollbar();
     }
     // Otherwise to check titlebar arrow status.
     else {
@@ -912,7 +934,7 @@ void DSimpleListView::mouseMoveEvent(QMouseEvent *mouseEvent)
             if (hoverColumn != d->titleHoverColumn) {
                 d->titleHoverColumn = hoverColumn;
 
-                repaint();
+                update(0, 0, width(), d->titleHeight);
             }
         } else {
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
@@ -946,9 +968,10 @@ void DSimpleListView::mouseMoveEvent(QMouseEvent *mouseEvent)
                 }
 
                 if (d->drawHoverItem == NULL || !item->sameAs(d->drawHoverItem)) {
+                    // 只重绘悬停状态变化的两行
+                    d->updateItem(d->drawHoverItem);
                     d->drawHoverItem = item;
-
-                    repaint();
+                    d->updateItem(item);
                 }
 
                 // Emit mouseHoverChanged signal.
@@ -1023,7 +1046,7 @@ void DSimpleListView::mousePressEvent(QMouseEvent *mouseEvent)
                                 d->titlePressColumn = columnCounter;
                             }
 
-                            repaint();
+                            d->invalidateContents();
                             break;
                         }
 
@@ -1053,7 +1076,7 @@ void DSimpleListView::mousePressEvent(QMouseEvent *mouseEvent)
 
                            changeColumnVisible(i, columnVisibles[i], columnVisibles);
 
-                           repaint();
+                           d_func()->invalidateContents();
                        });
 
                         menu->addAction(action);
@@ -1080,8 +1103,9 @@ void DSimpleListView::mousePressEvent(QMouseEvent *mouseEvent)
         }
         // Scroll if click out of scrollbar area.
         else {
+            const int oldRenderOffset = d->renderOffset;
             d->renderOffset = adjustRenderOffset((my - barHeight / 2 - d->titleHeight) / (getScrollAreaHeight() * 1.0) * d->getItemsTotalHeight());
-            repaint();
+            d->scrollContents(oldRenderOffset);
         }
     }
     // Select items.
@@ -1097,7 +1121,7 @@ void DSimpleListView::mousePressEvent(QMouseEvent *mouseEvent)
                 clearSelections();
             }
 
-            repaint();
+            d->invalidateContents();
         } else {
             if (mouseEvent->button() == Qt::LeftButton) {
                 if (pressItemIndex < d->renderItems->count()) {
@@ -1158,7 +1182,7 @@ void DSimpleListView::mousePressEvent(QMouseEvent *mouseEvent)
 #endif
                     mousePressChanged((*d->renderItems)[pressItemIndex], columnCounter, point);
 
-                    repaint();
+                    d->invalidateContents();
                 }
             } else if (mouseEvent->button() == Qt::RightButton) {
                 DSimpleListItem *pressItem = (*d->renderItems)[pressItemIndex];
@@ -1179,7 +1203,7 @@ void DSimpleListView::mousePressEvent(QMouseEvent *mouseEvent)
                     items << (*d->renderItems)[pressItemIndex];
                     addSelections(items);
 
-                    repaint();
+                    d->invalidateContents();
                 }
 
                 if (d->selectionItems->length() > 0) {
@@ -1198,11 +1222,11 @@ void DSimpleListView::mouseReleaseEvent(QMouseEvent *mouseEvent)
         // Reset mouseDragScrollbar.
         d->mouseDragScrollbar = false;
 
-        repaint();
+        d->updateScrollbar();
     } else {
         if (d->titlePressColumn != -1) {
             d->titlePressColumn = -1;
-            repaint();
+            update(0, 0, width(), d->titleHeight);
         }
     }
 
@@ -1255,13 +1279,13 @@ void DSimpleListView::wheelEvent(QWheelEvent *event)
         qreal scrollStep = delta.y() / 120.0;
         d->renderOffset = adjustRenderOffset(d->renderOffset - scrollStep * d->scrollUnit);
 
-        repaint();
+        d->scrollContents(d->oldRenderOffset);
     }
 
     event->accept();
 }
 
-void DSimpleListView::paintEvent(QPaintEvent *)
+void DSimpleListView::paintEvent(QPaintEvent *event)
 {
     D_D(DSimpleListView);
 
@@ -1288,8 +1312,6 @@ void DSimpleListView::paintEvent(QPaintEvent *)
         painter.fillPath(titlePath, QColor(titleAreaColor));
     }
 
-    int renderY = 0;
-    int renderHeight = 0;
     if (d->titleHeight > 0) {
         int columnCounter = 0;
         int columnRenderX = 0;
@@ -1340,9 +1362,6 @@ void DSimpleListView::paintEvent(QPaintEvent *)
             }
             columnCounter++;
         }
-
-        renderY += d->titleHeight;
-        renderHeight += d->titleHeight;
     }
 
     // Draw background.
@@ -1355,52 +1374,12 @@ void DSimpleListView::paintEvent(QPaintEvent *)
     QPainterPath scrollAreaPath;
     scrollAreaPath.addRect(QRectF(rect().x(), rect().y() + d->titleHeight, rect().width(), getScrollAreaHeight()));
 
-    int rowCounter = 0;
-    for (DSimpleListItem *item:*d->renderItems) {
-        if (rowCounter >= d->renderOffset / d->rowHeight) {
-            // Clip item rect.
-            QPainterPath itemPath;
-            itemPath.addRect(QRect(0, renderY + rowCounter * d->rowHeight - d->renderOffset, rect().width(), d->rowHeight));
-            painter.setClipPath((framePath.intersected(scrollAreaPath)).intersected(itemPath));
-
-            // Draw item backround.
-            bool isSelect = d->selectionItems->contains(item);
-            bool isHover = d->drawHoverItem != NULL && item->sameAs(d->drawHoverItem);
-            painter.save();
-            item->drawBackground(QRect(0, renderY + rowCounter * d->rowHeight - d->renderOffset, rect().width(), d->rowHeight),
-                                 &painter,
-                                 rowCounter,
-                                 isSelect,
-                                 isHover);
-            painter.restore();
-
-            // Draw item foreground.
-            int columnCounter = 0;
-            int columnRenderX = 0;
-            for (int renderWidth:renderWidths) {
-                if (renderWidth > 0) {
-                    painter.save();
-                    item->drawForeground(QRect(columnRenderX, renderY + rowCounter * d->rowHeight - d->renderOffset, renderWidth, d->rowHeight),
-                                         &painter,
-                                         columnCounter,
-                                         rowCounter,
-                                         isSelect,
-                                         isHover);
-                    painter.restore();
-
-                    columnRenderX += renderWidth;
-                }
-                columnCounter++;
-            }
-
-            renderHeight += d->rowHeight;
-
-            if (renderHeight > rect().height()) {
-                break;
-            }
-        }
-
-        rowCounter++;
+    // 行内容绘制在缓存中，滚动时只绘制新露出的行，再与半透明的背景和边框合成
+    d->updateContentCache(event->region(), renderWidths);
+    if (!d->contentCache.isNull()) {
+        painter.setClipPath(framePath.intersected(scrollAreaPath));
+        painter.setOpacity(1);
+        painter.drawPixmap(0, d->titleHeight, d->contentCache);
     }
 
     // Keep clip area.
@@ -1520,7 +1499,7 @@ void DSimpleListView::selectNextItemWithOffset(int scrollOffset)
                 d->renderOffset = itemOffset;
             }
 
-            repaint();
+            d->invalidateContents();
         }
     }
 }
@@ -1559,7 +1538,7 @@ void DSimpleListView::selectPrevItemWithOffset(int scrollOffset)
                 d->renderOffset = itemOffset;
             }
 
-            repaint();
+            d->invalidateContents();
         }
     }
 }
@@ -1628,7 +1607,7 @@ void DSimpleListView::shiftSelectPrevItemWithOffset(int scrollOffset)
                 d->renderOffset = adjustRenderOffset((selectionStartIndex - 1) * d->rowHeight + d->titleHeight);
             }
 
-            repaint();
+            d->invalidateContents();
         }
     }
 }
@@ -1676,7 +1655,7 @@ void DSimpleListView::shiftSelectNextItemWithOffset(int scrollOffset)
             }
 
 
-            repaint();
+            d->invalidateContents();
         }
     }
 }
@@ -1820,16 +1799,188 @@ void DSimpleListViewPrivate::sortItemsByColumn(int column, bool descendingSort)
     }
 }
 
+QRect DSimpleListViewPrivate::rowRect(int row) const
+{
+    D_QC(DSimpleListView);
+
+    return QRect(0, titleHeight + row * rowHeight - renderOffset, q->width(), rowHeight);
+}
+
+void DSimpleListViewPrivate::updateItem(DSimpleListItem *item)
+{
+    D_Q(DSimpleListView);
+
+    if (!item || rowHeight <= 0)
+        return;
+
+    // 只需要在可见的行中查找
+    const int firstRow = renderOffset / rowHeight;
+    const int lastRow = qMin(renderItems->count() - 1, (renderOffset + q->getScrollAreaHeight()) / rowHeight);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        if ((*renderItems)[row]->sameAs(item)) {
+            contentDirty += QRect(0, row * rowHeight, q->width(), rowHeight);
+            q->update(rowRect(row));
+            return;
+        }
+    }
+}
+
+void DSimpleListViewPrivate::updateScrollbar()
+{
+    D_Q(DSimpleListView);
+
+    // 包含滚动条描边和抗锯齿的宽度
+    const int barAreaWidth = scrollbarDragWidth + scrollbarPadding + 2;
+    const QRect barArea(q->width() - barAreaWidth, 0, barAreaWidth, q->height());
+    cachedRegion += barArea;
+    q->update(barArea);
+}
+
+void DSimpleListViewPrivate::scrollContents(int oldRenderOffset)
+{
+    D_Q(DSimpleListView);
+
+    if (oldRenderOffset == renderOffset) {
+        updateScrollbar();
+        return;
+    }
+
+    // 背景半透明时 QWidget::scroll() 会退化为整体重绘，这里只请求重新合成，
+    // 绘制时移动行内容缓存，只有新露出的行需要绘制
+    const QRect scrollArea(0, titleHeight, q->width(), q->getScrollAreaHeight());
+    cachedRegion += scrollArea;
+    q->update(scrollArea);
+}
+
+void DSimpleListViewPrivate::invalidateContents()
+{
+    D_Q(DSimpleListView);
+
+    contentCacheValid = false;
+    q->update();
+}
+
+void DSimpleListViewPrivate::updateContentCache(const QRegion &paintRegion, const QList<int> &renderWidths)
+{
+    D_Q(DSimpleListView);
+
+    const QRect cacheRect(0, 0, q->width(), q->getScrollAreaHeight());
+    const QRegion cached = cachedRegion;
+    cachedRegion = QRegion();
+    if (cacheRect.isEmpty() || rowHeight <= 0) {
+        contentDirty = QRegion();
+        return;
+    }
+
+    const qreal ratio = q->devicePixelRatioF();
+    const QSize pixelSize = cacheRect.size() * ratio;
+    if (contentCache.size() != pixelSize || !qFuzzyCompare(contentCache.devicePixelRatio(), ratio)) {
+        contentCache = QPixmap(pixelSize);
+        contentCache.setDevicePixelRatio(ratio);
+        contentCacheValid = false;
+    }
+
+    // 需要绘制的区域，坐标相对于缓存
+    QRegion dirty;
+    if (!contentCacheValid) {
+        dirty = cacheRect;
+    } else {
+        const int dy = contentCacheOffset - renderOffset;
+        const qreal pixelDy = dy * ratio;
+        if (dy != 0 && qAbs(dy) < cacheRect.height() && qFuzzyIsNull(pixelDy - qRound(pixelDy))) {
+            contentCache.scroll(0, qRound(pixelDy), contentCache.rect());
+            dirty = QRegion(cacheRect) - cacheRect.translated(0, dy);
+        } else if (dy != 0) {
+            dirty = cacheRect;
+        }
+
+        // 其他原因请求的重绘（例如外部调用 update()）不能使用缓存的内容
+        dirty += (paintRegion - cached).translated(0, -titleHeight);
+        dirty += contentDirty.translated(0, -renderOffset);
+    }
+    dirty &= cacheRect;
+
+    contentCacheValid = true;
+    contentCacheOffset = renderOffset;
+    contentDirty = QRegion();
+    if (dirty.isEmpty())
+        return;
+
+    // 按整行重绘
+    QList<int> rows;
+    QRegion clearRegion = dirty;
+    const int firstRow = renderOffset / rowHeight;
+    const int lastRow = qMin(renderItems->count() - 1, (renderOffset + cacheRect.height() - 1) / rowHeight);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        const QRect itemRect(0, row * rowHeight - renderOffset, cacheRect.width(), rowHeight);
+        if (dirty.intersects(itemRect)) {
+            rows << row;
+            clearRegion += itemRect;
+        }
+    }
+
+    QPainter painter(&contentCache);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    for (const QRect &rect : clearRegion & cacheRect)
+        painter.fillRect(rect, Qt::transparent);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+
+    // 与直接绘制在控件上时的画笔状态保持一致：行内容继承标题的字体和颜色，以及背景的透明度
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setFont(q->font());
+    painter.setPen(q->palette().color(q->foregroundRole()));
+    if (titleHeight > 0) {
+        QFont font = painter.font();
+        font.setPointSize(q->titleSize);
+        painter.setFont(font);
+        painter.setPen(QPen(QColor(q->titleColor)));
+    }
+    painter.setOpacity(q->backgroundOpacity);
+
+    for (int row : rows) {
+        DSimpleListItem *item = (*renderItems)[row];
+        const QRect itemRect(0, row * rowHeight - renderOffset, cacheRect.width(), rowHeight);
+        painter.setClipRect(itemRect);
+
+        // Draw item backround.
+        bool isSelect = selectionItems->contains(item);
+        bool isHover = drawHoverItem != NULL && item->sameAs(drawHoverItem);
+        painter.save();
+        item->drawBackground(itemRect, &painter, row, isSelect, isHover);
+        painter.restore();
+
+        // Draw item foreground.
+        int columnCounter = 0;
+        int columnRenderX = 0;
+        for (int renderWidth : renderWidths) {
+            if (renderWidth > 0) {
+                painter.save();
+                item->drawForeground(QRect(columnRenderX, itemRect.y(), renderWidth, rowHeight),
+                                     &painter,
+                                     columnCounter,
+                                     row,
+                                     isSelect,
+                                     isHover);
+                painter.restore();
+
+                columnRenderX += renderWidth;
+            }
+            columnCounter++;
+        }
+    }
+}
+
 void DSimpleListView::startScrollbarHideTimer()
 {
     D_D(DSimpleListView);
 
-    if (d->hideScrollbarTimer != NULL) {
-        d->hideScrollbarTimer->stop();
+    // 滚动时每一帧都会调用，复用同一个定时器
+    if (d->hideScrollbarTimer == NULL) {
+        d->hideScrollbarTimer = new QTimer(this);
+        d->hideScrollbarTimer->setSingleShot(true);
+        connect(d->hideScrollbarTimer, SIGNAL(timeout()), this, SLOT(hideScrollbar()));
     }
 
-    d->hideScrollbarTimer = new QTimer();
-    connect(d->hideScrollbarTimer, SIGNAL(timeout()), this, SLOT(hideScrollbar()));
     d->hideScrollbarTimer->start(d->hideScrollbarDuration);
 }
 
@@ -0,0 +1,229 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dstartuptimeline.h"
+#include "private/dstartuptimeline_p.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+#include <QWindow>
+
+DWIDGET_BEGIN_NAMESPACE
+
+// 没有窗口显示时，延后的任务在这段时间后执行
+static const int DeferredTasksFallbackInterval = 5000;
+
+// 库加载时开始计时，近似为进程启动的时间
+static const QElapsedTimer g_startupTimer = [] {
+    QElapsedTimer timer;
+    timer.start();
+    return timer;
+}();
+
+static DStartupTimeline *g_instance = nullptr;
+
+DStartupTimelinePrivate::DStartupTimelinePrivate(DStartupTimeline *qq)
+    : DObjectPrivate(qq)
+{
+}
+
+qint64 DStartupTimelinePrivate::processElapsed()
+{
+    return g_startupTimer.nsecsElapsed();
+}
+
+void DStartupTimelinePrivate::markFirstFrame()
+{
+    D_Q(DStartupTimeline);
+
+    if (firstFrameNsecs >= 0)
+        return;
+
+    firstFrameNsecs = processElapsed();
+    qApp->removeEventFilter(q);
+    Q_EMIT q->firstFrameShown();
+
+    runDeferredTasks();
+}
+
+void DStartupTimelinePrivate::runDeferredTasks()
+{
+    D_Q(DStartupTimeline);
+
+    if (deferredTasksDone)
+        return;
+
+    deferredTasksDone = true;
+    fallbackTimer->stop();
+    // 托盘、后台等一直不显示窗口的程序不再为每个事件调用过滤器，之后显示的窗口不再记录第一帧
+    qApp->removeEventFilter(q);
+
+    // 每个任务单独排队执行，避免长时间阻塞第一帧之后的输入
+    const auto tasks = deferredTasks;
+    deferredTasks.clear();
+    for (const auto &task : tasks) {
+        if (task.first)
+            QTimer::singleShot(0, task.first.data(), task.second);
+    }
+}
+
+DStartupTimeline::DStartupTimeline(QObject *parent)
+    : QObject(parent)
+    , DObject(*new DStartupTimelinePrivate(this))
+{
+    D_D(DStartupTimeline);
+
+    d->fallbackTimer = new QTimer(this);
+    d->fallbackTimer->setSingleShot(true);
+    d->fallbackTimer->setInterval(DeferredTasksFallbackInterval);
+    connect(d->fallbackTimer, &QTimer::timeout, this, [d] {
+        d->runDeferredTasks();
+    });
+    d->fallbackTimer->start();
+
+    qApp->installEventFilter(this);
+
+    // D_DTK_STARTUP_TIMELINE_DUMP=文件路径 时，程序退出前将启动过程写入该文件
+    const QString dumpFile = qEnvironmentVariable("D_DTK_STARTUP_TIMELINE_DUMP");
+    if (!dumpFile.isEmpty()) {
+        connect(qApp, &QCoreApplication::aboutToQuit, this, [this, dumpFile] {
+            QFile file(dumpFile);
+            if (file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+                file.write(toJson());
+        });
+    }
+}
+
+DStartupTimeline::~DStartupTimeline()
+{
+    if (g_instance == this)
+        g_instance = nullptr;
+}
+
+DStartupTimeline *DStartupTimeline::instance()
+{
+    if (!g_instance)
+        g_instance = new DStartupTimeline(qApp);
+
+    return g_instance;
+}
+
+qint64 DStartupTimeline::elapsed() const
+{
+    return DStartupTimelinePrivate::processElapsed();
+}
+
+void DStartupTimeline::beginPhase(const QString &name)
+{
+    D_D(DStartupTimeline);
+
+    d->runningPhases.insert(name, elapsed());
+}
+
+void DStartupTimeline::endPhase(const QString &name)
+{
+    D_D(DStartupTimeline);
+
+    auto it = d->runningPhases.find(name);
+    if (it == d->runningPhases.end())
+        return;
+
+    const qint64 start = it.value();
+    d->runningPhases.erase(it);
+    // 第一帧之后结束的阶段不影响启动速度
+    addPhase(name, start, elapsed() - start, d->firstFrameNsecs >= 0);
+}
+
+void DStartupTimeline::addPhase(const QString &name, qint64 startNsecs, qint64 durationNsecs, bool deferred)
+{
+    D_D(DStartupTimeline);
+
+    Phase phase;
+    phase.name = name;
+    phase.startNsecs = startNsecs;
+    phase.durationNsecs = durationNsecs;
+    phase.deferred = deferred;
+    d->phases.append(phase);
+}
+
+QList<DStartupTimeline::Phase> DStartupTimeline::phases() const
+{
+    D_DC(DStartupTimeline);
+
+    return d->phases;
+}
+
+bool DStartupTimeline::isFirstFrameShown() const
+{
+    D_DC(DStartupTimeline);
+
+    return d->firstFrameNsecs >= 0;
+}
+
+qint64 DStartupTimeline::firstFrameNsecs() const
+{
+    D_DC(DStartupTimeline);
+
+    return d->firstFrameNsecs;
+}
+
+void DStartupTimeline::callAfterFirstFrame(QObject *context, std::function<void()> function)
+{
+    D_D(DStartupTimeline);
+
+    if (!context)
+        context = this;
+
+    if (d->deferredTasksDone) {
+        QTimer::singleShot(0, context, std::move(function));
+        return;
+    }
+
+    d->deferredTasks.append(qMakePair(QPointer<QObject>(context), std::move(function)));
+}
+
+QByteArray DStartupTimeline::toJson() const
+{
+    D_DC(DStartupTimeline);
+
+    QJsonArray phases;
+    for (const Phase &phase : d->phases) {
+        QJsonObject object;
+        object.insert("name", phase.name);
+        object.insert("startNsecs", double(phase.startNsecs));
+        object.insert("durationNsecs", double(phase.durationNsecs));
+        object.insert("deferred", phase.deferred);
+        phases.append(object);
+    }
+
+    QJsonObject root;
+    root.insert("firstFrameNsecs", double(d->firstFrameNsecs));
+    root.insert("phases", phases);
+
+    return QJsonDocument(root).toJson();
+}
+
+bool DStartupTimeline::eventFilter(QObject *watched, QEvent *event)
+{
+    D_D(DStartupTimeline);
+
+    if (event->type() == QEvent::Expose && !d->firstFramePending && watched->isWindowType()
+            && static_cast<QWindow *>(watched)->isExposed()) {
+        // 窗口在处理 Expose 时同步绘制，回到事件循环时第一帧已经完成
+        d->firstFramePending = true;
+        QTimer::singleShot(0, this, [d] {
+            d->markFirstFrame();
+        });
+    }
+
+    return QObject::eventFilter(watched, event);
+}
+
+DWIDGET_END_NAMESPACE
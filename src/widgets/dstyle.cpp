@@ -9,10 +9,12 @@
 #include "dstyleoption.h"
 #include "dtooltip.h"
 #include "dsizemode.h"
+#include "private/dstyle_p.h"
 
 #include <DGuiApplicationHelper>
 #include <DIconTheme>
 #include <DConfig>
+#include <DPlatformTheme>
 
 #include <QStyleOption>
 #include <QTextLayout>
@@ -22,6 +24,7 @@
 #include <QAbstractItemView>
 #include <QPainterPath>
 #include <QLoggingCategory>
+#include <QPointer>
 
 #include <qmath.h>
 #include <private/qfixed_p.h>
@@ -184,15 +187,30 @@ void DStyle::setLineEditIconMargin(QObject *object, int margin)
 #endif
 }
 
-void DStyle::setShortcutUnderlineVisible(bool visible)
+// 菜单项和助记符标签绘制时会频繁查询下面两个风格策略，缓存从环境变量、程序属性和配置中读取的结果，
+// 在配置变化或程序属性改变后重新读取
+struct PreferenceHints
 {
-    qApp->setProperty("_d_menu_underlineshortcut", visible);
+    bool resolved = false;
+    bool underlineShortcut = false;
+    bool keyboardSearchDisabled = false;
+};
+
+static PreferenceHints &preferenceHints()
+{
+    static PreferenceHints hints;
+    return hints;
 }
 
-static inline bool hasConfig(const QString &key, bool fallback = false)
+static DConfig &preferenceConfig()
 {
     static DConfig config("org.deepin.dtk.preference");
-    return config.value(key, fallback).toBool();
+    return config;
+}
+
+static inline bool hasConfig(const QString &key, bool fallback = false)
+{
+    return preferenceConfig().value(key, fallback).toBool();
 }
 
 static inline bool hasProperty(const char *key, std::function<bool()> fallback)
@@ -212,27 +230,89 @@ static inline bool hasEnv(const char *key, std::function<bool()> fallback)
     return fallback();
 }
 
-bool DStyle::shortcutUnderlineVisible()
+static const PreferenceHints &resolvedPreferenceHints()
 {
-    return hasEnv("D_MENU_UNDERLINESHORTCUT", []()->bool {
+    PreferenceHints &hints = preferenceHints();
+    if (hints.resolved)
+        return hints;
+
+    static bool watching = false;
+    if (!watching) {
+        watching = true;
+        QObject::connect(&preferenceConfig(), &DConfig::valueChanged, [] {
+            preferenceHints().resolved = false;
+        });
+    }
+
+    hints.underlineShortcut = hasEnv("D_MENU_UNDERLINESHORTCUT", []()->bool {
         return hasProperty("_d_menu_underlineshortcut", []()->bool {
             return hasConfig("underlineShortcut");
         });
     });
+    hints.keyboardSearchDisabled = hasEnv("D_MENU_DISABLE_KEYBOARDSEARCH", []()->bool {
+        return hasProperty("_d_menu_keyboardsearch_disabled", []()->bool {
+            return hasConfig("keyboardsearchDisabled");
+        });
+    });
+    hints.resolved = true;
+
+    return hints;
+}
+
+void dstylePreferencePropertyChanged(const QByteArray &name)
+{
+    if (name == "_d_menu_underlineshortcut" || name == "_d_menu_keyboardsearch_disabled")
+        preferenceHints().resolved = false;
+}
+
+void DStyle::setShortcutUnderlineVisible(bool visible)
+{
+    qApp->setProperty("_d_menu_underlineshortcut", visible);
+    preferenceHints().resolved = false;
+}
+
+bool DStyle::shortcutUnderlineVisible()
+{
+    return resolvedPreferenceHints().underlineShortcut;
 }
 
 void DStyle::setMenuKeyboardSearchDisabled(bool disabled)
 {
     qApp->setProperty("_d_menu_keyboardsearch_disabled", disabled);
+    preferenceHints().resolved = false;
 }
 
 bool DStyle::isMenuKeyboardSearchDisabled()
 {
-    return hasEnv("D_MENU_DISABLE_KEYBOARDSEARCH", []()->bool {
-        return hasProperty("_d_menu_keyboardsearch_disabled", []()->bool {
-            return hasConfig("keyboardsearchDisabled");
+    return resolvedPreferenceHints().keyboardSearchDisabled;
+}
+
+// 判断字体是否包含圆点字符需要加载字体引擎，按字体缓存结果，字体数据库变化后清空
+static const int MaxPasswordCharacterCache = 32;
+
+static bool fontHasPasswordCharacter(const QFont &font)
+{
+    static QHash<QFont, bool> cache;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 11, 0)
+    static bool watching = false;
+    if (!watching && qApp) {
+        watching = true;
+        QObject::connect(qApp, &QGuiApplication::fontDatabaseChanged, [] {
+            cache.clear();
         });
-    });
+    }
+#endif
+
+    auto it = cache.constFind(font);
+    if (it != cache.constEnd())
+        return it.value();
+
+    const bool contains = QFontMetrics(font).inFont(QChar(0x26AB));
+    if (cache.size() >= MaxPasswordCharacterCache)
+        cache.clear();
+    cache.insert(font, contains);
+
+    return contains;
 }
 
 namespace DDrawUtils {
@@ -1877,103 +1957,201 @@ QSize DStyle::sizeFromContents(const QStyle *style, DStyle::ContentsType ct, con
     return contentsSize;
 }
 
+// 标准图标的缓存键: 图标枚举值、影响图标内容的选项状态以及图标依赖的控件
+typedef QPair<quint64, const QWidget *> StandardIconKey;
+struct StandardIconCacheEntry
+{
+    QIcon icon;
+    // 图标依赖控件的调色板时记录该控件，控件销毁后缓存失效
+    QPointer<QWidget> widget;
+};
+typedef QHash<StandardIconKey, StandardIconCacheEntry> StandardIconCache;
+
+// 单个风格实例缓存的图标上限，超出后整体清空
+static const int MaxStandardIconCache = 256;
+// 成员函数 DStyle::standardIcon(QStyle::StandardPixmap) 中处理的图标使用独立的键空间
+static const quint32 MemberStandardIconVariant = 1u << 31;
+// 单个 DStyledIconEngine 缓存的 pixmap 上限
+static const int MaxStyledIconPixmapCache = 16;
+
+static QHash<const QStyle *, StandardIconCache> &standardIconCaches()
+{
+    static QHash<const QStyle *, StandardIconCache> caches;
+    return caches;
+}
+
+typedef QPair<quint64, QRgb> StyledIconPixmapKey;
+static QHash<const DStyledIconEngine *, QHash<StyledIconPixmapKey, QPixmap>> &styledIconPixmapCaches()
+{
+    static QHash<const DStyledIconEngine *, QHash<StyledIconPixmapKey, QPixmap>> caches;
+    return caches;
+}
+
+// 主题或图标主题变化后图标内容可能改变，清空所有缓存
+static void watchIconThemeChanges()
+{
+    static bool watching = false;
+    if (watching || !qApp)
+        return;
+
+    watching = true;
+    auto clearCaches = [] {
+        standardIconCaches().clear();
+        styledIconPixmapCaches().clear();
+    };
+    QObject::connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::themeTypeChanged, qApp, clearCaches);
+    QObject::connect(DGuiApplicationHelper::instance()->systemTheme(), &DPlatformTheme::iconThemeNameChanged, qApp, clearCaches);
+}
+
+template<typename CreateFun>
+static QIcon cachedStandardIcon(const QStyle *style, quint32 st, quint32 variant, const QWidget *widget, CreateFun create)
+{
+    if (!style)
+        return create();
+
+    watchIconThemeChanges();
+
+    auto &caches = standardIconCaches();
+    auto cacheIt = caches.find(style);
+    if (cacheIt == caches.end()) {
+        QObject::connect(style, &QObject::destroyed, [style] {
+            standardIconCaches().remove(style);
+        });
+        cacheIt = caches.insert(style, StandardIconCache());
+    }
+
+    const StandardIconKey key((quint64(st) << 32) | variant, widget);
+    auto it = cacheIt->constFind(key);
+    if (it != cacheIt->constEnd() && (!widget || it->widget))
+        return it->icon;
+
+    const QIcon icon = create();
+    // 空图标可能是图标主题暂时缺失，不做缓存
+    if (icon.isNull())
+        return icon;
+
+    // create 中可能递归调用 standardIcon，重新查找缓存
+    StandardIconCache &cache = standardIconCaches()[style];
+    if (cache.size() >= MaxStandardIconCache)
+        cache.clear();
+    cache.insert(key, {icon, const_cast<QWidget *>(widget)});
+
+    return icon;
+}
+
 /*!
   \brief DStyle::standardIcon
 
   \a style 风格实例 \a st 基本 Pixmap 对象枚举 \a opt 风格选项 \a widget 控件实例
 
+  返回的图标按风格实例缓存，主题或图标主题变化后重新创建.
+
   \sa QStyle::standardIcon()
  */
 QIcon DStyle::standardIcon(const QStyle *style, DStyle::StandardPixmap st, const QStyleOption *opt, const QWidget *widget)
 {
-    Q_UNUSED(opt)
-    Q_UNUSED(style)
-    Q_UNUSED(widget)
-
-#define CASE_ICON(Value) \
-case static_cast<uint32_t>(SP_##Value): { \
-        DStyledIconEngine *icon_engine = new DStyledIconEngine(DDrawUtils::draw##Value, QStringLiteral(#Value)); \
-        return QIcon(icon_engine);}
-
+    // 只有少数图标依赖选项状态或控件，其余图标在同一风格下是固定的
+    quint32 variant = 0;
+    const QWidget *keyWidget = nullptr;
     switch (st) {
-        CASE_ICON(SelectElement)
-
-    case SP_IndicatorUnchecked:
-        return DIconTheme::findQIcon("unselected_indicator");
-    case SP_IndicatorChecked: {
-        bool checked = opt && (opt->state & QStyle::State_Selected);
-        const QIcon &sci = DIconTheme::findQIcon("selected_checked_indicator");
-        bool useNewIcon = checked && !sci.isNull();
-        const QIcon &icon = useNewIcon ? sci : DIconTheme::findQIcon("selected_indicator");
-        DStyledIconEngine *icon_engine = new DStyledIconEngine(std::bind(DStyledIconEngine::drawIcon, icon, std::placeholders::_1, std::placeholders::_2), QStringLiteral("IndicatorChecked"));
-        icon_engine->setFrontRole(widget, useNewIcon ? DPalette::HighlightedText : DPalette::Highlight );
-        return QIcon(icon_engine);
-    }
-    case SP_DeleteButton:
-        return DIconTheme::findQIcon("list_delete");
-    case SP_AddButton:
-        return DIconTheme::findQIcon("list_add");
-    case SP_ForkElement:
-        return DIconTheme::findQIcon("fork_indicator");
-    case SP_CloseButton:
-        return DIconTheme::findQIcon("window-close_round");
-    case SP_DecreaseElement:
-        return DIconTheme::findQIcon("button_reduce");
-    case SP_IncreaseElement:
-        return DIconTheme::findQIcon("button_add");
-    case SP_MarkElement:
-        return DIconTheme::findQIcon("mark_indicator");
-    case SP_UnlockElement:
-        return DIconTheme::findQIcon("unlock_indicator");
-    case SP_LockElement:
-        return DIconTheme::findQIcon("lock_indicator");
-    case SP_ExpandElement:
-        return DIconTheme::findQIcon("go-up");
-    case SP_ReduceElement:
-        return DIconTheme::findQIcon("go-down");
+    case SP_IndicatorChecked:
+        variant = opt && (opt->state & QStyle::State_Selected);
+        keyWidget = widget;
+        break;
     case SP_ArrowEnter:
-        return style->standardIcon(SP_ArrowForward);
-    case SP_ArrowNext:
-        return DIconTheme::findQIcon("next_indicator");
     case SP_ArrowLeave:
-        return style->standardIcon(SP_ArrowBack);
-    case SP_ArrowPrev:
-        return DIconTheme::findQIcon("prev_indicator");
-    case SP_EditElement:
-        return DIconTheme::findQIcon("edit");
-    case SP_MediaVolumeLowElement:
-        return DIconTheme::findQIcon("audio-volume-low");
-    case SP_MediaVolumeHighElement:
-        return DIconTheme::findQIcon("audio-volume-medium");
-    case SP_MediaVolumeMutedElement:
-        return DIconTheme::findQIcon("audio-volume-muted");
-    case SP_MediaVolumeLeftElement:
-        return DIconTheme::findQIcon("audio-volume-left");
-    case SP_MediaVolumeRightElement:
-        return DIconTheme::findQIcon("audio-volume-right");
-    case SP_IndicatorMajuscule:
-        return DIconTheme::findQIcon("caps_lock");
-    case SP_ShowPassword:
-        return DIconTheme::findQIcon("password_show");
-    case SP_HidePassword:
-        return DIconTheme::findQIcon("password_hide");
-    case SP_IndicatorSearch:
-        return DIconTheme::findQIcon("search_indicator");
-    case SP_TitleMoreButton:
-        return DIconTheme::findQIcon("titlebar_more");
-    case SP_Title_SS_LeftButton:
-        return DIconTheme::findQIcon("splitscreen_left");
-    case SP_Title_SS_RightButton:
-        return DIconTheme::findQIcon("splitscreen_right");
-    case SP_Title_SS_ShowNormalButton:
-        return DIconTheme::findQIcon("splitscreen_shownormal");
-    case SP_Title_SS_ShowMaximizeButton:
-        return DIconTheme::findQIcon("splitscreen_showmaximize");
+        variant = QGuiApplication::layoutDirection() == Qt::RightToLeft;
+        break;
     default:
         break;
     }
 
-    return QIcon();
+#define CASE_ICON(Value) \
+case static_cast<uint32_t>(SP_##Value): { \
+        DStyledIconEngine *icon_engine = new DStyledIconEngine(DDrawUtils::draw##Value, QStringLiteral(#Value)); \
+        return QIcon(icon_engine);}
+
+    return cachedStandardIcon(style, st, variant, keyWidget, [=]() -> QIcon {
+        switch (st) {
+            CASE_ICON(SelectElement)
+
+        case SP_IndicatorUnchecked:
+            return DIconTheme::findQIcon("unselected_indicator");
+        case SP_IndicatorChecked: {
+            bool checked = opt && (opt->state & QStyle::State_Selected);
+            const QIcon &sci = DIconTheme::findQIcon("selected_checked_indicator");
+            bool useNewIcon = checked && !sci.isNull();
+            const QIcon &icon = useNewIcon ? sci : DIconTheme::findQIcon("selected_indicator");
+            DStyledIconEngine *icon_engine = new DStyledIconEngine(std::bind(DStyledIconEngine::drawIcon, icon, std::placeholders::_1, std::placeholders::_2), QStringLiteral("IndicatorChecked"));
+            icon_engine->setFrontRole(widget, useNewIcon ? DPalette::HighlightedText : DPalette::Highlight );
+            return QIcon(icon_engine);
+        }
+        case SP_DeleteButton:
+            return DIconTheme::findQIcon("list_delete");
+        case SP_AddButton:
+            return DIconTheme::findQIcon("list_add");
+        case SP_ForkElement:
+            return DIconTheme::findQIcon("fork_indicator");
+        case SP_CloseButton:
+            return DIconTheme::findQIcon("window-close_round");
+        case SP_DecreaseElement:
+            return DIconTheme::findQIcon("button_reduce");
+        case SP_IncreaseElement:
+            return DIconTheme::findQIcon("button_add");
+        case SP_MarkElement:
+            return DIconTheme::findQIcon("mark_indicator");
+        case SP_UnlockElement:
+            return DIconTheme::findQIcon("unlock_indicator");
+        case SP_LockElement:
+            return DIconTheme::findQIcon("lock_indicator");
+        case SP_ExpandElement:
+            return DIconTheme::findQIcon("go-up");
+        case SP_ReduceElement:
+            return DIconTheme::findQIcon("go-down");
+        case SP_ArrowEnter:
+            return style->standardIcon(SP_ArrowForward);
+        case SP_ArrowNext:
+            return DIconTheme::findQIcon("next_indicator");
+        case SP_ArrowLeave:
+            return style->standardIcon(SP_ArrowBack);
+        case SP_ArrowPrev:
+            return DIconTheme::findQIcon("prev_indicator");
+        case SP_EditElement:
+            return DIconTheme::findQIcon("edit");
+        case SP_MediaVolumeLowElement:
+            return DIconTheme::findQIcon("audio-volume-low");
+        case SP_MediaVolumeHighElement:
+            return DIconTheme::findQIcon("audio-volume-medium");
+        case SP_MediaVolumeMutedElement:
+            return DIconTheme::findQIcon("audio-volume-muted");
+        case SP_MediaVolumeLeftElement:
+            return DIconTheme::findQIcon("audio-volume-left");
+        case SP_MediaVolumeRightElement:
+            return DIconTheme::findQIcon("audio-volume-right");
+        case SP_IndicatorMajuscule:
+            return DIconTheme::findQIcon("caps_lock");
+        case SP_ShowPassword:
+            return DIconTheme::findQIcon("password_show");
+        case SP_HidePassword:
+            return DIconTheme::findQIcon("password_hide");
+        case SP_IndicatorSearch:
+            return DIconTheme::findQIcon("search_indicator");
+        case SP_TitleMoreButton:
+            return DIconTheme::findQIcon("titlebar_more");
+        case SP_Title_SS_LeftButton:
+            return DIconTheme::findQIcon("splitscreen_left");
+        case SP_Title_SS_RightButton:
+            return DIconTheme::findQIcon("splitscreen_right");
+        case SP_Title_SS_ShowNormalButton:
+            return DIconTheme::findQIcon("splitscreen_shownormal");
+        case SP_Title_SS_ShowMaximizeButton:
+            return DIconTheme::findQIcon("splitscreen_showmaximize");
+        default:
+            break;
+        }
+
+        return QIcon();
+    });
 }
 
 /*!
@@ -2036,7 +2214,7 @@ int DStyle::styleHint(QStyle::StyleHint sh, const QStyleOption *opt, const QWidg
     case SH_ScrollView_FrameOnlyAroundContents:
         return false;
     case SH_LineEdit_PasswordCharacter:
-        if (w && QFontMetrics(w->font()).inFont(QChar(0x26AB)))
+        if (w && fontHasPasswordCharacter(w->font()))
             return 0x26AB;
 
 	return 0x25CF;
@@ -2343,21 +2521,31 @@ QSize DStyle::sizeFromContents(QStyle::ContentsType ct, const QStyleOption *opt,
  */
 QIcon DStyle::standardIcon(QStyle::StandardPixmap st, const QStyleOption *opt, const QWidget *widget) const
 {
-    switch (static_cast<uint32_t>(st)) {
-        CASE_ICON(TitleBarMenuButton)
-        CASE_ICON(TitleBarMinButton)
-        CASE_ICON(TitleBarMaxButton)
-        CASE_ICON(TitleBarCloseButton)
-        CASE_ICON(TitleBarNormalButton)
-        CASE_ICON(TitleQuitFullButton)
-    case SP_LineEditClearButton:
-        return DIconTheme::findQIcon("button_edit-clear");
-    case SP_CommandLink:
-            return DIconTheme::findQIcon(QLatin1String("go-next"),
-                                    DIconTheme::findQIcon(QLatin1String("forward")));
-    default:
-        break;
-    }
+    bool handled = true;
+    const QIcon icon = cachedStandardIcon(this, st, MemberStandardIconVariant, nullptr, [st, &handled]() -> QIcon {
+        switch (static_cast<uint32_t>(st)) {
+            CASE_ICON(TitleBarMenuButton)
+            CASE_ICON(TitleBarMinButton)
+            CASE_ICON(TitleBarMaxButton)
+            CASE_ICON(TitleBarCloseButton)
+            CASE_ICON(TitleBarNormalButton)
+            CASE_ICON(TitleQuitFullButton)
+        case SP_LineEditClearButton:
+            return DIconTheme::findQIcon("button_edit-clear");
+        case SP_CommandLink:
+                return DIconTheme::findQIcon(QLatin1String("go-next"),
+                                        DIconTheme::findQIcon(QLatin1String("forward")));
+        default:
+            break;
+        }
+
+        handled = false;
+        return QIcon();
+    });
+
+    // 命中缓存的一定是这里处理过的图标
+    if (handled)
+        return icon;
 
     if (st < QStyle::SP_CustomBase) {
         return QCommonStyle::standardIcon(st, opt, widget);
@@ -3053,6 +3241,11 @@ DStyledIconEngine::DStyledIconEngine(DrawFun drawFun, const QString &iconName)
     m_widget = nullptr;
 }
 
+DStyledIconEngine::~DStyledIconEngine()
+{
+    styledIconPixmapCaches().remove(this);
+}
+
 /*!
   \brief DStyledIconEngine::bindDrawFun活页夹
   \a drawFun
@@ -3060,6 +3253,7 @@ DStyledIconEngine::DStyledIconEngine(DrawFun drawFun, const QString &iconName)
 void DStyledIconEngine::bindDrawFun(DrawFun drawFun)
 {
     m_drawFun = drawFun;
+    styledIconPixmapCaches().remove(this);
 }
 
 /*!
@@ -3080,13 +3274,37 @@ void DStyledIconEngine::setIconName(const QString &name)
  */
 QPixmap DStyledIconEngine::pixmap(const QSize &size, QIcon::Mode mode, QIcon::State state)
 {
+    // 绘制结果只取决于尺寸、模式、状态和前景色，前景色变化时使用新的缓存项
+    QRgb frontColor = 0;
+    if (m_painterRole != QPalette::NoRole) {
+        QPalette::ColorGroup cg = (mode == QIcon::Disabled) ? QPalette::Disabled : QPalette::Current;
+        const QPalette &pal = m_widget ? m_widget->palette() : qApp->palette();
+        frontColor = pal.brush(cg, m_painterRole).color().rgba();
+    }
+
+    // 传入的尺寸已经按设备像素比缩放，不需要单独记录缩放比
+    const quint64 sizeKey = (quint64(size.width() & 0xffffff) << 40) | (quint64(size.height() & 0xffffff) << 16)
+            | (quint64(mode) << 8) | quint64(state);
+    const StyledIconPixmapKey key(sizeKey, frontColor);
+    QHash<StyledIconPixmapKey, QPixmap> &cache = styledIconPixmapCaches()[this];
+    auto it = cache.constFind(key);
+    if (it != cache.constEnd())
+        return it.value();
+
     QImage image(size, QImage::Format_ARGB32_Premultiplied);
     image.fill(Qt::transparent);
     QPainter pa(&image);
     paint(&pa, QRect(QPoint(0, 0), size), mode, state);
     pa.end();
 
-    return QPixmap::fromImage(image);
+    const QPixmap pixmap = QPixmap::fromImage(image);
+    // 绘制过程中缓存可能被清空，重新获取
+    QHash<StyledIconPixmapKey, QPixmap> &currentCache = styledIconPixmapCaches()[this];
+    if (currentCache.size() >= MaxStyledIconPixmapCache)
+        currentCache.clear();
+    currentCache.insert(key, pixmap);
+
+    return pixmap;
 }
 
 /*!
@@ -3149,6 +3367,7 @@ void DStyledIconEngine::setFrontRole(const QWidget *widget, QPalette::ColorRole
 {
     m_painterRole = role;
     m_widget = widget;
+    styledIconPixmapCaches().remove(this);
 }
 
 void DStyledIconEngine::virtual_hook(int id, void *data)
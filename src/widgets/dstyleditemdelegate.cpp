@@ -10,6 +10,7 @@
 #include "dsizemode.h"
 
 #include "dlistview.h"
+#include "private/dstyleditemdelegate_p.h"
 
 #include <QDebug>
 #include <QApplication>
@@ -365,7 +366,7 @@ public:
             pa->setPen(option.palette.color(cg, QPalette::HighlightedText));
         } else {
             if (action->textColorType() > 0) {
-                pa->setPen(QPen(DPaletteHelper::instance()->palette(option.widget).brush(cg, action->textColorType()), 1));
+                pa->setPen(QPen(DPaletteHelper::instance()->brush(option.widget, action->textColorType(), cg), 1));
             } else {
                 QPalette::ColorRole role = action->textColorRole() > 0 ? action->textColorRole() : QPalette::Text;
                 pa->setPen(QPen(option.palette.brush(cg, role), 1));
@@ -529,7 +530,7 @@ public:
     QMargins margins;
     QSize itemSize;
     int itemSpacing = -1;
-    QMap<QModelIndex, QList<QPair<QAction*, QRect>>> clickableActionMap;
+    DViewItemActionHitIndex *actionHitIndex = nullptr;
     QAction *pressedAction = nullptr;
     QList<QPointer<QWidget>> lastWidgets;
     QList<QPointer<QWidget>> currentWidgets;
@@ -895,12 +896,131 @@ static QFont getViewItemFont(const QModelIndex &index, int role)
     return DFontSizeManager::instance()->get(size);
 }
 
+// 记录的项超过该数量后，清理不在可见区域内的项
+static const int DefaultActionHitIndexLimit = 64;
+
+DViewItemActionHitIndex::DViewItemActionHitIndex(QAbstractItemView *view, QObject *parent)
+    : QObject(parent)
+    , view(view)
+    , limit(DefaultActionHitIndexLimit)
+{
+}
+
+void DViewItemActionHitIndex::update(const QModelIndex &index, const QRect &itemRect, const ActionRects &actions)
+{
+    watchModel(index.model());
+
+    if (actions.isEmpty()) {
+        actionRects.remove(index);
+        return;
+    }
+
+    // 滚动时视图只重绘新露出的区域，保存相对位置，使用时再按项当前的位置换算
+    ActionRects &rects = actionRects[index];
+    rects = actions;
+    for (auto &action : rects)
+        action.second.translate(-itemRect.topLeft());
+
+    if (actionRects.size() > limit)
+        removeInvisible(index);
+}
+
+DViewItemActionHitIndex::ActionRects DViewItemActionHitIndex::actions(const QModelIndex &index) const
+{
+    ActionRects rects = actionRects.value(index);
+    if (rects.isEmpty() || !view)
+        return ActionRects();
+
+    const QPoint offset = view->visualRect(index).topLeft();
+    for (auto &action : rects)
+        action.second.translate(offset);
+
+    return rects;
+}
+
+int DViewItemActionHitIndex::count() const
+{
+    return actionRects.size();
+}
+
+void DViewItemActionHitIndex::clear()
+{
+    actionRects.clear();
+}
+
+void DViewItemActionHitIndex::watchModel(const QAbstractItemModel *model)
+{
+    if (this->model == model)
+        return;
+
+    for (const QMetaObject::Connection &connection : qAsConst(modelConnections))
+        disconnect(connection);
+    modelConnections.clear();
+    actionRects.clear();
+    this->model = const_cast<QAbstractItemModel *>(model);
+
+    if (!model)
+        return;
+
+    // 行列的增删移动以及布局变化后索引不再可靠，清空后等待重绘时重新记录
+    modelConnections << connect(model, &QAbstractItemModel::rowsInserted, this, &DViewItemActionHitIndex::clear)
+                     << connect(model, &QAbstractItemModel::rowsRemoved, this, &DViewItemActionHitIndex::clear)
+                     << connect(model, &QAbstractItemModel::rowsMoved, this, &DViewItemActionHitIndex::clear)
+                     << connect(model, &QAbstractItemModel::columnsInserted, this, &DViewItemActionHitIndex::clear)
+                     << connect(model, &QAbstractItemModel::columnsRemoved, this, &DViewItemActionHitIndex::clear)
+                     << connect(model, &QAbstractItemModel::columnsMoved, this, &DViewItemActionHitIndex::clear)
+                     << connect(model, &QAbstractItemModel::layoutChanged, this, &DViewItemActionHitIndex::clear)
+                     << connect(model, &QAbstractItemModel::modelReset, this, &DViewItemActionHitIndex::clear)
+                     << connect(model, &QAbstractItemModel::dataChanged, this, &DViewItemActionHitIndex::removeRange);
+}
+
+void DViewItemActionHitIndex::removeRange(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+    // 数据变化后 action 列表可能已被替换，移除变化的项
+    for (auto it = actionRects.begin(); it != actionRects.end();) {
+        const QModelIndex &index = it.key();
+        if (index.parent() == topLeft.parent()
+                && index.row() >= topLeft.row() && index.row() <= bottomRight.row()
+                && index.column() >= topLeft.column() && index.column() <= bottomRight.column()) {
+            it = actionRects.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void DViewItemActionHitIndex::removeInvisible(const QModelIndex &keep)
+{
+    const QRect visibleRect = view ? view->viewport()->rect() : QRect();
+
+    for (auto it = actionRects.begin(); it != actionRects.end();) {
+        bool visible = it.key() == keep;
+        if (!visible && view) {
+            const QPoint offset = view->visualRect(it.key()).topLeft();
+            for (int i = 0; !visible && i < it.value().size(); ++i)
+                visible = it.value().at(i).second.translated(offset).intersects(visibleRect);
+        }
+
+        if (visible) {
+            ++it;
+        } else {
+            it = actionRects.erase(it);
+        }
+    }
+
+    // 可见项本身较多时放宽上限，避免每次绘制都清理
+    limit = qMax(DefaultActionHitIndexLimit, actionRects.size() * 2);
+}
+
 DStyledItemDelegate::DStyledItemDelegate(QAbstractItemView *parent)
     : QStyledItemDelegate(parent)
     , DObject(*new DStyledItemDelegatePrivate(this))
 {
+    D_D(DStyledItemDelegate);
+
     //支持QAction的点击
     parent->viewport()->installEventFilter(this);
+    d->actionHitIndex = new DViewItemActionHitIndex(parent, this);
 
     // 初始化 background type. 注意 setBackgroundType() 中有额外的处理操作，所以不能直接简单的修改默认值
     setBackgroundType(DStyledItemDelegate::RoundedBackground);
@@ -973,11 +1093,7 @@ void DStyledItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &o
     action_area_size = d->drawActions(painter, opt, index.data(Dtk::BottomActionListRole), Qt::BottomEdge, &clickActionList);
     itemContentRect.setBottom(itemContentRect.bottom() - action_area_size.height() - (action_area_size.isNull() ? 0 : spacing));
 
-    if (!clickActionList.isEmpty()) {
-        const_cast<DStyledItemDelegatePrivate*>(d)->clickableActionMap[index] = clickActionList;
-    } else {
-        const_cast<DStyledItemDelegatePrivate*>(d)->clickableActionMap.remove(index);
-    }
+    d->actionHitIndex->update(index, option.rect, clickActionList);
 
     const DViewItemActionList &text_action_list = qvariantToActionList(index.data(Dtk::TextActionListRole));
 
@@ -1062,7 +1178,7 @@ void DStyledItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &o
                 if (opt.state & QStyle::State_Selected) {
                     painter->setPen(opt.palette.color(cg, QPalette::HighlightedText));
                 } else if (action->textColorType() >= 0) {
-                    painter->setPen(DPaletteHelper::instance()->palette(widget).color(cg, action->textColorType()));
+                    painter->setPen(DPaletteHelper::instance()->color(widget, action->textColorType(), cg));
                 } else if (action->textColorRole() >= 0) {
                     painter->setPen(opt.palette.color(cg, action->textColorRole()));
                 } else {
@@ -1376,7 +1492,7 @@ void DStyledItemDelegate::initStyleOption(QStyleOptionViewItem *option, const QM
     DPalette::ColorType type = getViewItemColorType(index, Dtk::ViewItemForegroundRole);
 
     if (type != DPalette::NoType) {
-        option->palette.setBrush(QPalette::Text, DPaletteHelper::instance()->palette(option->widget).brush(type));
+        option->palette.setBrush(QPalette::Text, DPaletteHelper::instance()->brush(option->widget, type));
     } else {
         QPalette::ColorRole role = getViewItemColorRole(index, Dtk::ViewItemForegroundRole);
 
@@ -1388,7 +1504,7 @@ void DStyledItemDelegate::initStyleOption(QStyleOptionViewItem *option, const QM
     type = getViewItemColorType(index, Dtk::ViewItemBackgroundRole);
 
     if (type != DPalette::NoType) {
-        option->backgroundBrush = DPaletteHelper::instance()->palette(option->widget).brush(type);
+        option->backgroundBrush = DPaletteHelper::instance()->brush(option->widget, type);
     } else {
         QPalette::ColorRole role = getViewItemColorRole(index, Dtk::ViewItemBackgroundRole);
 
@@ -1416,7 +1532,7 @@ bool DStyledItemDelegate::eventFilter(QObject *object, QEvent *event)
         QAbstractItemView *view = qobject_cast<QAbstractItemView*>(parent());
         const QModelIndex &index = view->indexAt(ev->pos());
 
-        for (auto action_map : d->clickableActionMap.value(index)) {
+        for (auto action_map : d->actionHitIndex->actions(index)) {
             if (action_map.first->isEnabled()
                     && action_map.second.contains(ev->pos(), true)) {
                 if (event->type() == QEvent::MouseButtonRelease
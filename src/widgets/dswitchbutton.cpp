@@ -11,10 +11,18 @@
 #include <DGuiApplicationHelper>
 
 #include <QApplication>
+#include <QHash>
+
+#include <algorithm>
 
 DWIDGET_BEGIN_NAMESPACE
 
 constexpr int DCI_ICON_SIZE = 120;
+// 防止循环播放的动画在解码时无法结束
+constexpr int MAX_FRAME_COUNT = 256;
+
+typedef QHash<QString, QWeakPointer<const DSwitchButtonFrames>> SwitchButtonFramesCache;
+Q_GLOBAL_STATIC(SwitchButtonFramesCache, _d_switchButtonFrames)
 
 /*!
 @~english
@@ -62,7 +70,7 @@ void DSwitchButton::paintEvent(QPaintEvent *e)
 
     if (ENABLE_ANIMATIONS && ENABLE_ANIMATION_SWITCHBUTTON) {
         painter.setRenderHint(QPainter::SmoothPixmapTransform);
-        painter.drawImage(rect().adjusted(4, -8, -4, 8), d->player.currentImage());          // 为了显示按钮的阴影所留的空白
+        painter.drawImage(rect().adjusted(4, -8, -4, 8), d->currentImage());          // 为了显示按钮的阴影所留的空白
     }
 }
 
@@ -103,8 +111,61 @@ void DSwitchButton::checkStateSet()
         return;
 
     d->checked = isChecked();
-    DDciIcon icon = !d->checked ? DDciIcon::fromTheme("switch_on") : DDciIcon::fromTheme("switch_off");
-    d->player.setIcon(icon);
+    d->setFrames(!d->checked ? "switch_on" : "switch_off", false);
+}
+
+QSharedPointer<const DSwitchButtonFrames> DSwitchButtonFrames::frames(const QString &iconName, DDciIcon::Theme theme,
+                                                                      const DDciIconPalette &palette, int iconSize,
+                                                                      qreal devicePixelRatio)
+{
+    const QString key = QStringLiteral("%1|%2|%3|%4|%5|%6|%7|%8").arg(iconName).arg(theme)
+                            .arg(palette.foreground().rgba()).arg(palette.background().rgba())
+                            .arg(palette.highlight().rgba()).arg(palette.highlightForeground().rgba())
+                            .arg(iconSize).arg(devicePixelRatio);
+
+    QSharedPointer<const DSwitchButtonFrames> cached = _d_switchButtonFrames->value(key).toStrongRef();
+    if (cached)
+        return cached;
+
+    QSharedPointer<DSwitchButtonFrames> frames(new DSwitchButtonFrames);
+    const DDciIcon icon = DDciIcon::fromTheme(iconName);
+    DDciIconImage image = icon.image(icon.matchIcon(iconSize, theme, DDciIcon::Normal), iconSize, devicePixelRatio);
+    if (!image.isNull()) {
+        int time = 0;
+        do {
+            frames->images.append(image.toImage(palette));
+            time += qMax(0, image.currentImageDuration());
+            frames->endTimes.append(time);
+        } while (frames->images.size() < MAX_FRAME_COUNT && image.jumpToNextImage());
+    }
+
+    // 所有开关都不再使用的帧已被释放，顺便清理失效的条目
+    for (auto it = _d_switchButtonFrames->begin(); it != _d_switchButtonFrames->end();) {
+        if (it.value().isNull())
+            it = _d_switchButtonFrames->erase(it);
+        else
+            ++it;
+    }
+    _d_switchButtonFrames->insert(key, frames.toWeakRef());
+
+    return frames;
+}
+
+int DSwitchButtonFrames::duration() const
+{
+    return endTimes.isEmpty() ? 0 : endTimes.last();
+}
+
+QImage DSwitchButtonFrames::image(int time) const
+{
+    if (images.isEmpty())
+        return QImage();
+
+    auto it = std::upper_bound(endTimes.constBegin(), endTimes.constEnd(), time);
+    if (it == endTimes.constEnd())
+        return images.last();
+
+    return images.at(int(it - endTimes.constBegin()));
 }
 
 DSwitchButtonPrivate::DSwitchButtonPrivate(DSwitchButton *qq)
@@ -136,37 +197,73 @@ void DSwitchButtonPrivate::init()
         return;
     }
 
-    auto initPlayer= [this, q]() {
-        DDciIcon icon = !checked ? DDciIcon::fromTheme("switch_on") : DDciIcon::fromTheme("switch_off");
-        player.setIcon(icon);
-        player.setMode(DDciIcon::Mode::Normal);
-        auto palette = DDciIconPalette::fromQPalette(q->palette());
-        player.setPalette(palette);
-        player.setDevicePixelRatio(qApp->devicePixelRatio());
-        player.setIconSize(DCI_ICON_SIZE);
-        player.setTheme(DGuiApplicationHelper::instance()->themeType() == DGuiApplicationHelper::DarkType
-                        ? DDciIcon::Dark : DDciIcon::Light);
-    };
-
-    initPlayer();
+    setFrames(!checked ? "switch_on" : "switch_off", false);
 
     q->connect(q, &DSwitchButton::toggled, q, [q, this](bool ckd) {
         if (checked == ckd)
             return;
 
         checked = ckd;
-        DDciIcon icon = checked ? DDciIcon::fromTheme("switch_on") : DDciIcon::fromTheme("switch_off");
-        player.setIcon(icon);
-        player.play(DDciIcon::Mode::Normal);
+        setFrames(checked ? "switch_on" : "switch_off", true);
 
         Q_EMIT q->checkedChanged(checked);
     });
 
-    q->connect(&player, &DDciIconPlayer::updated, q, [q]() {
+    q->connect(&animation, &QVariantAnimation::valueChanged, q, [q]() {
+        q->update();
+    });
+
+    // 帧在下次绘制时按新的主题重新获取
+    q->connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::themeTypeChanged, q, [q, this]() {
+        setFrames(!checked ? "switch_on" : "switch_off", false);
         q->update();
     });
+}
+
+void DSwitchButtonPrivate::setFrames(const QString &name, bool play)
+{
+    animation.stop();
+    iconName = name;
+    frames.reset();
+    playedToEnd = false;
+
+    if (!play)
+        return;
+
+    ensureFrames();
+    const int duration = frames->duration();
+    playedToEnd = true;
+    if (duration > 0) {
+        animation.setStartValue(0);
+        animation.setEndValue(duration);
+        animation.setDuration(duration);
+        animation.start();
+    }
+}
+
+void DSwitchButtonPrivate::ensureFrames()
+{
+    D_Q(DSwitchButton);
+
+    const qreal ratio = q->devicePixelRatioF();
+    if (!frames || !qFuzzyCompare(framesRatio, ratio)) {
+        const DDciIcon::Theme theme = DGuiApplicationHelper::instance()->themeType() == DGuiApplicationHelper::DarkType
+                                      ? DDciIcon::Dark : DDciIcon::Light;
+        frames = DSwitchButtonFrames::frames(iconName, theme, DDciIconPalette::fromQPalette(q->palette()),
+                                             DCI_ICON_SIZE, ratio);
+        framesRatio = ratio;
+    }
+}
+
+QImage DSwitchButtonPrivate::currentImage()
+{
+    ensureFrames();
+
+    // 未播放过动画时停在第一帧，播放结束后停在最后一帧
+    if (animation.state() == QAbstractAnimation::Running)
+        return frames->image(animation.currentTime());
 
-    q->connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::themeTypeChanged, q, initPlayer);
+    return frames->image(playedToEnd ? frames->duration() : 0);
 }
 
 DWIDGET_END_NAMESPACE
@@ -4,10 +4,13 @@
 
 #include "dwatermarkwidget.h"
 
+#include "dcacheregistry.h"
+
 #include <DObjectPrivate>
 #include <DWidgetUtil>
 
 #include <QPainter>
+#include <QPaintEvent>
 #include <QResizeEvent>
 #include <QDebug>
 
@@ -413,12 +416,27 @@ void drawWaterTexture(QPainter &painter, const QImage &texture, qreal rotation,
             .translate(-center.x(), -center.y());
     b.setTransform(t);
 
-//    painter.setPen(Qt::NoPen);
+    painter.setPen(Qt::NoPen);
     painter.setBrush(b);
     painter.drawRect(paintRect);
     painter.restore();
 }
 
+// 平铺水印缓存的尺寸按该值向上取整，父界面在此范围内调整大小时不需要重新生成
+static const int TiledCacheAlignment = 512;
+// 平铺水印缓存的内存上限，控件更大时直接用旋转的画刷填充重绘区域
+static const qint64 TiledCacheMaxBytes = 4 * 1024 * 1024;
+
+// 只拷贝重绘区域内的平铺水印
+static void drawTiledImage(QPainter &painter, const QImage &image, const QRegion &region)
+{
+    const qreal deviceScale = image.devicePixelRatio();
+    for (const QRect &rect : region) {
+        const QRectF source(rect.topLeft() * deviceScale, rect.size() * deviceScale);
+        painter.drawImage(QRectF(rect), image, source);
+    }
+}
+
 class DWaterMarkWidgetPrivate: public DTK_CORE_NAMESPACE::DObjectPrivate
 {
 protected:
@@ -428,11 +446,23 @@ protected:
 
     }
 
+    ~DWaterMarkWidgetPrivate() override
+    {
+        if (cacheId)
+            DCacheRegistry::instance()->unregisterEntry(cacheId);
+    }
+
 private:
     void init();
+    const QImage &tiledImage(const QSize &size, qreal deviceScale);
+    void clearTiledImage();
+    void paintTiled(QPainter &painter, const QSize &size, qreal deviceScale, const QRegion &region);
 
     WaterMarkData data;
     QImage textureImage;
+    // 预先绘制好的旋转平铺水印，绘制时只需要拷贝重绘区域
+    QImage tiledCache;
+    quint64 cacheId = 0;
 
     D_DECLARE_PUBLIC(DWaterMarkWidget)
 };
@@ -446,6 +476,67 @@ void DWaterMarkWidgetPrivate::init()
     q->setFocusPolicy(Qt::NoFocus);
 }
 
+const QImage &DWaterMarkWidgetPrivate::tiledImage(const QSize &size, qreal deviceScale)
+{
+    // 水印图案相对于控件原点固定，绘制比控件更大的区域不影响已有部分的内容
+    auto align = [](int value) {
+        return (qMax(value, 1) + TiledCacheAlignment - 1) / TiledCacheAlignment * TiledCacheAlignment;
+    };
+    const QSize deviceSize = size * deviceScale;
+    const QSize cacheSize(align(deviceSize.width()), align(deviceSize.height()));
+    if (qint64(cacheSize.width()) * cacheSize.height() * 4 > TiledCacheMaxBytes) {
+        clearTiledImage();
+        return tiledCache;
+    }
+
+    // 控件缩小到不足缓存面积的一半时按新尺寸重新生成，不再一直占用最大尺寸时的内存
+    const qint64 maxCacheArea = 2 * qint64(cacheSize.width()) * cacheSize.height();
+    if (!tiledCache.isNull() && qFuzzyCompare(tiledCache.devicePixelRatio(), deviceScale)
+            && tiledCache.width() >= deviceSize.width() && tiledCache.height() >= deviceSize.height()
+            && qint64(tiledCache.width()) * tiledCache.height() <= maxCacheArea) {
+        DCacheRegistry::instance()->touch(cacheId);
+        return tiledCache;
+    }
+
+    tiledCache = QImage(cacheSize, QImage::Format_ARGB32_Premultiplied);
+    tiledCache.setDevicePixelRatio(deviceScale);
+    tiledCache.fill(Qt::transparent);
+
+    QPainter painter(&tiledCache);
+    drawWaterTexture(painter, textureImage, data.rotation(),
+                     QRect(QPoint(0, 0), QSizeF(tiledCache.size() / deviceScale).toSize()));
+    painter.end();
+
+    if (!cacheId) {
+        cacheId = DCacheRegistry::instance()->registerEntry(QStringLiteral("DWaterMarkWidget"), 0, [this] {
+            tiledCache = QImage();
+        });
+    }
+    DCacheRegistry::instance()->updateCost(cacheId, tiledCache.sizeInBytes());
+
+    return tiledCache;
+}
+
+void DWaterMarkWidgetPrivate::clearTiledImage()
+{
+    tiledCache = QImage();
+    if (cacheId)
+        DCacheRegistry::instance()->updateCost(cacheId, 0);
+}
+
+void DWaterMarkWidgetPrivate::paintTiled(QPainter &painter, const QSize &size, qreal deviceScale, const QRegion &region)
+{
+    const QImage &image = tiledImage(size, deviceScale);
+    if (!image.isNull()) {
+        drawTiledImage(painter, image, region);
+        return;
+    }
+
+    // 超过缓存上限，画刷的变换相对于控件原点，逐个填充重绘区域与整体绘制的结果一致
+    for (const QRect &rect : region)
+        drawWaterTexture(painter, textureImage, data.rotation(), rect);
+}
+
 /*!
   \class Dtk::Widget::DWaterMarkWidget
   \inmodule dtkwidget
@@ -481,11 +572,12 @@ void DWaterMarkWidget::setData(const WaterMarkData &data)
 
     d->data = data;
     d->textureImage = createTextureImage(d->data, devicePixelRatioF());
+    d->clearTiledImage();
 
     update();
 }
 
-void DWaterMarkWidget::paintEvent(QPaintEvent *)
+void DWaterMarkWidget::paintEvent(QPaintEvent *event)
 {
     D_D(DWaterMarkWidget);
 
@@ -518,7 +610,7 @@ void DWaterMarkWidget::paintEvent(QPaintEvent *)
             painter.drawText(rect(), Qt::AlignCenter, d->data.text());
             painter.restore();
         } else {
-            drawWaterTexture(painter, d->textureImage, d->data.rotation(), rect());
+            d->paintTiled(painter, size(), deviceScale, event->region());
         }
         break;
     }
@@ -546,7 +638,7 @@ void DWaterMarkWidget::paintEvent(QPaintEvent *)
             QPointF leftTop(rect().center().x() - imgWidth / 2.0, rect().center().y() - imgHeight / 2.0);
             painter.drawImage(leftTop, img);
         } else {
-            drawWaterTexture(painter, d->textureImage, d->data.rotation(), rect());
+            d->paintTiled(painter, size(), deviceScale, event->region());
         }
         break;
     }
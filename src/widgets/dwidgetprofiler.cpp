@@ -0,0 +1,434 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "dwidgetprofiler.h"
+#include "private/dwidgetprofiler_p.h"
+
+#include <QApplication>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMetaEnum>
+#include <QPainter>
+#include <QTimer>
+
+#include <algorithm>
+
+DWIDGET_BEGIN_NAMESPACE
+
+// 慢控件高亮显示的时长
+static const int HighlightDuration = 1000;
+
+static DWidgetProfiler *g_instance = nullptr;
+
+std::atomic<bool> DWidgetProfilerPrivate::active(false);
+DWidgetProfilerScope *DWidgetProfilerScope::current = nullptr;
+
+DWidgetProfilerOverlay::DWidgetProfilerOverlay(QWidget *window)
+    : QWidget(window)
+    , expireTimer(new QTimer(this))
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setAttribute(Qt::WA_NoSystemBackground);
+    setFocusPolicy(Qt::NoFocus);
+    setGeometry(window->rect());
+    window->installEventFilter(this);
+
+    clock.start();
+    expireTimer->setInterval(HighlightDuration / 4);
+    connect(expireTimer, &QTimer::timeout, this, &DWidgetProfilerOverlay::expire);
+
+    show();
+    raise();
+}
+
+void DWidgetProfilerOverlay::highlight(QWidget *widget, qint64 nsecs)
+{
+    const QRect rect(widget->mapTo(parentWidget(), QPoint(0, 0)), widget->size());
+    const QString text = QStringLiteral("%1 %2ms").arg(QString::fromLatin1(widget->metaObject()->className()))
+                                                 .arg(nsecs / 1e6, 0, 'f', 1);
+
+    auto it = highlights.find(widget);
+    // 位置未变化时只延长显示时间，避免高亮引起的重绘再次触发高亮
+    const bool changed = it == highlights.end() || it->rect != rect;
+    highlights[widget] = {rect, text, clock.elapsed() + HighlightDuration};
+
+    if (changed) {
+        raise();
+        update(rect);
+    }
+
+    if (!expireTimer->isActive())
+        expireTimer->start();
+}
+
+bool DWidgetProfilerOverlay::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == parentWidget()) {
+        if (event->type() == QEvent::Resize) {
+            setGeometry(parentWidget()->rect());
+        } else if (event->type() == QEvent::ChildAdded
+                   && static_cast<QChildEvent *>(event)->child() != this) {
+            raise();
+        }
+    }
+
+    return QWidget::eventFilter(watched, event);
+}
+
+void DWidgetProfilerOverlay::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+
+    QPainter pa(this);
+    QColor color(Qt::red);
+    pa.setPen(QPen(color, 2));
+    color.setAlpha(40);
+    pa.setBrush(color);
+
+    for (const Highlight &item : std::as_const(highlights)) {
+        pa.drawRect(item.rect.adjusted(1, 1, -1, -1));
+
+        const QRect textRect = pa.fontMetrics().boundingRect(item.text).adjusted(-2, -1, 2, 1);
+        const QRect labelRect(item.rect.topLeft(), textRect.size());
+        pa.fillRect(labelRect, Qt::red);
+        pa.save();
+        pa.setPen(Qt::white);
+        pa.drawText(labelRect, Qt::AlignCenter, item.text);
+        pa.restore();
+    }
+}
+
+void DWidgetProfilerOverlay::expire()
+{
+    const qint64 now = clock.elapsed();
+    for (auto it = highlights.begin(); it != highlights.end();) {
+        if (it->expireTime <= now) {
+            update(it->rect);
+            it = highlights.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (highlights.isEmpty())
+        expireTimer->stop();
+}
+
+DWidgetProfilerPrivate::DWidgetProfilerPrivate(DWidgetProfiler *qq)
+    : DObjectPrivate(qq)
+{
+}
+
+int DWidgetProfilerPrivate::eventIndex(QEvent::Type type)
+{
+    switch (type) {
+    case QEvent::Paint:
+        return DWidgetProfiler::PaintEvent;
+    case QEvent::LayoutRequest:
+        return DWidgetProfiler::LayoutRequestEvent;
+    case QEvent::Resize:
+        return DWidgetProfiler::ResizeEvent;
+    case QEvent::StyleChange:
+        return DWidgetProfiler::StyleChangeEvent;
+    default:
+        return -1;
+    }
+}
+
+int DWidgetProfilerPrivate::histogramBucket(qint64 nsecs)
+{
+    // 区间上限依次为 16us、64us、256us ... 65536us，最后一个区间不设上限
+    const qint64 usecs = nsecs / 1000;
+    int bucket = 0;
+    qint64 bound = 16;
+    while (bucket < HistogramBuckets - 1 && usecs >= bound) {
+        ++bucket;
+        bound *= 4;
+    }
+    return bucket;
+}
+
+void DWidgetProfilerPrivate::initFromEnvironment()
+{
+    // D_DTK_WIDGET_PROFILER=1 开启统计，=overlay 时同时高亮显示慢控件
+    const QByteArray env = qgetenv("D_DTK_WIDGET_PROFILER");
+    if (env.isEmpty())
+        return;
+
+    DWidgetProfiler *profiler = DWidgetProfiler::instance();
+    profiler->setEnabled(env != "0");
+    profiler->setOverlayEnabled(env == "overlay");
+
+    const QString dumpFile = qEnvironmentVariable("D_DTK_WIDGET_PROFILER_DUMP");
+    if (!dumpFile.isEmpty()) {
+        QObject::connect(qApp, &QCoreApplication::aboutToQuit, profiler, [profiler, dumpFile] {
+            profiler->dumpJson(dumpFile);
+        });
+    }
+}
+
+static void addSample(DWidgetProfilerPrivate::Entry &entry, qint64 nsecs)
+{
+    ++entry.count;
+    entry.totalNsecs += nsecs;
+    entry.maxNsecs = qMax(entry.maxNsecs, nsecs);
+    ++entry.histogram[DWidgetProfilerPrivate::histogramBucket(nsecs)];
+}
+
+void DWidgetProfilerPrivate::record(const QMetaObject *metaObject, const QString &objectName, int event, qint64 nsecs)
+{
+    addSample(classEntries[metaObject].entries[event], nsecs);
+
+    if (!objectName.isEmpty())
+        addSample(objectEntries[qMakePair(metaObject, objectName)].entries[event], nsecs);
+}
+
+void DWidgetProfilerPrivate::highlight(QWidget *widget, qint64 nsecs)
+{
+    QWidget *window = widget->window();
+    QPointer<DWidgetProfilerOverlay> &overlay = overlays[window];
+    if (!overlay)
+        overlay = new DWidgetProfilerOverlay(window);
+
+    overlay->highlight(widget, nsecs);
+}
+
+DWidgetProfilerScope::DWidgetProfilerScope(QObject *object, QEvent *e)
+    : event(object->isWidgetType() ? DWidgetProfilerPrivate::eventIndex(e->type()) : -1)
+{
+    if (event < 0)
+        return;
+
+    QWidget *w = static_cast<QWidget *>(object);
+    if (dynamic_cast<DWidgetProfilerOverlay *>(w)) {
+        event = -1;
+        return;
+    }
+
+    metaObject = w->metaObject();
+    objectName = w->objectName();
+    if (DWidgetProfiler::instance()->isOverlayEnabled())
+        widget = w;
+
+    parent = current;
+    current = this;
+    timer.start();
+}
+
+DWidgetProfilerScope::~DWidgetProfilerScope()
+{
+    if (event < 0)
+        return;
+
+    const qint64 elapsed = timer.nsecsElapsed();
+    current = parent;
+    if (parent)
+        parent->childNsecs += elapsed;
+
+    DWidgetProfilerPrivate *d = DWidgetProfilerPrivate::get(DWidgetProfiler::instance());
+    const qint64 selfNsecs = qMax<qint64>(0, elapsed - childNsecs);
+    d->record(metaObject, objectName, event, selfNsecs);
+
+    if (widget && d->overlayEnabled && selfNsecs >= qint64(d->slowThreshold) * 1000)
+        d->highlight(widget, selfNsecs);
+}
+
+DWidgetProfiler::DWidgetProfiler(QObject *parent)
+    : QObject(parent)
+    , DObject(*new DWidgetProfilerPrivate(this))
+{
+}
+
+DWidgetProfiler::~DWidgetProfiler()
+{
+    DWidgetProfilerPrivate::active.store(false, std::memory_order_relaxed);
+
+    if (g_instance == this)
+        g_instance = nullptr;
+}
+
+DWidgetProfiler *DWidgetProfiler::instance()
+{
+    if (!g_instance)
+        g_instance = new DWidgetProfiler(qApp);
+
+    return g_instance;
+}
+
+bool DWidgetProfiler::isEnabled() const
+{
+    return DWidgetProfilerPrivate::isActive();
+}
+
+void DWidgetProfiler::setEnabled(bool enabled)
+{
+    if (DWidgetProfilerPrivate::active.exchange(enabled) == enabled)
+        return;
+
+    Q_EMIT enabledChanged(enabled);
+}
+
+bool DWidgetProfiler::isOverlayEnabled() const
+{
+    D_DC(DWidgetProfiler);
+
+    return d->overlayEnabled;
+}
+
+void DWidgetProfiler::setOverlayEnabled(bool enabled)
+{
+    D_D(DWidgetProfiler);
+
+    if (d->overlayEnabled == enabled)
+        return;
+
+    d->overlayEnabled = enabled;
+
+    if (!enabled) {
+        for (const QPointer<DWidgetProfilerOverlay> &overlay : std::as_const(d->overlays)) {
+            if (overlay)
+                overlay->deleteLater();
+        }
+        d->overlays.clear();
+    }
+}
+
+int DWidgetProfiler::slowThreshold() const
+{
+    D_DC(DWidgetProfiler);
+
+    return d->slowThreshold;
+}
+
+void DWidgetProfiler::setSlowThreshold(int usecs)
+{
+    D_D(DWidgetProfiler);
+
+    d->slowThreshold = qMax(0, usecs);
+}
+
+template<typename Key, typename Fill>
+static QList<DWidgetProfiler::Record> toRecords(const QHash<Key, DWidgetProfilerPrivate::Entries> &entries, Fill fill)
+{
+    QList<DWidgetProfiler::Record> records;
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+        for (int event = 0; event < DWidgetProfiler::EventTypeCount; ++event) {
+            const DWidgetProfilerPrivate::Entry &entry = it.value().entries[event];
+            if (!entry.count)
+                continue;
+
+            DWidgetProfiler::Record record;
+            fill(it.key(), record);
+            record.eventType = DWidgetProfiler::EventType(event);
+            record.count = entry.count;
+            record.totalNsecs = entry.totalNsecs;
+            record.maxNsecs = entry.maxNsecs;
+            record.histogram.reserve(DWidgetProfilerPrivate::HistogramBuckets);
+            for (quint64 value : entry.histogram)
+                record.histogram.append(value);
+            records.append(record);
+        }
+    }
+
+    std::sort(records.begin(), records.end(), [](const DWidgetProfiler::Record &r1, const DWidgetProfiler::Record &r2) {
+        return r1.totalNsecs > r2.totalNsecs;
+    });
+
+    return records;
+}
+
+QList<DWidgetProfiler::Record> DWidgetProfiler::classRecords() const
+{
+    D_DC(DWidgetProfiler);
+
+    return toRecords(d->classEntries, [](const QMetaObject *metaObject, Record &record) {
+        record.className = QString::fromLatin1(metaObject->className());
+    });
+}
+
+QList<DWidgetProfiler::Record> DWidgetProfiler::objectRecords() const
+{
+    D_DC(DWidgetProfiler);
+
+    return toRecords(d->objectEntries, [](const QPair<const QMetaObject *, QString> &key, Record &record) {
+        record.className = QString::fromLatin1(key.first->className());
+        record.objectName = key.second;
+    });
+}
+
+QVector<qint64> DWidgetProfiler::histogramBounds()
+{
+    QVector<qint64> bounds;
+    for (qint64 bound = 16; bounds.size() < DWidgetProfilerPrivate::HistogramBuckets - 1; bound *= 4)
+        bounds.append(bound);
+
+    return bounds;
+}
+
+static QJsonArray recordsToJson(const QList<DWidgetProfiler::Record> &records, bool withObjectName)
+{
+    const QMetaEnum eventEnum = QMetaEnum::fromType<DWidgetProfiler::EventType>();
+    QJsonArray array;
+    for (const DWidgetProfiler::Record &record : records) {
+        QJsonObject object;
+        object.insert("class", record.className);
+        if (withObjectName)
+            object.insert("objectName", record.objectName);
+        object.insert("event", QString::fromLatin1(eventEnum.valueToKey(record.eventType)));
+        object.insert("count", double(record.count));
+        object.insert("totalUs", record.totalNsecs / 1000.0);
+        object.insert("averageUs", record.totalNsecs / 1000.0 / record.count);
+        object.insert("maxUs", record.maxNsecs / 1000.0);
+
+        QJsonArray histogram;
+        for (quint64 value : record.histogram)
+            histogram.append(double(value));
+        object.insert("histogram", histogram);
+        array.append(object);
+    }
+
+    return array;
+}
+
+QByteArray DWidgetProfiler::toJson() const
+{
+    D_DC(DWidgetProfiler);
+
+    QJsonArray bounds;
+    for (qint64 bound : histogramBounds())
+        bounds.append(double(bound));
+
+    QJsonObject root;
+    root.insert("enabled", isEnabled());
+    root.insert("slowThresholdUs", d->slowThreshold);
+    root.insert("histogramBoundsUs", bounds);
+    root.insert("classes", recordsToJson(classRecords(), false));
+    root.insert("objects", recordsToJson(objectRecords(), true));
+
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+bool DWidgetProfiler::dumpJson(const QString &fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "DWidgetProfiler: failed to open" << fileName << file.errorString();
+        return false;
+    }
+
+    return file.write(toJson()) >= 0;
+}
+
+void DWidgetProfiler::reset()
+{
+    D_D(DWidgetProfiler);
+
+    d->classEntries.clear();
+    d->objectEntries.clear();
+}
+
+DWIDGET_END_NAMESPACE
@@ -10,10 +10,15 @@
 #include <DApplication>
 #include <DPathBuf>
 
+#include <QFuture>
 #include <QIcon>
+#include <QLocale>
 #include <QPointer>
+#include <QHash>
 
 class QLocalServer;
+class QTimer;
+class QPlatformInputContext;
 class QTranslator;
 
 DWIDGET_BEGIN_NAMESPACE
@@ -22,6 +27,15 @@ DCORE_USE_NAMESPACE
 class DAboutDialog;
 class DFeatureDisplayDialog;
 
+// 构造时在后台线程预先加载的 dtkwidget 翻译
+struct DtkTranslatorPrefetch
+{
+    QTranslator *translator = nullptr;
+    QLocale locale;
+    qint64 startNsecs = 0;
+    qint64 durationNsecs = 0;
+};
+
 class DApplicationPrivate : public DObjectPrivate
 {
 
@@ -41,16 +55,27 @@ public:
     bool setSingleInstanceByDbus(const QString &key);
 #endif
 
+    static QList<QString> dtkTranslateDirs();
     bool loadDtkTranslator(QList<QLocale> localeFallback);
+    void startDeferredStartupWork();
     void _q_onNewInstanceStarted();
 
     // 为控件适应当前虚拟键盘的位置
     void doAcclimatizeVirtualKeyboard(QWidget *window, QWidget *widget, bool allowResizeContentsMargins);
     void acclimatizeVirtualKeyboardForFocusWidget(bool allowResizeContentsMargins);
+    void scheduleVirtualKeyboardAdjustment();
+    void restoreActiveInputWindow();
+    void reapplyVirtualKeyboardPan(QEvent *event);
+    QPlatformInputContext *platformInputContext() const;
     void _q_panWindowContentsForVirtualKeyboard();
     void _q_resizeWindowContentsForVirtualKeyboard();
     void _q_sizeModeChanged();
     void handleSizeModeChangeEvent(QWidget *widget, QEvent *event);
+    void collectSizeModeWidgets(QWidget *widget, QList<QPointer<QWidget>> &widgets);
+    void processSizeModeWidgets();
+    void finishSizeModeChange();
+    bool deferLayoutRequest(QObject *obj);
+    void restyleStaleWidget(QObject *obj);
 
     static bool isUserManualExists();
 public:
@@ -88,6 +113,27 @@ public:
     QPair<int, int> lastContentsMargins;
     QMargins activeInputWindowContentsMargins;
     QList<QWidget*> acclimatizeVirtualKeyboardWindows;
+    // 合并输入法的通知，每帧最多调整一次窗口
+    QTimer *virtualKeyboardTimer = nullptr;
+    // 只平移窗口的布局区域，不修改 contentsMargins 引起整个窗口重新布局
+    bool virtualKeyboardPanOnly = false;
+    // 平移模式下当前布局区域向上移动的距离，布局重新激活后需要再次应用
+    int virtualKeyboardPan = 0;
+    // 不为空时代替平台的输入法上下文，用于测试
+    QPlatformInputContext *inputContextOverride = nullptr;
+
+    // 尺寸模式切换时分批更新可见控件，隐藏的控件在下次显示时再更新
+    QTimer *sizeModeTimer = nullptr;
+    QList<QPointer<QWidget>> pendingSizeModeWidgets;
+    int pendingSizeModeIndex = 0;
+    // 控件销毁后地址可能被复用，以 QPointer 区分是否仍是原来的控件
+    QHash<QWidget *, QPointer<QWidget>> staleSizeModeWidgets;
+    bool sizeModeUpdating = false;
+    QHash<QWidget *, QPointer<QWidget>> deferredLayoutRequests;
+
+    // 启动时在后台执行的工作
+    QFuture<DtkTranslatorPrefetch> dtkTranslatorFuture;
+    bool dtkTranslatorPrefetching = false;
 };
 
 DWIDGET_END_NAMESPACE
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DCACHEREGISTRY_P_H
+#define DCACHEREGISTRY_P_H
+
+#include "dcacheregistry.h"
+
+#include <DObjectPrivate>
+
+#include <QElapsedTimer>
+#include <QHash>
+
+#include <list>
+
+class QSocketNotifier;
+class QTimer;
+
+DWIDGET_BEGIN_NAMESPACE
+
+class DCacheRegistryPrivate : public DTK_CORE_NAMESPACE::DObjectPrivate
+{
+public:
+    struct Entry {
+        QString cacheName;
+        qint64 cost = 0;
+        DCacheRegistry::Evictor evictor;
+        std::list<quint64>::iterator lruPosition;
+    };
+
+    struct CacheCounters {
+        quint64 accesses = 0;
+        quint64 evictions = 0;
+        qint64 evictedCost = 0;
+    };
+
+    explicit DCacheRegistryPrivate(DCacheRegistry *qq);
+    ~DCacheRegistryPrivate() override;
+
+    static qint64 defaultBudget();
+
+    qint64 evictUntil(qint64 targetCost, quint64 keepId = 0);
+    void startPressureMonitor();
+    void readPressure();
+
+    QHash<quint64, Entry> entries;
+    // 头部为最久未使用的条目
+    std::list<quint64> lru;
+    QHash<QString, CacheCounters> counters;
+    quint64 nextId = 1;
+    qint64 budget = 0;
+    qint64 totalCost = 0;
+    bool evicting = false;
+
+    bool pressureMonitorStarted = false;
+    int pressureFd = -1;
+    QSocketNotifier *pressureNotifier = nullptr;
+    QTimer *pressureTimer = nullptr;
+    QElapsedTimer lastPressure;
+
+    D_DECLARE_PUBLIC(DCacheRegistry)
+};
+
+DWIDGET_END_NAMESPACE
+
+#endif // DCACHEREGISTRY_P_H
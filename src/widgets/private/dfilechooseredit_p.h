@@ -9,23 +9,67 @@
 #include <DFileChooserEdit>
 #include <DImageButton>
 
+#include <QAtomicInt>
+#include <QSharedPointer>
+
+QT_BEGIN_NAMESPACE
+class QCompleter;
+class QStringListModel;
+class QTimer;
+QT_END_NAMESPACE
+
 DWIDGET_BEGIN_NAMESPACE
 
+// 在工作线程中检查输入路径的结果，directory 非空时附带该目录的列表，目录项以 "/" 结尾
+struct DFileChooserPathCheck
+{
+    QString path;
+    bool checked = false;
+    bool exists = false;
+    bool isDir = false;
+    bool parentExists = false;
+
+    QString directory;
+    QStringList entries;
+    bool listed = false;
+    bool truncated = false;
+};
+
 class DFileChooserEditPrivate : DLineEditPrivate
 {
     Q_DECLARE_PUBLIC(DFileChooserEdit)
 
 public:
     DFileChooserEditPrivate(DFileChooserEdit *q);
+    ~DFileChooserEditPrivate() override;
 
     void init();
 
+    static QString directoryOf(const QString &path);
+    static DFileChooserPathCheck checkPath(const QString &path, bool check, const QString &directory, int limit,
+                                           int generation, const QSharedPointer<QAtomicInt> &currentGeneration);
+    void startPathCheck();
+    void applyPathCheck(const DFileChooserPathCheck &result);
+    void applyListing(const QString &directory, const QStringList &entries);
+    void updatePathAlert(const DFileChooserPathCheck &result);
+
 public:
     void _q_showFileChooserDialog();
 
     DFileChooserEdit::DialogDisplayPosition dialogDisplayPosition;
 
     QFileDialog *dialog = nullptr;
+
+    QCompleter *completer = nullptr;
+    QStringListModel *completionModel = nullptr;
+    QTimer *checkTimer = nullptr;
+    // 每次检查递增，工作线程发现与自己的编号不同时放弃列目录
+    QSharedPointer<QAtomicInt> checkGeneration;
+    QString listedDirectory;
+    int maxCompletionCount;
+    bool completionEnabled = true;
+    bool pathValidationEnabled = false;
+    bool pathAlert = false;
 };
 
 DWIDGET_END_NAMESPACE
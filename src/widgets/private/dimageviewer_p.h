@@ -36,6 +36,8 @@ public:
     ImageType detectImageType(const QString &fileName) const;
     void resetItem(ImageType type);
     QImage loadImage(const QString &fileName, ImageType type) const;
+    static QImage transformImage(const QImage &image, const QRect &cropRect, int angle);
+    static QImage rotateImageOrthogonal(const QImage &image, const QRect &rect, int angle);
 
     void updateItemAndSceneRect();
     bool rotatable() const;
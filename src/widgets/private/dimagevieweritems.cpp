@@ -3,16 +3,23 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "dimagevieweritems_p.h"
+#include "dcacheregistry.h"
 
 #include <QObject>
-#include <QMovie>
+#include <QImageReader>
+#include <QTimer>
 #include <QPainter>
 #include <QStyleOption>
 #include <QGraphicsView>
 #include <QGraphicsScene>
 #include <QGraphicsSceneMouseEvent>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <qmath.h>
 #include <DIconTheme>
 
+#include <cmath>
+
 DGUI_USE_NAMESPACE
 DWIDGET_BEGIN_NAMESPACE
 
@@ -29,12 +36,18 @@ DGraphicsPixmapItem::DGraphicsPixmapItem(const QPixmap &pixmap, QGraphicsItem *p
 DGraphicsPixmapItem::~DGraphicsPixmapItem()
 {
     prepareGeometryChange();
+
+    if (cacheId) {
+        DCacheRegistry::instance()->unregisterEntry(cacheId);
+    }
 }
 
 void DGraphicsPixmapItem::setPixmap(const QPixmap &pixmap)
 {
     cachePixmap = qMakePair(cachePixmap.first, pixmap);
     QGraphicsPixmapItem::setPixmap(pixmap);
+    // Shares the data with the item pixmap, costs nothing extra.
+    updateCacheCost(0);
 }
 
 void DGraphicsPixmapItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
@@ -49,9 +62,13 @@ void DGraphicsPixmapItem::paint(QPainter *painter, const QStyleOptionGraphicsIte
             QPixmap pixmap;
             if (qIsNull(cachePixmap.first - ts.m11())) {
                 pixmap = cachePixmap.second;
+                if (cacheId) {
+                    DCacheRegistry::instance()->touch(cacheId);
+                }
             } else {
                 pixmap = currentPixmap.transformed(painter->transform(), transformationMode());
                 cachePixmap = qMakePair(ts.m11(), pixmap);
+                updateCacheCost(qint64(pixmap.width()) * pixmap.height() * pixmap.depth() / 8);
             }
 
             pixmap.setDevicePixelRatio(painter->device()->devicePixelRatioF());
@@ -66,18 +83,52 @@ void DGraphicsPixmapItem::paint(QPainter *painter, const QStyleOptionGraphicsIte
     }
 }
 
+void DGraphicsPixmapItem::updateCacheCost(qint64 cost)
+{
+    if (!cacheId) {
+        if (cost <= 0) {
+            return;
+        }
+
+        cacheId = DCacheRegistry::instance()->registerEntry(QStringLiteral("DGraphicsPixmapItem"), 0, [this]() {
+            cachePixmap = qMakePair(qreal(0), QPixmap());
+        });
+    }
+
+    DCacheRegistry::instance()->updateCost(cacheId, cost);
+}
+
+// Animations under this size are decoded once and reused across loops.
+static const qint64 MaxMovieCacheCost = 64 * 1024 * 1024;
+// Frames decoded per job, and frames queued ahead when the animation is streamed.
+static const int MovieDecodeBatch = 4;
+static const int MovieQueueLength = 8;
+static const int DefaultFrameDelay = 100;
+
+struct DGraphicsMovieItem::MovieDecoder
+{
+    QString fileName;
+    bool restartAtEnd = false;
+    int skipFrames = 0;
+    int frameIndex = 0;
+    QScopedPointer<QImageReader> reader;
+    QAtomicInt canceled;
+};
+
 DGraphicsMovieItem::DGraphicsMovieItem(QGraphicsItem *parent)
     : QGraphicsPixmapItem(parent)
 {
-    movie = new QMovie;
-    QObject::connect(movie, &QMovie::frameChanged, this, &DGraphicsMovieItem::onMovieFrameChanged);
+    frameTimer = new QTimer(this);
+    frameTimer->setSingleShot(true);
+    QObject::connect(frameTimer, &QTimer::timeout, this, &DGraphicsMovieItem::onFrameTimeout);
 }
 
 DGraphicsMovieItem::DGraphicsMovieItem(const QString &fileName, QGraphicsItem *parent)
     : QGraphicsPixmapItem(fileName, parent)
 {
-    movie = new QMovie;
-    QObject::connect(movie, &QMovie::frameChanged, this, &DGraphicsMovieItem::onMovieFrameChanged);
+    frameTimer = new QTimer(this);
+    frameTimer->setSingleShot(true);
+    QObject::connect(frameTimer, &QTimer::timeout, this, &DGraphicsMovieItem::onFrameTimeout);
     setFileName(fileName);
 }
 
@@ -85,44 +136,339 @@ DGraphicsMovieItem::~DGraphicsMovieItem()
 {
     prepareGeometryChange();
 
-    movie->stop();
-    movie->deleteLater();
-    movie = nullptr;
-}
+    frameTimer->stop();
+    if (decoder) {
+        decoder->canceled.storeRelease(1);
+    }
 
-void DGraphicsMovieItem::onMovieFrameChanged()
-{
-    setPixmap(movie->currentPixmap());
+    if (frameCacheId) {
+        DCacheRegistry::instance()->unregisterEntry(frameCacheId);
+    }
 }
 
 void DGraphicsMovieItem::setFileName(const QString &fileName)
 {
-    movie->stop();
-    movie->setFileName(fileName);
-    movie->start();
+    if (decoder) {
+        decoder->canceled.storeRelease(1);
+    }
 
+    frameTimer->stop();
+    frames.clear();
+    framePixmaps.clear();
+    allFramesDecoded = false;
+    decoding = false;
+    waitingFrame = false;
+    playFinished = false;
+    currentFrame = -1;
+
+    // Only the first frame is decoded here, the others are decoded ahead on worker thread.
+    QImageReader reader(fileName);
+    const QSize size = reader.size();
+    const int imageCount = reader.imageCount();
+    const QImage firstImage = reader.read();
+    const int delay = reader.nextImageDelay();
+    currentDelay = delay > 0 ? delay : DefaultFrameDelay;
+    remainingLoops = reader.loopCount();
+    frameBytes = qint64(size.width()) * size.height() * 4;
+    keepAllFrames = imageCount > 0 && frameBytes * imageCount <= MaxMovieCacheCost;
+
+    decoder.reset(new MovieDecoder);
+    decoder->fileName = fileName;
+    decoder->restartAtEnd = !keepAllFrames;
+    decoder->skipFrames = 1;
+
+    const QPixmap firstPixmap = QPixmap::fromImage(firstImage);
+    if (keepAllFrames) {
+        frames.append(MovieFrame{QImage(), currentDelay, 0});
+        framePixmaps.append(firstPixmap);
+        currentFrame = 0;
+    }
+    setPixmap(firstPixmap);
+    updateFrameCacheCost();
+
+    updatePlaybackState();
     update();
 }
 
+bool DGraphicsMovieItem::isPlaying() const
+{
+    return frameTimer->isActive() || waitingFrame;
+}
+
+QVariant DGraphicsMovieItem::itemChange(GraphicsItemChange change, const QVariant &value)
+{
+    // Playback pauses while item is hidden or out of scene.
+    if (ItemVisibleHasChanged == change || ItemSceneHasChanged == change) {
+        updatePlaybackState();
+    }
+
+    return QGraphicsPixmapItem::itemChange(change, value);
+}
+
+bool DGraphicsMovieItem::canPlay() const
+{
+    return decoder && !playFinished && isVisible() && scene();
+}
+
+void DGraphicsMovieItem::updatePlaybackState()
+{
+    if (!canPlay()) {
+        frameTimer->stop();
+        waitingFrame = false;
+        return;
+    }
+
+    if (!isPlaying()) {
+        frameTimer->start(currentDelay);
+        decodeAhead();
+    }
+}
+
+void DGraphicsMovieItem::showFrame(const QPixmap &pixmap, int delay)
+{
+    setPixmap(pixmap);
+    currentDelay = delay;
+    frameTimer->start(currentDelay);
+}
+
+void DGraphicsMovieItem::decodeAhead()
+{
+    if (decoding || allFramesDecoded || !canPlay()) {
+        return;
+    }
+
+    if (!keepAllFrames && frames.size() >= MovieQueueLength) {
+        return;
+    }
+
+    decoding = true;
+    const QSharedPointer<MovieDecoder> source = decoder;
+    auto watcher = new QFutureWatcher<QPair<QList<MovieFrame>, bool>>(this);
+    QObject::connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, source]() {
+        const auto result = watcher->result();
+        onFramesDecoded(source.data(), result.first, result.second);
+        watcher->deleteLater();
+    });
+
+    watcher->setFuture(QtConcurrent::run([source]() {
+        QList<MovieFrame> decodedFrames;
+        bool atEnd = false;
+        while (decodedFrames.size() < MovieDecodeBatch && !source->canceled.loadAcquire()) {
+            if (!source->reader) {
+                source->reader.reset(new QImageReader(source->fileName));
+            }
+
+            const QImage image = source->reader->read();
+            if (image.isNull()) {
+                // Restart from the first frame for the next loop, stop on errors or if nothing was read.
+                source->reader.reset();
+                if (!source->restartAtEnd || 0 == source->frameIndex) {
+                    atEnd = true;
+                    break;
+                }
+                source->frameIndex = 0;
+                continue;
+            }
+
+            const int index = source->frameIndex++;
+            const int delay = source->reader->nextImageDelay();
+            if (source->skipFrames > 0) {
+                --source->skipFrames;
+                continue;
+            }
+
+            decodedFrames.append(MovieFrame{image.convertToFormat(QImage::Format_ARGB32_Premultiplied),
+                                            delay > 0 ? delay : DefaultFrameDelay,
+                                            index});
+        }
+
+        return qMakePair(decodedFrames, atEnd);
+    }));
+}
+
+void DGraphicsMovieItem::onFramesDecoded(MovieDecoder *source, const QList<MovieFrame> &decodedFrames, bool atEnd)
+{
+    if (source != decoder.data()) {
+        return;
+    }
+
+    decoding = false;
+    frames.append(decodedFrames);
+    allFramesDecoded = atEnd;
+    updateFrameCacheCost();
+
+    if (waitingFrame) {
+        onFrameTimeout();
+    } else {
+        decodeAhead();
+    }
+}
+
+void DGraphicsMovieItem::onFrameTimeout()
+{
+    waitingFrame = false;
+
+    if (keepAllFrames) {
+        int nextFrame = currentFrame + 1;
+        if (nextFrame >= frames.size()) {
+            if (!allFramesDecoded) {
+                waitingFrame = true;
+                decodeAhead();
+                return;
+            }
+
+            if (0 == remainingLoops) {
+                playFinished = true;
+                return;
+            }
+
+            remainingLoops = remainingLoops > 0 ? remainingLoops - 1 : remainingLoops;
+            nextFrame = 0;
+        }
+
+        // Frames are uploaded once, next loops reuse the pixmaps.
+        if (framePixmaps.size() <= nextFrame) {
+            framePixmaps.resize(nextFrame + 1);
+        }
+        MovieFrame &frame = frames[nextFrame];
+        if (!frame.image.isNull()) {
+            framePixmaps[nextFrame] = QPixmap::fromImage(frame.image);
+            frame.image = QImage();
+        }
+
+        currentFrame = nextFrame;
+        showFrame(framePixmaps.at(nextFrame), frame.delay);
+        if (frameCacheId) {
+            DCacheRegistry::instance()->touch(frameCacheId);
+        }
+    } else {
+        if (frames.isEmpty()) {
+            waitingFrame = !allFramesDecoded;
+            decodeAhead();
+            return;
+        }
+
+        const MovieFrame frame = frames.takeFirst();
+        if (0 == frame.index) {
+            if (0 == remainingLoops) {
+                playFinished = true;
+                frames.clear();
+                return;
+            }
+            remainingLoops = remainingLoops > 0 ? remainingLoops - 1 : remainingLoops;
+        }
+
+        currentFrame = frame.index;
+        showFrame(QPixmap::fromImage(frame.image), frame.delay);
+    }
+
+    decodeAhead();
+}
+
+void DGraphicsMovieItem::updateFrameCacheCost()
+{
+    const qint64 cost = keepAllFrames ? frames.size() * frameBytes : 0;
+    if (!frameCacheId) {
+        if (cost <= 0) {
+            return;
+        }
+
+        frameCacheId = DCacheRegistry::instance()->registerEntry(QStringLiteral("DGraphicsMovieItem"), 0, [this]() {
+            releaseFrameCache();
+        });
+    }
+
+    DCacheRegistry::instance()->updateCost(frameCacheId, cost);
+}
+
+void DGraphicsMovieItem::releaseFrameCache()
+{
+    if (!keepAllFrames || !decoder) {
+        return;
+    }
+
+    // Continue after the current frame, the following frames are streamed instead of kept.
+    const int nextFrame = currentFrame + 1;
+    const bool atLastFrame = allFramesDecoded && nextFrame >= frames.size();
+    const QString fileName = decoder->fileName;
+    decoder->canceled.storeRelease(1);
+
+    keepAllFrames = false;
+    frames.clear();
+    framePixmaps.clear();
+    allFramesDecoded = false;
+    decoding = false;
+
+    decoder.reset(new MovieDecoder);
+    decoder->fileName = fileName;
+    decoder->restartAtEnd = true;
+    decoder->skipFrames = atLastFrame ? 0 : nextFrame;
+
+    if (isPlaying()) {
+        decodeAhead();
+    }
+}
+
+// Zoom levels are power of 2 exponents, 2^6 covers the max scale factor with hidpi.
+static const int MinRasterLevel = -6;
+static const int MaxRasterLevel = 6;
+// Rasters up to this size are cached as a single image, larger ones are split into tiles.
+static const int FullRasterSide = 2048;
+static const int RasterTileSide = 512;
+static const qint64 MaxRasterCost = 96 * 1024 * 1024;
+
+static inline qreal rasterScale(int level)
+{
+    return std::ldexp(1.0, level);
+}
+
+static inline QSize rasterSize(const QSizeF &size, int level)
+{
+    const qreal scale = rasterScale(level);
+    return QSize(qMax(1, qCeil(size.width() * scale)), qMax(1, qCeil(size.height() * scale)));
+}
+
+static inline quint64 rasterTileKey(int level, quint32 index)
+{
+    return (quint64(quint32(level - MinRasterLevel)) << 32) | index;
+}
+
 DGraphicsSVGItem::DGraphicsSVGItem(QGraphicsItem *parent)
     : QGraphicsObject(parent)
+    , rasterGeneration(new QAtomicInt(0))
 {
     renderer = new DSvgRenderer(this);
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
 }
 
 DGraphicsSVGItem::DGraphicsSVGItem(const QString &fileName, QGraphicsItem *parent)
     : QGraphicsObject(parent)
+    , svgFileName(fileName)
+    , rasterGeneration(new QAtomicInt(0))
 {
     renderer = new DSvgRenderer(this);
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
     renderer->load(fileName);
     updateDefaultSize();
 }
 
+DGraphicsSVGItem::~DGraphicsSVGItem()
+{
+    // Stop running raster jobs, the results will be dropped.
+    rasterGeneration->ref();
+
+    if (rasterCacheId) {
+        DCacheRegistry::instance()->unregisterEntry(rasterCacheId);
+    }
+}
+
 void DGraphicsSVGItem::setFileName(const QString &fileName)
 {
     // Clear cached image.
     CacheMode mode = cacheMode();
     setCacheMode(QGraphicsItem::NoCache);
+    clearRasterCache();
+    svgFileName = fileName;
     renderer->load(fileName);
     updateDefaultSize();
 
@@ -137,13 +483,56 @@ QRectF DGraphicsSVGItem::boundingRect() const
 
 void DGraphicsSVGItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
-    Q_UNUSED(option);
     Q_UNUSED(widget);
 
     if (!renderer->isValid()) {
         return;
     }
-    renderer->render(painter, imageRect);
+
+    const QRectF exposedRect = option->exposedRect.intersected(imageRect);
+    if (exposedRect.isEmpty()) {
+        return;
+    }
+
+    const qreal levelOfDetail = option->levelOfDetailFromTransform(painter->worldTransform());
+    currentLevel = rasterLevel(levelOfDetail * painter->device()->devicePixelRatioF());
+    exposedTiles = rasterTilesInRect(currentLevel, exposedRect);
+
+    const QHash<quint32, QImage> levelCache = rasterCache.value(currentLevel);
+    QList<quint32> missingTiles;
+    for (quint32 index : exposedTiles) {
+        if (!levelCache.contains(index)) {
+            missingTiles.append(index);
+        }
+    }
+
+    painter->save();
+    painter->setClipRect(exposedRect, Qt::IntersectClip);
+    painter->setRenderHint(QPainter::SmoothPixmapTransform);
+
+    if (!missingTiles.isEmpty()) {
+        // Keep showing the other cached levels until the sharp one is ready,
+        // the base level always covers the whole image.
+        const int baseLevel = baseRasterLevel();
+        if (!rasterCache.contains(baseLevel)) {
+            requestRasterTiles(baseLevel, {0});
+        }
+
+        for (auto it = rasterCache.constBegin(); it != rasterCache.constEnd(); ++it) {
+            if (it.key() != currentLevel) {
+                drawRasterLevel(painter, it.key(), rasterTilesInRect(it.key(), exposedRect));
+            }
+        }
+
+        requestRasterTiles(currentLevel, missingTiles);
+    }
+
+    drawRasterLevel(painter, currentLevel, exposedTiles);
+    painter->restore();
+
+    if (rasterCacheId) {
+        DCacheRegistry::instance()->touch(rasterCacheId);
+    }
 }
 
 int DGraphicsSVGItem::type() const
@@ -151,6 +540,11 @@ int DGraphicsSVGItem::type() const
     return Type;
 }
 
+qint64 DGraphicsSVGItem::rasterCacheCost() const
+{
+    return rasterCost;
+}
+
 void DGraphicsSVGItem::updateDefaultSize()
 {
     QRectF bounds = QRectF(QPointF(0, 0), renderer->defaultSize());
@@ -161,6 +555,235 @@ void DGraphicsSVGItem::updateDefaultSize()
     }
 }
 
+void DGraphicsSVGItem::clearRasterCache()
+{
+    rasterGeneration->ref();
+    rasterCache.clear();
+    pendingTiles.clear();
+    exposedTiles.clear();
+    rasterCost = 0;
+    updateRasterCacheCost();
+}
+
+int DGraphicsSVGItem::rasterLevel(qreal levelOfDetail) const
+{
+    if (levelOfDetail <= 0) {
+        return 0;
+    }
+
+    // Round up to the next power of 2, ignore tiny float errors (e.g. 1.0000001).
+    return qBound(MinRasterLevel, qCeil(std::log2(levelOfDetail) - 0.01), MaxRasterLevel);
+}
+
+int DGraphicsSVGItem::baseRasterLevel() const
+{
+    const qreal side = qMax(imageRect.width(), imageRect.height());
+    if (side <= 0) {
+        return 0;
+    }
+
+    return qBound(MinRasterLevel, qFloor(std::log2(FullRasterSide / side)), MaxRasterLevel);
+}
+
+int DGraphicsSVGItem::rasterTileSize(int level) const
+{
+    const QSize size = rasterSize(imageRect.size(), level);
+    if (size.width() <= FullRasterSide && size.height() <= FullRasterSide) {
+        return qMax(size.width(), size.height());
+    }
+
+    return RasterTileSide;
+}
+
+QRectF DGraphicsSVGItem::rasterTileRect(int level, quint32 index) const
+{
+    const int tileSize = rasterTileSize(level);
+    const QRect pixelRect = QRect((index >> 16) * tileSize, (index & 0xffff) * tileSize, tileSize, tileSize)
+                                .intersected(QRect(QPoint(0, 0), rasterSize(imageRect.size(), level)));
+    const qreal scale = rasterScale(level);
+
+    return QRectF(pixelRect.x() / scale, pixelRect.y() / scale, pixelRect.width() / scale, pixelRect.height() / scale);
+}
+
+QList<quint32> DGraphicsSVGItem::rasterTilesInRect(int level, const QRectF &rect) const
+{
+    QList<quint32> tiles;
+    const QSize size = rasterSize(imageRect.size(), level);
+    const qreal tileSize = rasterTileSize(level) / rasterScale(level);
+    const int columnCount = (size.width() + rasterTileSize(level) - 1) / rasterTileSize(level);
+    const int rowCount = (size.height() + rasterTileSize(level) - 1) / rasterTileSize(level);
+
+    const int left = qBound(0, qFloor(rect.left() / tileSize), columnCount - 1);
+    const int right = qBound(0, qCeil(rect.right() / tileSize) - 1, columnCount - 1);
+    const int top = qBound(0, qFloor(rect.top() / tileSize), rowCount - 1);
+    const int bottom = qBound(0, qCeil(rect.bottom() / tileSize) - 1, rowCount - 1);
+
+    for (int column = left; column <= right; ++column) {
+        for (int row = top; row <= bottom; ++row) {
+            tiles.append((quint32(column) << 16) | quint32(row));
+        }
+    }
+
+    return tiles;
+}
+
+void DGraphicsSVGItem::drawRasterLevel(QPainter *painter, int level, const QList<quint32> &tiles) const
+{
+    const QHash<quint32, QImage> levelCache = rasterCache.value(level);
+    if (levelCache.isEmpty()) {
+        return;
+    }
+
+    for (quint32 index : tiles) {
+        auto it = levelCache.constFind(index);
+        if (it != levelCache.constEnd()) {
+            painter->drawImage(rasterTileRect(level, index), it.value());
+        }
+    }
+}
+
+void DGraphicsSVGItem::requestRasterTiles(int level, const QList<quint32> &tiles)
+{
+    QList<quint32> jobTiles;
+    for (quint32 index : tiles) {
+        const quint64 key = rasterTileKey(level, index);
+        if (!pendingTiles.contains(key)) {
+            pendingTiles.insert(key);
+            jobTiles.append(index);
+        }
+    }
+
+    if (jobTiles.isEmpty()) {
+        return;
+    }
+
+    const QString fileName = svgFileName;
+    const QSizeF imageSize = imageRect.size();
+    const int tileSize = rasterTileSize(level);
+    const int generation = rasterGeneration->loadAcquire();
+    const QSharedPointer<QAtomicInt> liveGeneration = rasterGeneration;
+
+    // Rasterize on a worker thread with its own renderer, the item repaints once the tiles arrive.
+    auto watcher = new QFutureWatcher<QList<RasterTile>>(this);
+    QObject::connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, generation, level, jobTiles]() {
+        // The result is empty if the worker failed to load the file, the tiles must not stay pending.
+        if (generation == rasterGeneration->loadAcquire()) {
+            for (quint32 index : jobTiles) {
+                pendingTiles.remove(rasterTileKey(level, index));
+            }
+        }
+        insertRasterTiles(generation, watcher->result());
+        watcher->deleteLater();
+    });
+
+    watcher->setFuture(QtConcurrent::run([=]() {
+        QList<RasterTile> result;
+        DSvgRenderer workerRenderer;
+        if (!workerRenderer.load(fileName)) {
+            return result;
+        }
+
+        const QSize size = rasterSize(imageSize, level);
+        const QRectF renderRect(QPointF(0, 0), QSizeF(size));
+        for (quint32 index : jobTiles) {
+            if (liveGeneration->loadAcquire() != generation) {
+                break;
+            }
+
+            const QRect tileRect = QRect((index >> 16) * tileSize, (index & 0xffff) * tileSize, tileSize, tileSize)
+                                       .intersected(QRect(QPoint(0, 0), size));
+            QImage image(tileRect.size(), QImage::Format_ARGB32_Premultiplied);
+            image.fill(Qt::transparent);
+
+            QPainter painter(&image);
+            painter.setRenderHint(QPainter::Antialiasing);
+            painter.translate(-tileRect.topLeft());
+            workerRenderer.render(&painter, renderRect);
+            painter.end();
+
+            result.append(RasterTile{level, index, image});
+        }
+
+        return result;
+    }));
+}
+
+void DGraphicsSVGItem::insertRasterTiles(int generation, const QList<RasterTile> &tiles)
+{
+    if (tiles.isEmpty() || generation != rasterGeneration->loadAcquire()) {
+        return;
+    }
+
+    for (const RasterTile &tile : tiles) {
+        QImage &cached = rasterCache[tile.level][tile.index];
+        rasterCost += tile.image.sizeInBytes() - cached.sizeInBytes();
+        cached = tile.image;
+    }
+
+    trimRasterCache();
+    updateRasterCacheCost();
+    update();
+}
+
+void DGraphicsSVGItem::trimRasterCache()
+{
+    if (rasterCost <= MaxRasterCost) {
+        return;
+    }
+
+    // Drop the levels farthest from the one in use first, the base level is kept as fallback.
+    const int baseLevel = baseRasterLevel();
+    QList<int> levels = rasterCache.keys();
+    std::sort(levels.begin(), levels.end(), [this](int l1, int l2) {
+        return qAbs(l1 - currentLevel) > qAbs(l2 - currentLevel);
+    });
+
+    for (int level : levels) {
+        if (level == baseLevel || level == currentLevel) {
+            continue;
+        }
+
+        for (const QImage &image : rasterCache.value(level)) {
+            rasterCost -= image.sizeInBytes();
+        }
+        rasterCache.remove(level);
+
+        if (rasterCost <= MaxRasterCost) {
+            return;
+        }
+    }
+
+    // Still over budget while panning at high zoom, drop the tiles out of sight.
+    if (currentLevel != baseLevel && rasterCache.contains(currentLevel)) {
+        QHash<quint32, QImage> &levelCache = rasterCache[currentLevel];
+        for (auto it = levelCache.begin(); it != levelCache.end() && rasterCost > MaxRasterCost;) {
+            if (exposedTiles.contains(it.key())) {
+                ++it;
+            } else {
+                rasterCost -= it.value().sizeInBytes();
+                it = levelCache.erase(it);
+            }
+        }
+    }
+}
+
+void DGraphicsSVGItem::updateRasterCacheCost()
+{
+    if (!rasterCacheId) {
+        if (rasterCost <= 0) {
+            return;
+        }
+
+        // The rasters can be rendered again from the file, drop all of them under pressure.
+        rasterCacheId = DCacheRegistry::instance()->registerEntry(QStringLiteral("DGraphicsSVGItem"), 0, [this]() {
+            clearRasterCache();
+            update();
+        });
+    }
+
+    DCacheRegistry::instance()->updateCost(rasterCacheId, rasterCost);
+}
+
 DGraphicsCropItem::DGraphicsCropItem(QGraphicsItem *parent)
     : QGraphicsItem(parent)
 {
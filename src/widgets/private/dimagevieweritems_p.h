@@ -9,8 +9,14 @@
 #include <DSvgRenderer>
 
 #include <QGraphicsItem>
-
-class QMovie;
+#include <QHash>
+#include <QImage>
+#include <QMap>
+#include <QSet>
+#include <QSharedPointer>
+#include <QVector>
+
+class QTimer;
 class QGraphicsView;
 
 DWIDGET_BEGIN_NAMESPACE
@@ -28,7 +34,11 @@ protected:
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) Q_DECL_OVERRIDE;
 
 private:
+    void updateCacheCost(qint64 cost);
+
     QPair<qreal, QPixmap> cachePixmap;
+    // Entry in DCacheRegistry, the scaled pixmap is dropped when evicted.
+    quint64 cacheId = 0;
 };
 
 class DGraphicsMovieItem : public QObject, public QGraphicsPixmapItem
@@ -40,12 +50,47 @@ public:
     ~DGraphicsMovieItem() Q_DECL_OVERRIDE;
 
     void setFileName(const QString &fileName);
+    bool isPlaying() const;
+
+protected:
+    QVariant itemChange(GraphicsItemChange change, const QVariant &value) Q_DECL_OVERRIDE;
 
 private:
-    Q_SLOT void onMovieFrameChanged();
+    struct MovieFrame
+    {
+        QImage image;
+        int delay = 0;
+        int index = 0;
+    };
+    struct MovieDecoder;
+
+    bool canPlay() const;
+    void updatePlaybackState();
+    void showFrame(const QPixmap &pixmap, int delay);
+    void decodeAhead();
+    void onFramesDecoded(MovieDecoder *source, const QList<MovieFrame> &decodedFrames, bool atEnd);
+    Q_SLOT void onFrameTimeout();
+    void updateFrameCacheCost();
+    void releaseFrameCache();
 
 private:
-    QMovie *movie;
+    QSharedPointer<MovieDecoder> decoder;
+    QTimer *frameTimer = nullptr;
+    // The whole animation is kept and reused across loops when it fits the memory budget,
+    // otherwise frames is a short queue refilled by the decoder.
+    bool keepAllFrames = false;
+    QList<MovieFrame> frames;
+    QVector<QPixmap> framePixmaps;
+    qint64 frameBytes = 0;
+    // Entry in DCacheRegistry, kept frames fall back to streaming when evicted.
+    quint64 frameCacheId = 0;
+    bool allFramesDecoded = false;
+    bool decoding = false;
+    bool waitingFrame = false;
+    bool playFinished = false;
+    int currentFrame = -1;
+    int currentDelay = 0;
+    int remainingLoops = -1;
 };
 
 class DGraphicsSVGItem : public QGraphicsObject
@@ -53,6 +98,7 @@ class DGraphicsSVGItem : public QGraphicsObject
 public:
     explicit DGraphicsSVGItem(QGraphicsItem *parent = nullptr);
     explicit DGraphicsSVGItem(const QString &fileName, QGraphicsItem *parent = nullptr);
+    ~DGraphicsSVGItem() Q_DECL_OVERRIDE;
 
     void setFileName(const QString &fileName);
 
@@ -62,12 +108,45 @@ public:
     enum { Type = QGraphicsItem::UserType + 1 };
     int type() const Q_DECL_OVERRIDE;
 
+    qint64 rasterCacheCost() const;
+
 private:
     void updateDefaultSize();
 
+    // Raster cache, tiles are keyed by zoom level (power of 2 exponent) and tile index.
+    struct RasterTile
+    {
+        int level = 0;
+        quint32 index = 0;
+        QImage image;
+    };
+
+    void clearRasterCache();
+    int rasterLevel(qreal levelOfDetail) const;
+    int baseRasterLevel() const;
+    int rasterTileSize(int level) const;
+    QRectF rasterTileRect(int level, quint32 index) const;
+    QList<quint32> rasterTilesInRect(int level, const QRectF &rect) const;
+    void drawRasterLevel(QPainter *painter, int level, const QList<quint32> &tiles) const;
+    void requestRasterTiles(int level, const QList<quint32> &tiles);
+    void insertRasterTiles(int generation, const QList<RasterTile> &tiles);
+    void trimRasterCache();
+    void updateRasterCacheCost();
+
 private:
     DGUI_NAMESPACE::DSvgRenderer *renderer = nullptr;
     QRectF imageRect;
+
+    QString svgFileName;
+    // Shared with the raster workers, so that outdated jobs stop early.
+    QSharedPointer<QAtomicInt> rasterGeneration;
+    int currentLevel = 0;
+    QList<quint32> exposedTiles;
+    qint64 rasterCost = 0;
+    // Entry in DCacheRegistry, the raster cache is cleared when evicted.
+    quint64 rasterCacheId = 0;
+    QMap<int, QHash<quint32, QImage>> rasterCache;
+    QSet<quint64> pendingTiles;
 };
 
 class DGraphicsCropItem : public QGraphicsItem
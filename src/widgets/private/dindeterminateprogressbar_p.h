@@ -8,19 +8,42 @@
 #include <DObjectPrivate>
 #include <DIndeterminateProgressbar>
 
-#include <QTimer>
+#include <QAbstractAnimation>
+
+class DIndeterminateProgressbarPrivate;
+
+// 由动画框架按帧驱动的时钟，暂停后再恢复时 currentTime 从暂停处继续
+class DIndeterminateProgressbarClock : public QAbstractAnimation
+{
+public:
+    DIndeterminateProgressbarClock(DIndeterminateProgressbarPrivate *d, QObject *parent);
+
+    int duration() const override;
+
+protected:
+    void updateCurrentTime(int currentTime) override;
+
+private:
+    DIndeterminateProgressbarPrivate *d;
+};
 
-class QPropertyAnimation;
 class DIndeterminateProgressbarPrivate : public DTK_CORE_NAMESPACE::DObjectPrivate
 {
 public:
     DIndeterminateProgressbarPrivate(DIndeterminateProgressbar *qq);
 
-    QWidget *m_sliderWidget;
-    QTimer *m_timer;
-    bool m_leftToRight;
-    QWidget *m_spotWidget;
-    QPropertyAnimation *m_animation;
+    bool isObscured() const;
+    void updateClock();
+    void updatePositions(int time);
+    void advance(int time);
+
+    QRect sliderRect() const;
+    QRect spotRect() const;
+
+    DIndeterminateProgressbarClock *m_clock;
+    int m_sliderX;
+    int m_spotX;
+    bool m_spotEnabled;
 
 private:
     D_DECLARE_PUBLIC(DIndeterminateProgressbar)
@@ -9,14 +9,36 @@
 
 #include <DObjectPrivate>
 
+#include <QPointer>
+
 DWIDGET_BEGIN_NAMESPACE
 
 class DPaletteHelperPrivate : public DTK_CORE_NAMESPACE::DObjectPrivate
 {
 public:
+    struct CacheEntry {
+        DPalette palette;
+        // 控件销毁后为空，避免地址被新控件复用时取到旧的数据
+        QPointer<QWidget> widget;
+        quint64 generation = 0;
+        // 通过 DPaletteHelper::setPalette 设置的调色板
+        bool explicitPalette = false;
+    };
+
     DPaletteHelperPrivate(DPaletteHelper *qq);
 
-    QHash<const QWidget *, DPalette> paletteCache;
+    static void notify(QObject *obj, QEvent *event);
+
+    const DPalette &resolve(const QWidget *widget);
+    void invalidate(QObject *obj, QEvent::Type type);
+    void removeDestroyedEntries();
+
+    QHash<const QWidget *, CacheEntry> paletteCache;
+    // 应用调色板改变或控件的父控件改变时递增，之前缓存的继承数据全部失效
+    quint64 generation = 1;
+    int purgeThreshold = 64;
+    // 没有 DApplication 时无法在 notify 中统一处理，仍然为控件安装事件过滤器
+    bool useEventFilter = false;
 
     D_DECLARE_PUBLIC(DPaletteHelper)
 };
@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DPRINTJOBSUBMITTER_P_H
+#define DPRINTJOBSUBMITTER_P_H
+
+#include <dtkwidget_global.h>
+
+#include <QAtomicInt>
+#include <QFuture>
+#include <QList>
+#include <QObject>
+#include <QPair>
+
+#include <functional>
+
+DWIDGET_BEGIN_NAMESPACE
+
+typedef QList<QPair<QByteArray, QByteArray>> PrintOptions;
+
+// 打印任务的提交接口，所有函数都在工作线程中调用
+class DPrintJobBackend
+{
+public:
+    virtual ~DPrintJobBackend() = default;
+
+    // 返回任务 id，失败时返回 0
+    virtual int createJob(const QByteArray &printer, const QByteArray &title, const PrintOptions &options) = 0;
+    virtual bool startDocument(const QByteArray &printer, int jobId, const QByteArray &docName) = 0;
+    virtual bool writeData(const char *data, qint64 size) = 0;
+    virtual bool finishDocument(const QByteArray &printer) = 0;
+    virtual void cancelJob(const QByteArray &printer, int jobId) = 0;
+    virtual QString errorString() const = 0;
+};
+
+// 通过 libcups 的 cupsCreateJob/cupsStartDocument/cupsWriteRequestData 分块上传文件
+class DCupsPrintJobBackend : public DPrintJobBackend
+{
+public:
+    int createJob(const QByteArray &printer, const QByteArray &title, const PrintOptions &options) override;
+    bool startDocument(const QByteArray &printer, int jobId, const QByteArray &docName) override;
+    bool writeData(const char *data, qint64 size) override;
+    bool finishDocument(const QByteArray &printer) override;
+    void cancelJob(const QByteArray &printer, int jobId) override;
+    QString errorString() const override;
+
+private:
+    bool resolve();
+
+    QFunctionPointer cupsCreateJob = nullptr;
+    QFunctionPointer cupsStartDocument = nullptr;
+    QFunctionPointer cupsWriteRequestData = nullptr;
+    QFunctionPointer cupsFinishDocument = nullptr;
+    QFunctionPointer cupsCancelJob2 = nullptr;
+    QFunctionPointer cupsLastErrorString = nullptr;
+    QString error;
+};
+
+class DPrintJobSubmitter : public QObject
+{
+    Q_OBJECT
+public:
+    typedef std::function<DPrintJobBackend *()> BackendFactory;
+
+    explicit DPrintJobSubmitter(QObject *parent = nullptr);
+    ~DPrintJobSubmitter() override;
+
+    static void setBackendFactory(const BackendFactory &factory);
+    static DPrintJobBackend *createBackend();
+
+    bool submit(const QString &printer, const QString &filePath, const QString &title, const PrintOptions &options);
+    bool isRunning() const;
+    void cancel();
+    void waitForFinished();
+
+    qint64 chunkSize() const;
+    void setChunkSize(qint64 size);
+
+Q_SIGNALS:
+    void progressChanged(qint64 bytesSent, qint64 bytesTotal);
+    void finished(bool success, const QString &errorString);
+
+private:
+    void run(DPrintJobBackend *backend, const QByteArray &printer, const QString &filePath,
+             const QByteArray &title, const PrintOptions &options);
+
+    QFuture<void> future;
+    QAtomicInt canceled;
+    qint64 chunk;
+};
+
+DWIDGET_END_NAMESPACE
+
+#endif // DPRINTJOBSUBMITTER_P_H
@@ -21,6 +21,7 @@
 
 class QVBoxLayout;
 class QButtonGroup;
+class QStringListModel;
 class DScrollArea;
 class QPrinter;
 DWIDGET_BEGIN_NAMESPACE
@@ -62,6 +63,9 @@ public:
     void initadvanceui();
     void initWaterMarkui();
     void initWaterSettings();
+    static const QStringList &watermarkFontFamilies();
+    void updateWatermarkFonts();
+    void setWatermarkFontList(const QStringList &fonts);
     void marginsLayout(bool adapted);
     void initdata();
     void initconnections();
@@ -178,6 +182,7 @@ public:
     DIconButton *waterColorBtn = nullptr;
     DLineEdit *waterTextEdit = nullptr; //文字水印内容
     DComboBox *fontCombo = nullptr;
+    QStringListModel *fontModel = nullptr;
     DSwitchButton *waterMarkBtn = nullptr;
     DFileChooserEdit *picPathEdit = nullptr; //图片水印路径
     QButtonGroup *waterTypeGroup = nullptr;
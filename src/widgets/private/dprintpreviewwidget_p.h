@@ -7,6 +7,7 @@
 
 #include <dprintpreviewwidget.h>
 #include "dframe_p.h"
+#include "dprintjobsubmitter_p.h"
 
 #include <DIconButton>
 
@@ -16,6 +17,7 @@
 #include <QPicture>
 #include <qmath.h>
 #include <QBasicTimer>
+#include <QPointer>
 
 DWIDGET_BEGIN_NAMESPACE
 
@@ -241,7 +243,6 @@ private:
     ContentItem *content;
 };
 
-typedef QList<QPair<QByteArray, QByteArray>> PrintOptions;
 class DPrintPreviewWidgetPrivate : public DFramePrivate
 {
 public:
@@ -317,6 +318,7 @@ public:
     RefreshMode refreshMode;
 
     QString printFromPath;
+    QPointer<DPrintJobSubmitter> printJob; // 正在提交的按路径打印任务
     DPrintPreviewWidget::PrintMode printMode;
     bool isAsynPreview;
     QVector<int> previewPages;
@@ -10,6 +10,7 @@
 
 #include <QLabel>
 #include <QPropertyAnimation>
+#include <QTimer>
 
 QT_BEGIN_NAMESPACE
 class QAudioInput;
@@ -27,6 +28,7 @@ public:
     ~DSearchEditPrivate();
 
     void init();
+    void requestSearch(bool force);
 
     void _q_toEditMode(bool focus);
     void _q_onVoiceActionTrigger(bool checked);
@@ -40,6 +42,11 @@ public:
     QWidget *iconWidget;
     QLabel *label;
     QPropertyAnimation *animation;
+    QMargins textMarginsBeforeAnimation;
+
+    // 文本停止变化一段时间后才请求搜索
+    QTimer *searchTimer = nullptr;
+    QString lastSearchText;
 
 #ifdef ENABLE_AI
     QAction *voiceAction = nullptr;
@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DSTARTUPTIMELINE_P_H
+#define DSTARTUPTIMELINE_P_H
+
+#include "dstartuptimeline.h"
+
+#include <DObjectPrivate>
+
+#include <QHash>
+#include <QList>
+#include <QPointer>
+
+class QTimer;
+
+DWIDGET_BEGIN_NAMESPACE
+
+class DStartupTimelinePrivate : public DTK_CORE_NAMESPACE::DObjectPrivate
+{
+public:
+    explicit DStartupTimelinePrivate(DStartupTimeline *qq);
+
+    static qint64 processElapsed();
+
+    void markFirstFrame();
+    void runDeferredTasks();
+
+    QList<DStartupTimeline::Phase> phases;
+    // 已开始但未结束的阶段
+    QHash<QString, qint64> runningPhases;
+    qint64 firstFrameNsecs = -1;
+    bool firstFramePending = false;
+    bool deferredTasksDone = false;
+    QList<QPair<QPointer<QObject>, std::function<void()>>> deferredTasks;
+    QTimer *fallbackTimer = nullptr;
+
+    D_DECLARE_PUBLIC(DStartupTimeline)
+};
+
+// 在作用域内记录一个启动阶段
+class DStartupPhaseScope
+{
+public:
+    explicit DStartupPhaseScope(const QString &name)
+        : name(name)
+    {
+        DStartupTimeline::instance()->beginPhase(name);
+    }
+
+    ~DStartupPhaseScope()
+    {
+        DStartupTimeline::instance()->endPhase(name);
+    }
+
+private:
+    Q_DISABLE_COPY(DStartupPhaseScope)
+    QString name;
+};
+
+DWIDGET_END_NAMESPACE
+
+#endif // DSTARTUPTIMELINE_P_H
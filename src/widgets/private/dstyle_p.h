@@ -0,0 +1,19 @@
+// SPDX-FileCopyrightText: 2024 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DSTYLE_P_H
+#define DSTYLE_P_H
+
+#include <dtkwidget_global.h>
+
+#include <QByteArray>
+
+DWIDGET_BEGIN_NAMESPACE
+
+// 程序的动态属性改变时由 DApplication 调用，刷新 DStyle 缓存的风格策略
+void dstylePreferencePropertyChanged(const QByteArray &name);
+
+DWIDGET_END_NAMESPACE
+
+#endif // DSTYLE_P_H
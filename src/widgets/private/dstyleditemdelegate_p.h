@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DSTYLEDITEMDELEGATE_P_H
+#define DSTYLEDITEMDELEGATE_P_H
+
+#include <dtkwidget_global.h>
+
+#include <QHash>
+#include <QModelIndex>
+#include <QObject>
+#include <QPointer>
+#include <QRect>
+
+class QAbstractItemView;
+class QAbstractItemModel;
+class QAction;
+
+DWIDGET_BEGIN_NAMESPACE
+
+// 记录视图中可见项上可点击的 action 区域，用于鼠标点击时查找 action
+class DViewItemActionHitIndex : public QObject
+{
+    Q_OBJECT
+public:
+    typedef QList<QPair<QAction *, QRect>> ActionRects;
+
+    explicit DViewItemActionHitIndex(QAbstractItemView *view, QObject *parent = nullptr);
+
+    void update(const QModelIndex &index, const QRect &itemRect, const ActionRects &actions);
+    ActionRects actions(const QModelIndex &index) const;
+    int count() const;
+    void clear();
+
+private:
+    void watchModel(const QAbstractItemModel *model);
+    void removeRange(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    void removeInvisible(const QModelIndex &keep);
+
+    QPointer<QAbstractItemView> view;
+    QPointer<QAbstractItemModel> model;
+    QList<QMetaObject::Connection> modelConnections;
+    // action 区域相对于所在项的左上角，滚动后仍然有效
+    QHash<QModelIndex, ActionRects> actionRects;
+    int limit;
+};
+
+DWIDGET_END_NAMESPACE
+
+#endif // DSTYLEDITEMDELEGATE_P_H
@@ -6,13 +6,34 @@
 #define DSWITCHBUTTON_P_H
 
 #include <DSwitchButton>
-#include <DDciIconPlayer>
+#include <DDciIcon>
 
 #include <DObjectPrivate>
 
+#include <QImage>
+#include <QSharedPointer>
+#include <QVariantAnimation>
+#include <QVector>
+
 DGUI_USE_NAMESPACE
 DWIDGET_BEGIN_NAMESPACE
 
+// 开关动画解码后的所有帧，主题、调色板、尺寸和缩放比相同的开关共用同一份
+class DSwitchButtonFrames
+{
+public:
+    static QSharedPointer<const DSwitchButtonFrames> frames(const QString &iconName, DDciIcon::Theme theme,
+                                                            const DDciIconPalette &palette, int iconSize,
+                                                            qreal devicePixelRatio);
+
+    int duration() const;
+    QImage image(int time) const;
+
+    QVector<QImage> images;
+    // 每一帧结束的时间，单位为毫秒
+    QVector<int> endTimes;
+};
+
 class DSwitchButtonPrivate : public DTK_CORE_NAMESPACE::DObjectPrivate
 {
 public:
@@ -20,6 +41,9 @@ public:
     ~DSwitchButtonPrivate();
 
     void init();
+    void setFrames(const QString &name, bool play);
+    void ensureFrames();
+    QImage currentImage();
 
 public:
     bool checked = false;
@@ -30,7 +54,11 @@ public:
     double animationStartValue = 0.0;
     double animationEndValue = 0.0;
 
-    DDciIconPlayer player;
+    QString iconName;
+    QSharedPointer<const DSwitchButtonFrames> frames;
+    qreal framesRatio = 0;
+    QVariantAnimation animation;
+    bool playedToEnd = false;
 
 public:
     D_DECLARE_PUBLIC(DSwitchButton)
@@ -15,6 +15,7 @@
 #include <QPropertyAnimation>
 #include <QPainter>
 #include <QBitmap>
+#include <QHash>
 
 #include <DIconTheme>
 #include <DListView>
@@ -33,8 +34,27 @@ static const char* TitlebarZoneDataFormat = "titlebarZoneWidget";
 static const char* SelectionZoneDataFormat = "selectionZoneWidget";
 static const char* DefaultZoneDataFormat = "defaultZoneWidget";
 
-static QBitmap bitmapOfMask(const QSize &size, const qreal radius)
+// 圆角遮罩只与尺寸和缩放比有关，缓存起来避免每次截图和拖拽时重新绘制
+static const int MaskCacheLimit = 32;
+typedef QHash<QString, QBitmap> MaskCache;
+Q_GLOBAL_STATIC(MaskCache, _d_maskCache)
+
+static void clearMaskCache()
+{
+    // QBitmap 需要在 QGuiApplication 析构前释放
+    _d_maskCache->clear();
+}
+
+static QBitmap bitmapOfMask(const QSize &size, const qreal devicePixelRatio, const qreal radius)
 {
+    static const bool cleanupRegistered = (qAddPostRoutine(clearMaskCache), true);
+    Q_UNUSED(cleanupRegistered)
+
+    const QString key = QStringLiteral("%1x%2@%3:%4").arg(size.width()).arg(size.height()).arg(devicePixelRatio).arg(radius);
+    auto it = _d_maskCache->constFind(key);
+    if (it != _d_maskCache->constEnd())
+        return it.value();
+
     QBitmap bitMap(size);
     bitMap.fill(Qt::color0);
 
@@ -42,7 +62,13 @@ static QBitmap bitmapOfMask(const QSize &size, const qreal radius)
     painter.setRenderHint(QPainter::SmoothPixmapTransform);
     painter.setPen(Qt::NoPen);
     painter.setBrush(Qt::color1);
-    painter.drawRoundedRect(bitMap.rect(), radius, radius);
+    // 遮罩按设备像素绘制，圆角半径随缩放比放大
+    painter.drawRoundedRect(bitMap.rect(), radius * devicePixelRatio, radius * devicePixelRatio);
+    painter.end();
+
+    if (_d_maskCache->size() >= MaskCacheLimit)
+        _d_maskCache->clear();
+    _d_maskCache->insert(key, bitMap);
 
     return bitMap;
 }
@@ -95,17 +121,58 @@ QString DragDropWidget::id() const
 
 void DragDropWidget::setScreenShotedView(QWidget *view)
 {
+    if (m_view == view)
+        return;
+
+    if (m_view)
+        m_view->removeEventFilter(this);
+
+    // 同一个工具重新创建的视图内容相同，是否重新截图由尺寸和内容变化决定
     m_view = view;
+    if (m_view) {
+        // 先完成 polish，避免其产生的样式事件被当作内容变化
+        m_view->ensurePolished();
+        m_view->installEventFilter(this);
+    }
 }
 
 void DragDropWidget::screenShot()
 {
-    if (m_view && m_view->size().width() > 0) {
-        this->setFixedSize(m_view->size());
-        auto pixmap = m_view->grab(m_view->rect());
-        pixmap.setMask(bitmapOfMask(pixmap.size(), 8));
-        this->setButtonIcon(pixmap, m_view->size());
+    if (!m_view || m_view->size().width() <= 0)
+        return;
+
+    // 视图的尺寸、缩放比和内容都没有变化时沿用上次的截图
+    const qreal ratio = m_view->devicePixelRatioF();
+    if (!m_screenShotDirty && m_screenShotSize == m_view->size() && qFuzzyCompare(m_screenShotRatio, ratio))
+        return;
+
+    this->setFixedSize(m_view->size());
+    auto pixmap = m_view->grab(m_view->rect());
+    pixmap.setMask(bitmapOfMask(pixmap.size(), pixmap.devicePixelRatioF(), 8));
+    this->setButtonIcon(pixmap, m_view->size());
+
+    m_screenShotSize = m_view->size();
+    m_screenShotRatio = ratio;
+    m_screenShotDirty = false;
+}
+
+bool DragDropWidget::eventFilter(QObject *watched, QEvent *event)
+{
+    if (watched == m_view) {
+        switch (event->type()) {
+        case QEvent::FontChange:
+        case QEvent::PaletteChange:
+        case QEvent::StyleChange:
+        case QEvent::EnabledChange:
+        case QEvent::LocaleChange:
+            m_screenShotDirty = true;
+            break;
+        default:
+            break;
+        }
     }
+
+    return DIconButton::eventFilter(watched, event);
 }
 
 void DragDropWidget::mousePressEvent(QMouseEvent *event)
@@ -133,7 +200,7 @@ void DragDropWidget::startDrag(const QPoint &pos)
 
     QPoint hotSpot = pos;
     QPixmap pixmap(this->grab());
-    pixmap.setMask(bitmapOfMask(pixmap.size(), 8));
+    pixmap.setMask(bitmapOfMask(pixmap.size(), pixmap.devicePixelRatioF(), 8));
     m_pixmap = pixmap;
     int index = -1;
     if (DTitlebarEditPanel *panel = qobject_cast<DTitlebarEditPanel *>(this->parentWidget())) {
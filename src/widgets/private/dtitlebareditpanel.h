@@ -46,6 +46,7 @@ public:
 
 protected:
     virtual void onIgnoreAction();
+    bool eventFilter(QObject *watched, QEvent *event) Q_DECL_OVERRIDE;
     void mousePressEvent(QMouseEvent *event) Q_DECL_OVERRIDE;
     void mouseMoveEvent(QMouseEvent *event) Q_DECL_OVERRIDE;
     void mouseReleaseEvent(QMouseEvent *event) Q_DECL_OVERRIDE;
@@ -65,6 +66,9 @@ private:
     QPoint m_startDrag;
     bool m_isClicked = false;
     QPointer<QWidget> m_view = nullptr;
+    QSize m_screenShotSize;
+    qreal m_screenShotRatio = 0;
+    bool m_screenShotDirty = true;
 };
 
 class TitlebarZoneWidget : public DragDropWidget
@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#ifndef DWIDGETPROFILER_P_H
+#define DWIDGETPROFILER_P_H
+
+#include "dwidgetprofiler.h"
+
+#include <DObjectPrivate>
+
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QHash>
+#include <QPointer>
+#include <QWidget>
+
+#include <atomic>
+
+class QTimer;
+
+DWIDGET_BEGIN_NAMESPACE
+
+class DWidgetProfilerOverlay : public QWidget
+{
+public:
+    explicit DWidgetProfilerOverlay(QWidget *window);
+
+    void highlight(QWidget *widget, qint64 nsecs);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    void expire();
+
+    struct Highlight {
+        QRect rect;
+        QString text;
+        qint64 expireTime;
+    };
+
+    QHash<QWidget *, Highlight> highlights;
+    QElapsedTimer clock;
+    QTimer *expireTimer;
+};
+
+class DWidgetProfilerPrivate : public DTK_CORE_NAMESPACE::DObjectPrivate
+{
+public:
+    enum { HistogramBuckets = 8 };
+
+    struct Entry {
+        quint64 count = 0;
+        qint64 totalNsecs = 0;
+        qint64 maxNsecs = 0;
+        quint64 histogram[HistogramBuckets] = {};
+    };
+
+    struct Entries {
+        Entry entries[DWidgetProfiler::EventTypeCount];
+    };
+
+    explicit DWidgetProfilerPrivate(DWidgetProfiler *qq);
+
+    static inline bool isActive()
+    {
+        return active.load(std::memory_order_relaxed);
+    }
+
+    static inline DWidgetProfilerPrivate *get(DWidgetProfiler *q)
+    {
+        return q->d_func();
+    }
+
+    static int eventIndex(QEvent::Type type);
+    static int histogramBucket(qint64 nsecs);
+    static void initFromEnvironment();
+
+    void record(const QMetaObject *metaObject, const QString &objectName, int event, qint64 nsecs);
+    void highlight(QWidget *widget, qint64 nsecs);
+
+    // 未启用时 DApplication::notify 只读取这一个标志
+    static std::atomic<bool> active;
+
+    bool overlayEnabled = false;
+    int slowThreshold = 16000;
+    QHash<const QMetaObject *, Entries> classEntries;
+    QHash<QPair<const QMetaObject *, QString>, Entries> objectEntries;
+    QHash<QWidget *, QPointer<DWidgetProfilerOverlay>> overlays;
+
+    D_DECLARE_PUBLIC(DWidgetProfiler)
+};
+
+/*
+ * 记录一次事件分发的耗时，嵌套分发(如布局中触发子控件 Resize)的耗时
+ * 只计入子控件，父控件记录的是自身耗时.
+ */
+class DWidgetProfilerScope
+{
+public:
+    DWidgetProfilerScope(QObject *object, QEvent *event);
+    ~DWidgetProfilerScope();
+
+private:
+    Q_DISABLE_COPY(DWidgetProfilerScope)
+
+    int event;
+    const QMetaObject *metaObject = nullptr;
+    QString objectName;
+    QPointer<QWidget> widget;
+    QElapsedTimer timer;
+    qint64 childNsecs = 0;
+    DWidgetProfilerScope *parent = nullptr;
+
+    static DWidgetProfilerScope *current;
+};
+
+DWIDGET_END_NAMESPACE
+
+#endif // DWIDGETPROFILER_P_H
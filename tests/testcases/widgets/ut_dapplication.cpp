@@ -0,0 +1,255 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QTest>
+#include <QWidget>
+#include <QLabel>
+#include <QLineEdit>
+#include <QVBoxLayout>
+#include <qpa/qplatforminputcontext.h>
+
+#include "dapplication.h"
+#include "private/dapplication_p.h"
+
+DWIDGET_USE_NAMESPACE
+
+class StyleChangeCounter : public QObject
+{
+public:
+    using QObject::QObject;
+
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (event->type() == QEvent::StyleChange)
+            styleChanges[watched] += 1;
+        return QObject::eventFilter(watched, event);
+    }
+
+    QHash<QObject *, int> styleChanges;
+};
+
+// 代替平台的输入法上下文，模拟虚拟键盘的显示状态和区域
+class StubInputContext : public QPlatformInputContext
+{
+public:
+    bool isValid() const override
+    {
+        return true;
+    }
+
+    bool isInputPanelVisible() const override
+    {
+        ++visibleQueries;
+        return visible;
+    }
+
+    QRectF keyboardRect() const override
+    {
+        return rect;
+    }
+
+    bool visible = false;
+    QRectF rect;
+    mutable int visibleQueries = 0;
+};
+
+class MoveCounter : public QObject
+{
+public:
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (event->type() == QEvent::Move)
+            ++moves;
+        return QObject::eventFilter(watched, event);
+    }
+
+    int moves = 0;
+};
+
+class ut_DApplication : public testing::Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    DApplicationPrivate *d = nullptr;
+    QWidget *window = nullptr;
+};
+
+void ut_DApplication::SetUp()
+{
+    d = qobject_cast<DApplication *>(qApp)->d_func();
+    window = new QWidget;
+    window->resize(300, 200);
+}
+
+void ut_DApplication::TearDown()
+{
+    delete window;
+    window = nullptr;
+    d->inputContextOverride = nullptr;
+    d->virtualKeyboardPanOnly = false;
+}
+
+TEST_F(ut_DApplication, testSizeModeHiddenWidgetsLazy)
+{
+    StyleChangeCounter counter;
+    auto layout = new QVBoxLayout(window);
+    auto visibleChild = new QWidget(window);
+    auto hiddenChild = new QWidget(window);
+    auto hiddenGrandChild = new QWidget(hiddenChild);
+    layout->addWidget(visibleChild);
+    layout->addWidget(hiddenChild);
+    hiddenChild->hide();
+
+    window->show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(window));
+
+    for (QWidget *w : {visibleChild, hiddenChild, hiddenGrandChild})
+        w->installEventFilter(&counter);
+
+    d->_q_sizeModeChanged();
+    EXPECT_TRUE(QTest::qWaitFor([this]() { return !d->sizeModeUpdating; }, 1000));
+
+    EXPECT_EQ(counter.styleChanges.value(visibleChild), 1);
+    EXPECT_EQ(counter.styleChanges.value(hiddenChild), 0);
+    EXPECT_EQ(counter.styleChanges.value(hiddenGrandChild), 0);
+    EXPECT_TRUE(d->staleSizeModeWidgets.contains(hiddenChild));
+
+    // Hidden widgets are updated when they are shown.
+    hiddenChild->show();
+    EXPECT_EQ(counter.styleChanges.value(hiddenChild), 1);
+    EXPECT_EQ(counter.styleChanges.value(hiddenGrandChild), 1);
+    EXPECT_FALSE(d->staleSizeModeWidgets.contains(hiddenChild));
+
+    hiddenChild->hide();
+    hiddenChild->show();
+    EXPECT_EQ(counter.styleChanges.value(hiddenChild), 1);
+}
+
+TEST_F(ut_DApplication, testSizeModeStaleWidgetDestroyed)
+{
+    StyleChangeCounter counter;
+    auto hiddenChild = new QWidget(window);
+    hiddenChild->hide();
+
+    window->show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(window));
+
+    d->_q_sizeModeChanged();
+    EXPECT_TRUE(QTest::qWaitFor([this]() { return !d->sizeModeUpdating; }, 1000));
+    EXPECT_TRUE(d->staleSizeModeWidgets.contains(hiddenChild));
+
+    delete hiddenChild;
+    EXPECT_TRUE(d->staleSizeModeWidgets.value(hiddenChild).isNull());
+
+    // A new widget at the address of a destroyed stale widget is not restyled.
+    auto reused = new QWidget(window);
+    reused->hide();
+    reused->installEventFilter(&counter);
+    d->staleSizeModeWidgets.insert(reused, nullptr);
+    reused->show();
+    EXPECT_EQ(counter.styleChanges.value(reused), 0);
+    EXPECT_FALSE(d->staleSizeModeWidgets.contains(reused));
+}
+
+TEST_F(ut_DApplication, testSizeModeTimeSliced)
+{
+    StyleChangeCounter counter;
+    for (int i = 0; i < 20000; ++i) {
+        auto child = new QWidget(window);
+        child->installEventFilter(&counter);
+    }
+    window->show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(window));
+
+    d->_q_sizeModeChanged();
+    // Every visible widget is updated, possibly across several event loop iterations.
+    EXPECT_TRUE(QTest::qWaitFor([this]() { return !d->sizeModeUpdating; }, 10000));
+    EXPECT_EQ(counter.styleChanges.size(), 20000);
+    EXPECT_TRUE(d->pendingSizeModeWidgets.isEmpty());
+    EXPECT_TRUE(d->deferredLayoutRequests.isEmpty());
+}
+
+TEST_F(ut_DApplication, testVirtualKeyboardCoalesced)
+{
+    StubInputContext context;
+    d->inputContextOverride = &context;
+    auto app = qobject_cast<DApplication *>(qApp);
+
+    auto layout = new QVBoxLayout(window);
+    auto edit = new QLineEdit(window);
+    layout->addWidget(edit);
+    window->show();
+    ASSERT_TRUE(QTest::qWaitForWindowActive(window));
+    edit->setFocus();
+    app->acclimatizeVirtualKeyboard(window);
+    QTest::qWait(50);
+    context.visibleQueries = 0;
+
+    // 连续输入时光标区域的通知合并为一次调整
+    for (int i = 0; i < 50; ++i) {
+        Q_EMIT app->inputMethod()->cursorRectangleChanged();
+        Q_EMIT app->inputMethod()->inputItemClipRectangleChanged();
+    }
+    EXPECT_TRUE(QTest::qWaitFor([&context]() { return context.visibleQueries > 0; }, 1000));
+    QTest::qWait(50);
+    EXPECT_EQ(context.visibleQueries, 1);
+}
+
+TEST_F(ut_DApplication, testVirtualKeyboardPanOnly)
+{
+    StubInputContext context;
+    d->inputContextOverride = &context;
+    auto app = qobject_cast<DApplication *>(qApp);
+    app->setVirtualKeyboardPanOnly(true);
+    ASSERT_TRUE(app->virtualKeyboardPanOnly());
+
+    auto layout = new QVBoxLayout(window);
+    layout->addStretch();
+    auto edit = new QLineEdit(window);
+    layout->addWidget(edit);
+    window->show();
+    ASSERT_TRUE(QTest::qWaitForWindowActive(window));
+    edit->setFocus();
+    app->acclimatizeVirtualKeyboard(window);
+
+    // 虚拟键盘遮挡窗口的下半部分，输入框位于窗口底部
+    context.visible = true;
+    context.rect = QRectF(window->mapToGlobal(QPoint(0, window->height() / 2)), QSizeF(window->width(), window->height()));
+    const QMargins margins = window->contentsMargins();
+    const QPoint editPos = edit->pos();
+    d->acclimatizeVirtualKeyboardForFocusWidget(false);
+
+    // 只平移布局区域，不修改 contentsMargins
+    EXPECT_EQ(window->contentsMargins(), margins);
+    EXPECT_LT(layout->geometry().top(), window->contentsRect().top());
+    EXPECT_LT(edit->y(), editPos.y());
+
+    // 状态没有变化时不再移动控件
+    MoveCounter counter;
+    edit->installEventFilter(&counter);
+    d->acclimatizeVirtualKeyboardForFocusWidget(false);
+    EXPECT_EQ(counter.moves, 0);
+
+    // 子控件显示引起布局重新激活后仍然保持平移
+    const QRect panned = layout->geometry();
+    auto label = new QLabel("label", window);
+    layout->insertWidget(0, label);
+    label->show();
+    QCoreApplication::sendPostedEvents(window, QEvent::LayoutRequest);
+    EXPECT_EQ(layout->geometry(), panned);
+    delete label;
+    QCoreApplication::sendPostedEvents(window, QEvent::LayoutRequest);
+    EXPECT_EQ(layout->geometry(), panned);
+    edit->removeEventFilter(&counter);
+
+    // 虚拟键盘隐藏后恢复原来的位置
+    context.visible = false;
+    d->acclimatizeVirtualKeyboardForFocusWidget(false);
+    EXPECT_EQ(layout->geometry(), window->contentsRect());
+    EXPECT_EQ(edit->pos(), editPos);
+    EXPECT_EQ(window->contentsMargins(), margins);
+}
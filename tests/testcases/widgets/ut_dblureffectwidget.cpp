@@ -9,6 +9,7 @@
 #include <QPen>
 #include <QPainter>
 #include <QPainterPath>
+#include <QThreadPool>
 
 #include "dblureffectwidget.h"
 #include "private/dblureffectwidget_p.h"
@@ -97,3 +98,52 @@ TEST_F(ut_DBlurEffectWidget, testBlurEffectWidgetFrontEnd)
 //    ASSERT_TRUE(widget->font().family() == font.family());
 //}
 
+
+static QImage paintGroup(DBlurEffectGroup &group, DBlurEffectWidget *widget)
+{
+    QImage canvas(widget->size(), QImage::Format_ARGB32_Premultiplied);
+    canvas.fill(Qt::transparent);
+    QPainter pa(&canvas);
+    group.paint(&pa, widget);
+    pa.end();
+    return canvas;
+}
+
+TEST_F(ut_DBlurEffectWidget, testGroupAsyncSourceImage)
+{
+    QImage source(200, 150, QImage::Format_ARGB32_Premultiplied);
+    source.fill(Qt::red);
+    QPainter pa(&source);
+    pa.fillRect(60, 40, 50, 50, Qt::blue);
+    pa.end();
+    QImage plain(source.size(), source.format());
+    plain.fill(Qt::green);
+
+    widget->resize(100, 80);
+    DBlurEffectWidget referenceWidget;
+    referenceWidget.resize(widget->size());
+    DBlurEffectGroup reference;
+    reference.addWidget(&referenceWidget, QPoint(20, 10));
+    reference.setSourceImage(source, 10);
+    const QImage expected = paintGroup(reference, &referenceWidget);
+
+    DBlurEffectGroup group;
+    group.addWidget(widget, QPoint(20, 10));
+    group.setSourceImage(plain, 0);
+    const QImage before = paintGroup(group, widget);
+    ASSERT_NE(before, expected);
+
+    // 模糊完成前继续使用之前的图片
+    group.setSourceImageAsync(source, 10);
+    EXPECT_EQ(paintGroup(group, widget), before);
+    EXPECT_TRUE(QTest::qWaitFor([&] {
+        return paintGroup(group, widget) == expected;
+    }, 5000));
+
+    // 同步设置的图片不会被之前未完成的异步结果覆盖
+    group.setSourceImageAsync(source, 20);
+    group.setSourceImage(plain, 0);
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::processEvents();
+    EXPECT_EQ(paintGroup(group, widget), before);
+}
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "dcacheregistry.h"
+#include "private/dcacheregistry_p.h"
+
+DWIDGET_USE_NAMESPACE
+
+class ut_DCacheRegistry : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        registry = DCacheRegistry::instance();
+        oldBudget = registry->budget();
+        registry->setBudget(std::numeric_limits<qint64>::max());
+        // 清空其他测试遗留的可淘汰条目，剩余的都是固定条目
+        registry->trim(0);
+        baseCost = registry->totalCost();
+    }
+
+    void TearDown() override
+    {
+        for (quint64 id : ids)
+            registry->unregisterEntry(id);
+        registry->setBudget(oldBudget);
+    }
+
+    quint64 addTrackedEntry(const QString &name, qint64 cost)
+    {
+        const int index = ids.size();
+        ids << 0;
+        ids[index] = registry->registerEntry(name, cost, [this, index]() {
+            evictedIds << ids.at(index);
+        });
+        return ids.at(index);
+    }
+
+    static DCacheRegistry::Statistics stats(const QString &name)
+    {
+        for (const auto &item : DCacheRegistry::instance()->statistics()) {
+            if (item.cacheName == name)
+                return item;
+        }
+        return DCacheRegistry::Statistics();
+    }
+
+    DCacheRegistry *registry = nullptr;
+    qint64 oldBudget = 0;
+    qint64 baseCost = 0;
+    QList<quint64> ids;
+    QList<quint64> evictedIds;
+};
+
+TEST_F(ut_DCacheRegistry, testLruEviction)
+{
+    const quint64 id1 = addTrackedEntry("ut_lru", 300);
+    const quint64 id2 = addTrackedEntry("ut_lru", 300);
+    const quint64 id3 = addTrackedEntry("ut_lru", 300);
+    EXPECT_EQ(registry->totalCost(), baseCost + 900);
+
+    // 访问后 id1 变为最近使用的条目
+    registry->touch(id1);
+    registry->setBudget(baseCost + 600);
+    EXPECT_EQ(evictedIds, QList<quint64>{id2});
+    EXPECT_EQ(registry->totalCost(), baseCost + 600);
+
+    // 超出预算时淘汰其他条目而不是自身
+    registry->updateCost(id3, 500);
+    EXPECT_EQ(evictedIds, (QList<quint64>{id2, id1}));
+    EXPECT_EQ(registry->totalCost(), baseCost + 500);
+
+    const auto result = stats("ut_lru");
+    EXPECT_EQ(result.entries, 3);
+    EXPECT_EQ(result.cost, 500);
+    EXPECT_EQ(result.evictions, 2u);
+    EXPECT_EQ(result.evictedCost, 600);
+    EXPECT_GE(result.accesses, 1u);
+}
+
+TEST_F(ut_DCacheRegistry, testPinnedEntry)
+{
+    const quint64 pinned = registry->registerEntry("ut_pinned", 400);
+    ids << pinned;
+    addTrackedEntry("ut_pinned", 400);
+
+    // 没有淘汰回调的条目只计入总占用
+    EXPECT_EQ(registry->trim(0), 400);
+    EXPECT_EQ(evictedIds.size(), 1);
+    EXPECT_EQ(registry->totalCost(), baseCost + 400);
+    EXPECT_EQ(stats("ut_pinned").cost, 400);
+
+    registry->unregisterEntry(pinned);
+    EXPECT_EQ(stats("ut_pinned").cost, 0);
+}
+
+TEST_F(ut_DCacheRegistry, testUnregisterInEvictor)
+{
+    quint64 first = 0;
+    quint64 second = 0;
+    first = registry->registerEntry("ut_reentrant", 200, [&]() {
+        // 淘汰回调中注销自身及其他条目
+        registry->unregisterEntry(first);
+        registry->unregisterEntry(second);
+    });
+    second = registry->registerEntry("ut_reentrant", 200, [&]() {
+        ADD_FAILURE() << "unregistered entry should not be evicted";
+    });
+
+    registry->trim(0);
+    EXPECT_EQ(stats("ut_reentrant").entries, 0);
+    EXPECT_EQ(stats("ut_reentrant").evictions, 1u);
+}
+
+TEST_F(ut_DCacheRegistry, testMemoryPressure)
+{
+    int pressureCount = 0;
+    QObject::connect(registry, &DCacheRegistry::memoryPressure, registry, [&pressureCount]() {
+        ++pressureCount;
+    });
+
+    for (int i = 0; i < 4; ++i)
+        addTrackedEntry("ut_pressure", 200);
+
+    // 释放一半的占用
+    registry->d_func()->lastPressure.invalidate();
+    registry->notifyMemoryPressure();
+    EXPECT_EQ(pressureCount, 1);
+    EXPECT_GE(evictedIds.size(), 2);
+    EXPECT_LE(registry->totalCost(), (baseCost + 800) / 2);
+    const int evictedCount = evictedIds.size();
+
+    // 连续的通知会被忽略
+    registry->notifyMemoryPressure();
+    EXPECT_EQ(pressureCount, 1);
+    EXPECT_EQ(evictedIds.size(), evictedCount);
+
+    QObject::disconnect(registry, &DCacheRegistry::memoryPressure, registry, nullptr);
+}
@@ -3,8 +3,14 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include <gtest/gtest.h>
+#include <QDir>
+#include <QFile>
+#include <QStringListModel>
+#include <QTemporaryDir>
+#include <QTest>
 
 #include "dfilechooseredit.h"
+#include "private/dfilechooseredit_p.h"
 DWIDGET_USE_NAMESPACE
 class ut_DFileChooserEdit : public testing::Test
 {
@@ -53,3 +59,85 @@ TEST_F(ut_DFileChooserEdit, setNameFilters)
     target->setNameFilters({"setNameFilters"});
     ASSERT_EQ(target->nameFilters().size(), 1);
 };
+
+TEST_F(ut_DFileChooserEdit, directoryOf)
+{
+    EXPECT_EQ(DFileChooserEditPrivate::directoryOf("/usr/li"), QStringLiteral("/usr/"));
+    EXPECT_EQ(DFileChooserEditPrivate::directoryOf("/usr/lib/"), QStringLiteral("/usr/lib/"));
+    EXPECT_TRUE(DFileChooserEditPrivate::directoryOf("usr/lib").isEmpty());
+}
+
+TEST_F(ut_DFileChooserEdit, checkPath)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    ASSERT_TRUE(QDir(dir.path()).mkdir("sub"));
+    for (const char *name : {"b.txt", "a.txt", ".hidden"}) {
+        QFile file(dir.filePath(name));
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    }
+
+    const QString directory = dir.path() + "/";
+    QSharedPointer<QAtomicInt> generation(new QAtomicInt(1));
+    DFileChooserPathCheck result = DFileChooserEditPrivate::checkPath(dir.filePath("a.txt"), true, directory, 100, 1, generation);
+    EXPECT_TRUE(result.checked);
+    EXPECT_TRUE(result.exists);
+    EXPECT_FALSE(result.isDir);
+    EXPECT_TRUE(result.listed);
+    EXPECT_FALSE(result.truncated);
+    EXPECT_EQ(result.entries, QStringList({directory + ".hidden", directory + "a.txt", directory + "b.txt", directory + "sub/"}));
+
+    // 条目数有上限
+    result = DFileChooserEditPrivate::checkPath(dir.filePath("missing"), true, directory, 2, 1, generation);
+    EXPECT_FALSE(result.exists);
+    EXPECT_TRUE(result.parentExists);
+    EXPECT_TRUE(result.truncated);
+    EXPECT_EQ(result.entries.size(), 2);
+
+    // 已有更新的检查时放弃列目录
+    result = DFileChooserEditPrivate::checkPath(dir.filePath("a.txt"), false, directory, 100, 0, generation);
+    EXPECT_FALSE(result.checked);
+    EXPECT_FALSE(result.listed);
+}
+
+TEST_F(ut_DFileChooserEdit, completion)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QFile file(dir.filePath("file"));
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+
+    auto d = target->d_func();
+    EXPECT_TRUE(target->completionEnabled());
+    EXPECT_EQ(target->lineEdit()->completer(), d->completer);
+
+    target->setText(dir.path() + "/fi");
+    EXPECT_TRUE(QTest::qWaitFor([d] { return !d->completionModel->stringList().isEmpty(); }));
+    EXPECT_EQ(d->completionModel->stringList(), QStringList(dir.filePath("file")));
+
+    target->setCompletionEnabled(false);
+    EXPECT_EQ(target->lineEdit()->completer(), nullptr);
+    EXPECT_TRUE(d->completionModel->stringList().isEmpty());
+}
+
+TEST_F(ut_DFileChooserEdit, pathValidation)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    EXPECT_FALSE(target->pathValidationEnabled());
+    target->setPathValidationEnabled(true);
+    target->setFileMode(QFileDialog::Directory);
+
+    target->setText(dir.filePath("missing"));
+    EXPECT_TRUE(QTest::qWaitFor([this] { return target->isAlert(); }));
+
+    target->setText(dir.path());
+    EXPECT_TRUE(QTest::qWaitFor([this] { return !target->isAlert(); }));
+
+    // 关闭校验时清除由校验设置的警告
+    target->setText(dir.filePath("missing"));
+    EXPECT_TRUE(QTest::qWaitFor([this] { return target->isAlert(); }));
+    target->setPathValidationEnabled(false);
+    EXPECT_TRUE(QTest::qWaitFor([this] { return !target->isAlert(); }));
+}
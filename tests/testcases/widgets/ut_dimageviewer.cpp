@@ -7,6 +7,11 @@
 #include <QFile>
 #include <QObject>
 #include <QSignalSpy>
+#include <QPainter>
+#include <QTest>
+#include <QGraphicsScene>
+#include <QElapsedTimer>
+#include <QFuture>
 #include <QTouchEvent>
 #include <QGraphicsSceneMouseEvent>
 #if QT_VERSION > QT_VERSION_CHECK(6, 0, 0)
@@ -15,6 +20,7 @@
 #endif
 
 #include "dimageviewer.h"
+#include "private/dimageviewer_p.h"
 #include "private/dimagevieweritems_p.h"
 
 DWIDGET_USE_NAMESPACE
@@ -69,6 +75,68 @@ QImage createHalfSizeImage()
     return tmpImage;
 }
 
+// Write an animated GIF, each frame is filled with a palette color.
+// Codes are kept 8 bits wide by emitting a clear code often, so no real LZW compression is needed.
+static bool createAnimatedGif(const QString &filePath, int width, int height, int frameCount)
+{
+    QByteArray data("GIF89a");
+    auto appendWord = [&data](int value) {
+        data.append(char(value & 0xff));
+        data.append(char((value >> 8) & 0xff));
+    };
+
+    appendWord(width);
+    appendWord(height);
+    // Global color table with 128 colors.
+    data.append(char(0xF6));
+    data.append(char(0));
+    data.append(char(0));
+    for (int i = 0; i < 128; ++i) {
+        data.append(char(i * 2));
+        data.append(char(255 - i * 2));
+        data.append(char(i));
+    }
+    // Loop forever.
+    data.append(QByteArray::fromHex("21FF0B4E45545343415045322E300301000000"));
+
+    for (int frame = 0; frame < frameCount; ++frame) {
+        // Graphic control extension, 20ms delay.
+        data.append(QByteArray::fromHex("21F904000200"));
+        data.append(char(0));
+        data.append(char(0));
+        data.append(char(0x2C));
+        appendWord(0);
+        appendWord(0);
+        appendWord(width);
+        appendWord(height);
+        data.append(char(0));
+        data.append(char(7));
+
+        QByteArray codes;
+        for (int pixel = 0; pixel < width * height; ++pixel) {
+            if (0 == pixel % 100) {
+                codes.append(char(128));
+            }
+            codes.append(char(frame % 128));
+        }
+        codes.append(char(129));
+
+        for (int pos = 0; pos < codes.size(); pos += 255) {
+            const QByteArray block = codes.mid(pos, 255);
+            data.append(char(block.size()));
+            data.append(block);
+        }
+        data.append(char(0));
+    }
+    data.append(char(0x3B));
+
+    QFile file(filePath);
+    if (!file.open(QFile::WriteOnly)) {
+        return false;
+    }
+    return file.write(data) == data.size();
+}
+
 TEST_F(ut_DImageViewer, testSetImage)
 {
     QImage tmpImage = createNormalImage();
@@ -503,3 +571,199 @@ TEST_F(ut_DImageViewer, testCropImageFinished)
 
     ASSERT_EQ(changeSignal.count(), 1);
 }
+
+TEST_F(ut_DImageViewer, testSvgRasterCache)
+{
+    QByteArray svgCode("<svg version=\"1.1\" width=\"300\" height=\"300\"> <rect width=\"300\" height=\"300\" fill=\"#ff0000\"/> </svg>");
+    QString tmpFilePath("/tmp/ut_DImageViewer_raster_tmp.svg");
+    QFile tmpFile(tmpFilePath);
+    ASSERT_TRUE(tmpFile.open(QFile::WriteOnly));
+    tmpFile.write(svgCode);
+    tmpFile.close();
+
+    QGraphicsScene scene;
+    auto svgItem = new DGraphicsSVGItem(tmpFilePath);
+    scene.addItem(svgItem);
+    ASSERT_EQ(svgItem->boundingRect().size(), QSizeF(300, 300));
+
+    QImage target(300, 300, QImage::Format_ARGB32_Premultiplied);
+    target.fill(Qt::transparent);
+    QPainter painter(&target);
+    // First paint only schedules the rasterization on the worker thread.
+    scene.render(&painter, QRectF(0, 0, 300, 300), QRectF(0, 0, 300, 300));
+    EXPECT_FALSE(svgItem->pendingTiles.isEmpty());
+
+    EXPECT_TRUE(QTest::qWaitFor([svgItem]() { return svgItem->pendingTiles.isEmpty(); }, 5000));
+    EXPECT_TRUE(svgItem->rasterCache.contains(0));
+    EXPECT_TRUE(svgItem->rasterCache.contains(svgItem->baseRasterLevel()));
+    EXPECT_GT(svgItem->rasterCacheCost(), 0);
+
+    scene.render(&painter, QRectF(0, 0, 300, 300), QRectF(0, 0, 300, 300));
+    painter.end();
+    EXPECT_EQ(target.pixelColor(150, 150), QColor(Qt::red));
+
+    // Load new file will drop the cached rasters.
+    svgItem->setFileName(tmpFilePath);
+    EXPECT_EQ(svgItem->rasterCacheCost(), 0);
+
+    EXPECT_TRUE(QFile::remove(tmpFilePath));
+}
+
+TEST_F(ut_DImageViewer, testSvgRasterLoadFailed)
+{
+    QByteArray svgCode("<svg version=\"1.1\" width=\"300\" height=\"300\"> <rect width=\"300\" height=\"300\" fill=\"#ff0000\"/> </svg>");
+    QString tmpFilePath("/tmp/ut_DImageViewer_raster_failed_tmp.svg");
+    QFile tmpFile(tmpFilePath);
+    ASSERT_TRUE(tmpFile.open(QFile::WriteOnly));
+    tmpFile.write(svgCode);
+    tmpFile.close();
+
+    QGraphicsScene scene;
+    auto svgItem = new DGraphicsSVGItem(tmpFilePath);
+    scene.addItem(svgItem);
+    // The worker renderer loads the file again, it fails once the file is removed.
+    EXPECT_TRUE(QFile::remove(tmpFilePath));
+
+    QImage target(300, 300, QImage::Format_ARGB32_Premultiplied);
+    target.fill(Qt::transparent);
+    QPainter painter(&target);
+    scene.render(&painter, QRectF(0, 0, 300, 300), QRectF(0, 0, 300, 300));
+    painter.end();
+    EXPECT_FALSE(svgItem->pendingTiles.isEmpty());
+
+    // Failed tiles are no longer pending, so they can be requested again.
+    EXPECT_TRUE(QTest::qWaitFor([svgItem]() { return svgItem->pendingTiles.isEmpty(); }, 5000));
+    EXPECT_TRUE(svgItem->rasterCache.isEmpty());
+    EXPECT_EQ(svgItem->rasterCacheCost(), 0);
+}
+
+TEST_F(ut_DImageViewer, testSvgRasterTiles)
+{
+    QByteArray svgCode("<svg version=\"1.1\" width=\"1000\" height=\"500\"> <rect width=\"1000\" height=\"500\"/> </svg>");
+    QString tmpFilePath("/tmp/ut_DImageViewer_tiles_tmp.svg");
+    QFile tmpFile(tmpFilePath);
+    ASSERT_TRUE(tmpFile.open(QFile::WriteOnly));
+    tmpFile.write(svgCode);
+    tmpFile.close();
+
+    DGraphicsSVGItem svgItem(tmpFilePath);
+    EXPECT_EQ(svgItem.rasterLevel(1.0), 0);
+    EXPECT_EQ(svgItem.rasterLevel(1.5), 1);
+    EXPECT_EQ(svgItem.rasterLevel(0.3), -1);
+    EXPECT_EQ(svgItem.baseRasterLevel(), 1);
+
+    // Raster fits in one image.
+    EXPECT_EQ(svgItem.rasterTilesInRect(1, svgItem.boundingRect()).size(), 1);
+    // 4x zoom is 4000 x 2000 pixels, split into 512 pixels tiles.
+    QList<quint32> tiles = svgItem.rasterTilesInRect(2, svgItem.boundingRect());
+    EXPECT_EQ(tiles.size(), 8 * 4);
+    EXPECT_EQ(svgItem.rasterTileRect(2, tiles.first()), QRectF(0, 0, 128, 128));
+    // Only tiles intersects with the exposed rect are needed.
+    EXPECT_EQ(svgItem.rasterTilesInRect(2, QRectF(100, 10, 50, 50)).size(), 2);
+
+    EXPECT_TRUE(QFile::remove(tmpFilePath));
+}
+
+TEST_F(ut_DImageViewer, testMovieFrameCache)
+{
+    QString tmpFilePath("/tmp/ut_DImageViewer_movie_tmp.gif");
+    const int frameCount = 12;
+    ASSERT_TRUE(createAnimatedGif(tmpFilePath, 400, 300, frameCount));
+
+    QGraphicsScene scene;
+    auto movieItem = new DGraphicsMovieItem;
+    scene.addItem(movieItem);
+    movieItem->setFileName(tmpFilePath);
+    // First frame is ready immediately, others are decoded on worker thread.
+    EXPECT_EQ(movieItem->pixmap().size(), QSize(400, 300));
+    EXPECT_TRUE(movieItem->keepAllFrames);
+    EXPECT_TRUE(movieItem->isPlaying());
+
+    EXPECT_TRUE(QTest::qWaitFor([movieItem]() { return movieItem->allFramesDecoded; }, 5000));
+    EXPECT_EQ(movieItem->frames.size(), frameCount);
+
+    // Step two full loops and measure work done on GUI thread per frame.
+    movieItem->frameTimer->stop();
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < frameCount * 2; ++i) {
+        movieItem->onFrameTimeout();
+    }
+    const qreal costPerFrame = qreal(timer.nsecsElapsed()) / 1000000 / (frameCount * 2);
+    EXPECT_LT(costPerFrame, 5.0);
+    // Frames are reused across loops, nothing decoded again.
+    EXPECT_FALSE(movieItem->decoding);
+    EXPECT_EQ(movieItem->framePixmaps.size(), frameCount);
+
+    // Pause while hidden.
+    movieItem->setVisible(false);
+    EXPECT_FALSE(movieItem->isPlaying());
+    movieItem->setVisible(true);
+    EXPECT_TRUE(movieItem->isPlaying());
+
+    EXPECT_TRUE(QFile::remove(tmpFilePath));
+}
+
+static QImage createPatternImage(int width, int height, QImage::Format format)
+{
+    // Every pixel has an unique color.
+    QImage tmpImage(width, height, QImage::Format_ARGB32);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            tmpImage.setPixel(x, y, qRgba(x % 256, y % 256, (x / 256) * 16 + (y / 256), 255));
+        }
+    }
+    return tmpImage.convertToFormat(format);
+}
+
+TEST_F(ut_DImageViewer, testOrthogonalRotatePixelExact)
+{
+    const QList<QImage::Format> formats = {
+        QImage::Format_ARGB32, QImage::Format_RGB16, QImage::Format_Grayscale8, QImage::Format_RGB888};
+    const QRect cropRect(13, 7, 150, 101);
+
+    for (QImage::Format format : formats) {
+        const QImage tmpImage = createPatternImage(301, 203, format);
+        const QImage cropped = tmpImage.copy(cropRect);
+
+        for (int angle : {90, 180, 270, -90, -180, -270}) {
+            QTransform rotateMatrix;
+            rotateMatrix.rotate(angle);
+            const QImage expected = cropped.transformed(rotateMatrix, Qt::FastTransformation);
+
+            const QImage result = DImageViewerPrivate::transformImage(tmpImage, cropRect, angle);
+            EXPECT_EQ(result.format(), format);
+            EXPECT_EQ(result, expected) << "format:" << format << " angle:" << angle;
+        }
+    }
+
+    // Image without cropping.
+    const QImage tmpImage = createPatternImage(64, 33, QImage::Format_ARGB32);
+    const QImage result = DImageViewerPrivate::transformImage(tmpImage, QRect(), 90);
+    ASSERT_EQ(result.size(), QSize(33, 64));
+    EXPECT_EQ(result.pixel(32, 0), tmpImage.pixel(0, 0));
+    EXPECT_EQ(result.pixel(0, 63), tmpImage.pixel(63, 32));
+}
+
+TEST_F(ut_DImageViewer, testImageAsync)
+{
+    const QImage tmpImage = createPatternImage(4000, 3000, QImage::Format_ARGB32);
+    viewer->setImage(tmpImage);
+    viewer->rotateClockwise();
+    ASSERT_EQ(90, viewer->rotateAngle());
+
+    QElapsedTimer timer;
+    timer.start();
+    const QImage syncResult = viewer->image();
+    const qint64 syncCost = timer.nsecsElapsed();
+
+    timer.restart();
+    QFuture<QImage> future = viewer->imageAsync();
+    const qint64 asyncCallCost = timer.nsecsElapsed();
+    future.waitForFinished();
+
+    // The calling thread only takes a snapshot, the rotation runs on worker thread.
+    EXPECT_LT(asyncCallCost, syncCost);
+    EXPECT_EQ(syncResult.size(), QSize(3000, 4000));
+    EXPECT_EQ(future.result(), syncResult);
+}
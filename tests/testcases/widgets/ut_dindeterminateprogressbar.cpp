@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2024 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QTest>
+
+#include "dindeterminateprogressbar.h"
+#include "private/dindeterminateprogressbar_p.h"
+
+class ut_DIndeterminateProgressbar : public testing::Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+    QWidget *widget = nullptr;
+    DIndeterminateProgressbar *bar = nullptr;
+};
+
+void ut_DIndeterminateProgressbar::SetUp()
+{
+    widget = new QWidget;
+    bar = new DIndeterminateProgressbar(widget);
+    bar->resize(400, 20);
+    widget->resize(400, 20);
+}
+
+void ut_DIndeterminateProgressbar::TearDown()
+{
+    if (widget) {
+        delete widget;
+        widget = nullptr;
+    }
+}
+
+TEST_F(ut_DIndeterminateProgressbar, paintedState)
+{
+    // 滑块和光斑直接绘制，不再创建子控件
+    EXPECT_TRUE(bar->findChildren<QWidget *>().isEmpty());
+
+    auto d = bar->d_func();
+    d->updatePositions(0);
+    EXPECT_EQ(d->sliderRect(), QRect(0, 0, 150, 20));
+
+    // 400 宽的控件滑块可移动 250 像素，1.5 秒时已在右端反弹
+    d->updatePositions(1000);
+    EXPECT_EQ(d->sliderRect().x(), 200);
+    d->updatePositions(1500);
+    EXPECT_EQ(d->sliderRect().x(), 200);
+    d->updatePositions(1250);
+    EXPECT_EQ(d->sliderRect().right(), bar->rect().right());
+
+    if (d->m_spotEnabled) {
+        d->updatePositions(3000);
+        EXPECT_EQ(d->spotRect(), QRect(-200, 0, 200, 20));
+    }
+}
+
+TEST_F(ut_DIndeterminateProgressbar, perInstanceState)
+{
+    DIndeterminateProgressbar other(widget);
+    other.resize(400, 20);
+
+    bar->d_func()->updatePositions(500);
+    EXPECT_EQ(bar->d_func()->sliderRect().x(), 100);
+    EXPECT_EQ(other.d_func()->sliderRect().x(), 0);
+}
+
+TEST_F(ut_DIndeterminateProgressbar, pauseWhenHidden)
+{
+    auto clock = bar->d_func()->m_clock;
+    EXPECT_EQ(clock->state(), QAbstractAnimation::Stopped);
+
+    widget->show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(widget));
+    // 曝光前的帧会暂停时钟，绘制后恢复
+    EXPECT_TRUE(QTest::qWaitFor([clock] { return clock->state() == QAbstractAnimation::Running; }));
+
+    bar->hide();
+    EXPECT_EQ(clock->state(), QAbstractAnimation::Paused);
+    const int time = clock->currentTime();
+    QTest::qWait(50);
+    EXPECT_EQ(clock->currentTime(), time);
+
+    bar->show();
+    EXPECT_EQ(clock->state(), QAbstractAnimation::Running);
+}
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include <gtest/gtest.h>
+#include <QSignalSpy>
 
 #include "dlistview.h"
 DWIDGET_USE_NAMESPACE
@@ -206,3 +207,65 @@ TEST_F(ut_DVariantListModel, setData)
     target->setData(target->index(0, 0), 1, Qt::DisplayRole);
     ASSERT_EQ(target->data(target->index(0, 0)).toInt(), 1);
 };
+
+TEST_F(ut_DVariantListModel, insertItems)
+{
+    QSignalSpy insertSpy(target, &QAbstractItemModel::rowsInserted);
+
+    ASSERT_TRUE(target->appendItems({1, 4}));
+    ASSERT_TRUE(target->insertItems(1, {2, 3}));
+    ASSERT_TRUE(target->insertItems(0, QVariantList{0}));
+    EXPECT_FALSE(target->insertItems(10, {5}));
+    EXPECT_FALSE(target->insertItems(0, QVariantList()));
+
+    // 每次插入只产生一次通知
+    ASSERT_EQ(insertSpy.count(), 3);
+    EXPECT_EQ(insertSpy.at(1).at(1).toInt(), 1);
+    EXPECT_EQ(insertSpy.at(1).at(2).toInt(), 2);
+
+    ASSERT_EQ(target->rowCount(), 5);
+    for (int i = 0; i < 5; ++i)
+        EXPECT_EQ(target->data(target->index(i, 0)).toInt(), i);
+};
+
+TEST_F(ut_DVariantListModel, removeItems)
+{
+    target->appendItems({0, 1, 2, 3, 4});
+    QSignalSpy removeSpy(target, &QAbstractItemModel::rowsRemoved);
+
+    ASSERT_TRUE(target->removeItems(1, 3));
+    EXPECT_FALSE(target->removeItems(1, 3));
+    ASSERT_EQ(removeSpy.count(), 1);
+    ASSERT_EQ(target->rowCount(), 2);
+    EXPECT_EQ(target->data(target->index(1, 0)).toInt(), 4);
+};
+
+TEST_F(ut_DVariantListModel, replaceAll)
+{
+    target->appendItems({0, 1});
+    QSignalSpy resetSpy(target, &QAbstractItemModel::modelReset);
+
+    target->replaceAll({7, 8, 9});
+    ASSERT_EQ(resetSpy.count(), 1);
+    ASSERT_EQ(target->rowCount(), 3);
+    EXPECT_EQ(target->data(target->index(0, 0)).toInt(), 7);
+};
+
+TEST_F(ut_DListView, addItemsToVariantModel)
+{
+    auto model = new DVariantListModel(target);
+    target->setModel(model);
+    QSignalSpy insertSpy(model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy dataSpy(model, &QAbstractItemModel::dataChanged);
+
+    QVariantList items;
+    for (int i = 0; i < 1000; ++i)
+        items << i;
+    ASSERT_TRUE(target->addItems(items));
+    ASSERT_TRUE(target->insertItem(0, -1));
+
+    EXPECT_EQ(insertSpy.count(), 2);
+    EXPECT_EQ(dataSpy.count(), 0);
+    EXPECT_EQ(target->count(), 1001);
+    EXPECT_EQ(model->data(model->index(1000, 0)).toInt(), 999);
+};
@@ -5,9 +5,14 @@
 #include <gtest/gtest.h>
 #include <QTest>
 #include <QDebug>
+#include <QApplication>
 
 #include "DPaletteHelper"
 
+#include <DGuiApplicationHelper>
+
+DGUI_USE_NAMESPACE
+
 DWIDGET_USE_NAMESPACE
 
 class ut_DPaletteHelper : public testing::Test
@@ -59,3 +64,92 @@ TEST_F(ut_DPaletteHelper, testResetPalette)
     helper->resetPalette(widget);
     EXPECT_FALSE(widget->testAttribute(Qt::WA_SetPalette));
 }
+
+// 返回与应用调色板色调相反的调色板
+static QPalette oppositePalette(DGuiApplicationHelper::ColorType *type)
+{
+    auto guiHelper = DGuiApplicationHelper::instance();
+    const bool dark = guiHelper->toColorType(guiHelper->applicationPalette()) == DGuiApplicationHelper::DarkType;
+    *type = dark ? DGuiApplicationHelper::LightType : DGuiApplicationHelper::DarkType;
+
+    QPalette palette = guiHelper->applicationPalette();
+    palette.setColor(QPalette::Window, dark ? Qt::white : Qt::black);
+    return palette;
+}
+
+TEST_F(ut_DPaletteHelper, testBrush)
+{
+    const DPalette palette = helper->palette(widget);
+    EXPECT_EQ(helper->brush(widget, DPalette::ItemBackground), palette.brush(DPalette::ItemBackground));
+    EXPECT_EQ(helper->color(widget, DPalette::TextTips, QPalette::Disabled),
+              palette.color(QPalette::Disabled, DPalette::TextTips));
+    EXPECT_EQ(helper->brush(nullptr, DPalette::TextTips),
+              DGuiApplicationHelper::instance()->applicationPalette().brush(DPalette::TextTips));
+}
+
+TEST_F(ut_DPaletteHelper, testBrushColorGroup)
+{
+    DPalette palette = helper->palette(widget);
+    palette.setColor(QPalette::Active, DPalette::TextTips, Qt::blue);
+    palette.setColor(QPalette::Inactive, DPalette::TextTips, Qt::green);
+    palette.setColor(QPalette::Disabled, DPalette::TextTips, Qt::red);
+    helper->setPalette(widget, palette);
+
+    // 默认的颜色组与 palette(widget).brush(type) 一致，跟随控件的状态
+    EXPECT_EQ(helper->color(widget, DPalette::TextTips), helper->palette(widget).color(DPalette::TextTips));
+    EXPECT_EQ(helper->color(widget, DPalette::TextTips), QColor(Qt::blue));
+
+    widget->setEnabled(false);
+    EXPECT_EQ(helper->color(widget, DPalette::TextTips), helper->palette(widget).color(DPalette::TextTips));
+    EXPECT_EQ(helper->color(widget, DPalette::TextTips), QColor(Qt::red));
+    EXPECT_EQ(helper->color(widget, DPalette::TextTips, QPalette::Active), QColor(Qt::blue));
+
+    widget->setEnabled(true);
+    widget->show();
+    QWidget other;
+    other.show();
+    QApplication::setActiveWindow(&other);
+    EXPECT_EQ(helper->color(widget, DPalette::TextTips), helper->palette(widget).color(DPalette::TextTips));
+}
+
+TEST_F(ut_DPaletteHelper, testPaletteChange)
+{
+    auto child = new QWidget(widget);
+    const QColor inherited = helper->color(child, DPalette::TextTips);
+    EXPECT_EQ(inherited, helper->color(widget, DPalette::TextTips));
+
+    // 父控件的调色板改变后子控件的缓存失效
+    DGuiApplicationHelper::ColorType type;
+    widget->setPalette(oppositePalette(&type));
+    const DPalette standard = DGuiApplicationHelper::instance()->standardPalette(type);
+    EXPECT_EQ(helper->color(child, DPalette::TextTips), standard.color(DPalette::TextTips));
+    EXPECT_NE(helper->color(child, DPalette::TextTips), inherited);
+}
+
+TEST_F(ut_DPaletteHelper, testParentChange)
+{
+    DGuiApplicationHelper::ColorType type;
+    widget->setPalette(oppositePalette(&type));
+    auto child = new QWidget(widget);
+    auto grandChild = new QWidget(child);
+    const DPalette standard = DGuiApplicationHelper::instance()->standardPalette(type);
+    EXPECT_EQ(helper->color(grandChild, DPalette::TextTips), standard.color(DPalette::TextTips));
+
+    // 父控件改变后子孙控件重新继承新的父控件
+    QWidget other;
+    child->setParent(&other);
+    EXPECT_EQ(helper->color(grandChild, DPalette::TextTips), helper->color(&other, DPalette::TextTips));
+    EXPECT_NE(helper->color(grandChild, DPalette::TextTips), standard.color(DPalette::TextTips));
+}
+
+TEST_F(ut_DPaletteHelper, testDestroyedWidget)
+{
+    DGuiApplicationHelper::ColorType type;
+    widget->setPalette(oppositePalette(&type));
+    const QColor custom = helper->color(widget, DPalette::TextTips);
+    delete widget;
+
+    // 新控件可能复用已销毁控件的地址，不能取到旧的缓存
+    widget = new QWidget;
+    EXPECT_NE(helper->color(widget, DPalette::TextTips), custom);
+}
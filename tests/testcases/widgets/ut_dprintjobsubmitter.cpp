@@ -0,0 +1,193 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QMutex>
+#include <QSemaphore>
+#include <QSharedPointer>
+#include <QSignalSpy>
+#include <QTemporaryFile>
+#include <QTest>
+
+#include "private/dprintjobsubmitter_p.h"
+
+DWIDGET_USE_NAMESPACE
+
+// 记录提交内容的打印后端，代替真实的 cupsd
+struct StubPrintJobState
+{
+    QMutex mutex;
+    QByteArray printer;
+    QByteArray title;
+    QByteArray docName;
+    PrintOptions options;
+    QByteArray data;
+    int chunks = 0;
+    int canceledJob = 0;
+    bool finished = false;
+    bool failCreate = false;
+    // 非空时每次写入前等待，用于在传输过程中取消任务
+    QSemaphore *writeGate = nullptr;
+};
+
+class StubPrintJobBackend : public DPrintJobBackend
+{
+public:
+    explicit StubPrintJobBackend(const QSharedPointer<StubPrintJobState> &state)
+        : state(state)
+    {
+    }
+
+    int createJob(const QByteArray &printer, const QByteArray &title, const PrintOptions &options) override
+    {
+        QMutexLocker locker(&state->mutex);
+        state->printer = printer;
+        state->title = title;
+        state->options = options;
+        return state->failCreate ? 0 : 42;
+    }
+
+    bool startDocument(const QByteArray &, int jobId, const QByteArray &docName) override
+    {
+        QMutexLocker locker(&state->mutex);
+        state->docName = docName;
+        return jobId == 42;
+    }
+
+    bool writeData(const char *data, qint64 size) override
+    {
+        if (state->writeGate)
+            state->writeGate->acquire();
+
+        QMutexLocker locker(&state->mutex);
+        state->data.append(data, int(size));
+        ++state->chunks;
+        return true;
+    }
+
+    bool finishDocument(const QByteArray &) override
+    {
+        QMutexLocker locker(&state->mutex);
+        state->finished = true;
+        return true;
+    }
+
+    void cancelJob(const QByteArray &, int jobId) override
+    {
+        QMutexLocker locker(&state->mutex);
+        state->canceledJob = jobId;
+    }
+
+    QString errorString() const override
+    {
+        return QStringLiteral("stub error");
+    }
+
+private:
+    QSharedPointer<StubPrintJobState> state;
+};
+
+class ut_DPrintJobSubmitter : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        state.reset(new StubPrintJobState);
+        QSharedPointer<StubPrintJobState> stubState = state;
+        DPrintJobSubmitter::setBackendFactory([stubState] {
+            return new StubPrintJobBackend(stubState);
+        });
+
+        ASSERT_TRUE(file.open());
+        content.resize(1024 * 1024 + 123);
+        for (int i = 0; i < content.size(); ++i)
+            content[i] = char(i * 31);
+        file.write(content);
+        file.flush();
+    }
+
+    void TearDown() override
+    {
+        DPrintJobSubmitter::setBackendFactory(nullptr);
+    }
+
+    QSharedPointer<StubPrintJobState> state;
+    QTemporaryFile file;
+    QByteArray content;
+};
+
+TEST_F(ut_DPrintJobSubmitter, submitInChunks)
+{
+    DPrintJobSubmitter submitter;
+    QSignalSpy progressSpy(&submitter, &DPrintJobSubmitter::progressChanged);
+    QSignalSpy finishedSpy(&submitter, &DPrintJobSubmitter::finished);
+
+    const PrintOptions options {qMakePair(QByteArrayLiteral("copies"), QByteArrayLiteral("2"))};
+    ASSERT_TRUE(submitter.submit("printer", file.fileName(), "title", options));
+    submitter.waitForFinished();
+    ASSERT_EQ(finishedSpy.size(), 1);
+
+    EXPECT_TRUE(finishedSpy.first().at(0).toBool());
+    EXPECT_EQ(state->printer, QByteArrayLiteral("printer"));
+    EXPECT_EQ(state->title, QByteArrayLiteral("title"));
+    EXPECT_EQ(state->options, options);
+    EXPECT_TRUE(state->finished);
+    EXPECT_EQ(state->data, content);
+    EXPECT_EQ(state->chunks, int((content.size() + submitter.chunkSize() - 1) / submitter.chunkSize()));
+
+    // 进度单调递增，最后一次等于文件大小，且通知次数有上限
+    ASSERT_FALSE(progressSpy.isEmpty());
+    EXPECT_LE(progressSpy.size(), 102);
+    qint64 last = -1;
+    for (const auto &args : progressSpy) {
+        EXPECT_GT(args.at(0).toLongLong(), last);
+        EXPECT_EQ(args.at(1).toLongLong(), content.size());
+        last = args.at(0).toLongLong();
+    }
+    EXPECT_EQ(last, content.size());
+}
+
+TEST_F(ut_DPrintJobSubmitter, cancel)
+{
+    QSemaphore gate;
+    state->writeGate = &gate;
+
+    DPrintJobSubmitter submitter;
+    QSignalSpy finishedSpy(&submitter, &DPrintJobSubmitter::finished);
+    ASSERT_TRUE(submitter.submit("printer", file.fileName(), "title", {}));
+    EXPECT_TRUE(submitter.isRunning());
+    EXPECT_FALSE(submitter.submit("printer", file.fileName(), "title", {}));
+
+    // 放行第一块数据后取消，剩余的数据不再发送
+    submitter.cancel();
+    gate.release();
+    submitter.waitForFinished();
+    ASSERT_EQ(finishedSpy.size(), 1);
+
+    EXPECT_FALSE(finishedSpy.first().at(0).toBool());
+    EXPECT_EQ(state->canceledJob, 42);
+    EXPECT_FALSE(state->finished);
+    EXPECT_LE(state->chunks, 1);
+}
+
+TEST_F(ut_DPrintJobSubmitter, failures)
+{
+    DPrintJobSubmitter submitter;
+    QSignalSpy finishedSpy(&submitter, &DPrintJobSubmitter::finished);
+
+    ASSERT_TRUE(submitter.submit("printer", file.fileName() + ".missing", "title", {}));
+    submitter.waitForFinished();
+    ASSERT_EQ(finishedSpy.size(), 1);
+    EXPECT_FALSE(finishedSpy.takeFirst().at(0).toBool());
+    EXPECT_TRUE(state->printer.isEmpty());
+
+    state->failCreate = true;
+    ASSERT_TRUE(submitter.submit("printer", file.fileName(), "title", {}));
+    submitter.waitForFinished();
+    ASSERT_EQ(finishedSpy.size(), 1);
+    const auto args = finishedSpy.takeFirst();
+    EXPECT_FALSE(args.at(0).toBool());
+    EXPECT_EQ(args.at(1).toString(), QStringLiteral("stub error"));
+    EXPECT_TRUE(state->data.isEmpty());
+}
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2024 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include <QStringListModel>
+#include <DComboBox>
+
+#include "dprintpreviewdialog.h"
+#include "dprintpreviewdialog_p.h"
+
+DWIDGET_USE_NAMESPACE
+
+// 只构造字体下拉框，不创建完整的打印预览对话框，避免依赖打印机环境
+class ut_DPrintPreviewWatermarkFont : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        d = new DPrintPreviewDialogPrivate(nullptr);
+        d->fontCombo = new DComboBox;
+        d->fontModel = new QStringListModel(d->fontCombo);
+        d->fontCombo->setModel(d->fontModel);
+    }
+    void TearDown() override
+    {
+        delete d->fontCombo;
+        delete d;
+    }
+
+    DPrintPreviewDialogPrivate *d = nullptr;
+};
+
+TEST_F(ut_DPrintPreviewWatermarkFont, setWatermarkFontList)
+{
+    QSignalSpy indexSpy(d->fontCombo, static_cast<void (DComboBox::*)(int)>(&DComboBox::currentIndexChanged));
+
+    d->setWatermarkFontList({"A", "B", "C"});
+    EXPECT_EQ(d->fontCombo->count(), 3);
+    EXPECT_EQ(d->fontCombo->currentText(), QStringLiteral("A"));
+    EXPECT_EQ(indexSpy.count(), 1);
+
+    // 当前字体仍然存在时保持选中，且不发出信号
+    d->fontCombo->setCurrentIndex(2);
+    indexSpy.clear();
+    d->setWatermarkFontList({"C", "A"});
+    EXPECT_EQ(d->fontCombo->currentText(), QStringLiteral("C"));
+    EXPECT_EQ(indexSpy.count(), 0);
+}
+
+TEST_F(ut_DPrintPreviewWatermarkFont, updateWatermarkFonts)
+{
+    QStringList fonts;
+    for (int i = 0; i < 5000; ++i)
+        fonts << QStringLiteral("Test Watermark Font %1").arg(i);
+    d->setWatermarkFontList(fonts);
+
+    // 5000 个字体时补全系统字体，字体列表只重置一次
+    QSignalSpy resetSpy(d->fontModel, &QAbstractItemModel::modelReset);
+    QSignalSpy insertSpy(d->fontModel, &QAbstractItemModel::rowsInserted);
+    QElapsedTimer timer;
+    timer.start();
+    d->updateWatermarkFonts();
+    const qint64 elapsed = timer.elapsed();
+
+    const QStringList &families = DPrintPreviewDialogPrivate::watermarkFontFamilies();
+    EXPECT_EQ(d->fontCombo->count(), fonts.size() + families.size());
+    EXPECT_EQ(resetSpy.count(), families.isEmpty() ? 0 : 1);
+    EXPECT_EQ(insertSpy.count(), 0);
+    EXPECT_LT(elapsed, 1000);
+
+    // 再次更新时列表不变
+    resetSpy.clear();
+    d->updateWatermarkFonts();
+    EXPECT_EQ(resetSpy.count(), 0);
+    EXPECT_EQ(d->fontCombo->count(), fonts.size() + families.size());
+}
@@ -3,8 +3,11 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include <gtest/gtest.h>
+#include <QSignalSpy>
+#include <QTest>
 
 #include "dsearchedit.h"
+#include "private/dsearchedit_p.h"
 DWIDGET_USE_NAMESPACE
 class ut_DSearchEdit : public testing::Test
 {
@@ -53,3 +56,43 @@ TEST_F(ut_DSearchEdit, setPlaceholderText)
     target->setPlaceholderText("setPlaceholderText");
     ASSERT_EQ(target->placeholderText(), "setPlaceholderText");
 };
+
+TEST_F(ut_DSearchEdit, editModeConnections)
+{
+    auto d = target->d_func();
+    for (int i = 0; i < 100; ++i)
+        target->setText(QString(i + 1, 'a'));
+
+    // 输入过程中不会重复连接动画结束的信号
+    if (d->animation)
+        ASSERT_EQ(d->animation->receivers(SIGNAL(finished())), 1);
+};
+
+TEST_F(ut_DSearchEdit, searchRequested)
+{
+    QSignalSpy spy(target, &DSearchEdit::searchRequested);
+    target->setSearchDelay(50);
+    ASSERT_EQ(target->searchDelay(), 50);
+
+    // 连续输入只请求最后的文本
+    target->setText("a");
+    target->setText("ab");
+    target->setText("abc");
+    ASSERT_TRUE(spy.wait(1000));
+    ASSERT_EQ(spy.count(), 1);
+    ASSERT_EQ(spy.first().at(0).toString(), "abc");
+
+    // 文本改回已请求的内容时不再重复请求
+    target->setText("abcd");
+    target->setText("abc");
+    QTest::qWait(150);
+    ASSERT_EQ(spy.count(), 1);
+
+    // 回车立即请求当前文本
+    target->setText("abcde");
+    Q_EMIT target->returnPressed();
+    ASSERT_EQ(spy.count(), 2);
+    ASSERT_EQ(spy.last().at(0).toString(), "abcde");
+    QTest::qWait(150);
+    ASSERT_EQ(spy.count(), 2);
+};
@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 #include <DSettingsOption>
 #include <QJsonObject>
+#include <QPointer>
 #include <QWidget>
 
 #include "dsettingswidgetfactory.h"
@@ -30,7 +31,10 @@ protected:
         if (registerOption) {
             registerOption->deleteLater();
         }
+        qDeleteAll(shortcutEdits);
+        shortcutEdits.clear();
     }
+    QList<QWidget *> shortcutEdits;
     DSettingsWidgetFactory *target = nullptr;
     QWidget *widgetCreateHandler(QObject *)
     {
@@ -40,6 +44,17 @@ protected:
     QWidget *createdWidget = nullptr;
     DTK_CORE_NAMESPACE::DSettingsOption *registerOption = nullptr;
 
+    QPointer<DTK_CORE_NAMESPACE::DSettingsOption> createShortcut(const QString &key, const QString &sequence)
+    {
+        QJsonObject opt;
+        opt["key"] = key;
+        opt["type"] = "shortcut";
+        opt["default"] = sequence;
+        QPointer<DTK_CORE_NAMESPACE::DSettingsOption> option = DTK_CORE_NAMESPACE::DSettingsOption::fromJson("shortcuts", opt);
+        shortcutEdits << target->createItem(option).second;
+        return option;
+    }
+
 };
 
 TEST_F(ut_DSettingsWidgetFactory, createStandardItem)
@@ -96,3 +111,58 @@ TEST_F(ut_DSettingsWidgetFactory, registerWidget2)
     ASSERT_EQ(result.second->parent(), parent);
 
 };
+
+TEST_F(ut_DSettingsWidgetFactory, importShortcuts)
+{
+    auto a = createShortcut("a", "Ctrl+A");
+    auto b = createShortcut("b", "Ctrl+B");
+    auto c = createShortcut("c", "Ctrl+C");
+    ASSERT_EQ(a->value().toString(), QStringLiteral("Ctrl+A"));
+
+    // 互相交换快捷键不算冲突
+    QMap<QString, QString> keymap;
+    keymap.insert(a->key(), "Ctrl+B");
+    keymap.insert(b->key(), "ctrl+a");
+    EXPECT_TRUE(target->importShortcuts(keymap).isEmpty());
+    EXPECT_EQ(a->value().toString(), QStringLiteral("Ctrl+B"));
+    EXPECT_EQ(b->value().toString(), QStringLiteral("Ctrl+A"));
+
+    // 与排在前面的配置项冲突时保留原值
+    keymap.clear();
+    keymap.insert(a->key(), "Ctrl+D");
+    keymap.insert(b->key(), "Ctrl+D");
+    keymap.insert(c->key(), "Ctrl+B");
+    keymap.insert("unknown", "Ctrl+E");
+    QStringList rejected = target->importShortcuts(keymap);
+    EXPECT_EQ(rejected.size(), 2);
+    EXPECT_TRUE(rejected.contains(b->key()));
+    EXPECT_TRUE(rejected.contains("unknown"));
+    EXPECT_EQ(a->value().toString(), QStringLiteral("Ctrl+D"));
+    EXPECT_EQ(b->value().toString(), QStringLiteral("Ctrl+A"));
+    EXPECT_EQ(c->value().toString(), QStringLiteral("Ctrl+B"));
+
+    // 与未修改的配置项冲突，原有的快捷键又被占用时清除
+    keymap.clear();
+    keymap.insert(b->key(), "Ctrl+D");
+    keymap.insert(c->key(), "Ctrl+A");
+    EXPECT_EQ(target->importShortcuts(keymap), QStringList {b->key()});
+    EXPECT_EQ(b->value().toString(), QStringLiteral("shortcut_null"));
+    EXPECT_EQ(c->value().toString(), QStringLiteral("Ctrl+A"));
+
+    // 修改配置项的值后索引随之更新
+    b->setValue("Ctrl+F");
+    keymap.clear();
+    keymap.insert(a->key(), "Ctrl+F");
+    EXPECT_EQ(target->importShortcuts(keymap), QStringList {a->key()});
+    b->setValue("Ctrl+G");
+    EXPECT_TRUE(target->importShortcuts(keymap).isEmpty());
+    EXPECT_EQ(a->value().toString(), QStringLiteral("Ctrl+F"));
+
+    // 控件销毁后不再参与导入，其快捷键可以被再次使用
+    delete shortcutEdits.takeFirst();
+    keymap.clear();
+    keymap.insert(a->key(), "Ctrl+H");
+    keymap.insert(b->key(), "Ctrl+F");
+    EXPECT_EQ(target->importShortcuts(keymap), QStringList {a->key()});
+    EXPECT_EQ(b->value().toString(), QStringLiteral("Ctrl+F"));
+}
@@ -206,3 +206,131 @@ TEST_F(ut_DSimpleListView, testDSimpleListViewSelectPrev)
     listView->selectPrevItem();
     widget->show();
 }
+
+class PaintCountListItem : public DSimpleListItem
+{
+public:
+    explicit PaintCountListItem(int row)
+        : row(row)
+    {
+    }
+
+    bool sameAs(DSimpleListItem *item) override
+    {
+        return row == static_cast<PaintCountListItem *>(item)->row;
+    }
+
+    void drawBackground(QRect, QPainter *, int, bool, bool) override
+    {
+        ++paints;
+    }
+
+    void drawForeground(QRect, QPainter *, int, int, bool, bool) override
+    {
+    }
+
+    int row = 0;
+    int paints = 0;
+};
+
+TEST_F(ut_DSimpleListView, testCoalescedRepaint)
+{
+    QList<PaintCountListItem *> items;
+    QList<DSimpleListItem *> itemList;
+    for (int i = 0; i < 100; ++i) {
+        items << new PaintCountListItem(i);
+        itemList << items.last();
+    }
+
+    listView->setRowHeight(20);
+    listView->addItems(itemList);
+    widget->show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(widget));
+    QCoreApplication::processEvents();
+
+    auto resetPaints = [&items] {
+        for (auto item : items)
+            item->paints = 0;
+    };
+    auto paintedRows = [&items] {
+        QList<int> rows;
+        for (auto item : items) {
+            if (item->paints > 0)
+                rows << item->row;
+        }
+        return rows;
+    };
+
+    // 连续的滚轮事件不会同步绘制，处理事件后每个可见行只绘制一次
+    resetPaints();
+    for (int i = 0; i < 5; ++i) {
+        QWheelEvent event(QPointF(50, 50), listView->mapToGlobal(QPoint(50, 50)), QPoint(), QPoint(0, -120),
+                          Qt::NoButton, Qt::NoModifier, Qt::NoScrollPhase, false);
+        QCoreApplication::sendEvent(listView, &event);
+    }
+    EXPECT_TRUE(paintedRows().isEmpty());
+    QCoreApplication::processEvents();
+    for (auto item : items)
+        EXPECT_LE(item->paints, 1);
+    // 滚动 100 像素，只绘制新露出的五行
+    EXPECT_EQ(paintedRows(), QList<int>({10, 11, 12, 13, 14}));
+
+    // 悬停行变化时只重绘前后两行
+    resetPaints();
+    QMouseEvent move1(QEvent::MouseMove, QPointF(50, 30), Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+    QCoreApplication::sendEvent(listView, &move1);
+    QCoreApplication::processEvents();
+    resetPaints();
+    QMouseEvent move2(QEvent::MouseMove, QPointF(50, 70), Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+    QCoreApplication::sendEvent(listView, &move2);
+    QCoreApplication::processEvents();
+    EXPECT_EQ(paintedRows(), QList<int>({6, 8}));
+
+    listView->clearItems();
+}
+
+TEST_F(ut_DSimpleListView, testScrollPaintsExposedRows)
+{
+    QList<PaintCountListItem *> items;
+    QList<DSimpleListItem *> itemList;
+    for (int i = 0; i < 100; ++i) {
+        items << new PaintCountListItem(i);
+        itemList << items.last();
+    }
+
+    listView->setRowHeight(20);
+    listView->addItems(itemList);
+    widget->show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(widget));
+    QCoreApplication::processEvents();
+
+    auto paintedRows = [&items] {
+        QList<int> rows;
+        for (auto item : items) {
+            if (item->paints > 0)
+                rows << item->row;
+            item->paints = 0;
+        }
+        return rows;
+    };
+    auto wheel = [this](int delta) {
+        QWheelEvent event(QPointF(50, 50), listView->mapToGlobal(QPoint(50, 50)), QPoint(), QPoint(0, delta),
+                          Qt::NoButton, Qt::NoModifier, Qt::NoScrollPhase, false);
+        QCoreApplication::sendEvent(listView, &event);
+        QCoreApplication::processEvents();
+    };
+    paintedRows();
+
+    // 滚动一行时只绘制新露出的一行，其余行从缓存中移动
+    wheel(-120);
+    EXPECT_EQ(paintedRows(), QList<int>({10}));
+    wheel(120);
+    EXPECT_EQ(paintedRows(), QList<int>({0}));
+
+    // 外部请求的重绘仍然会重新绘制所有可见行
+    listView->update();
+    QCoreApplication::processEvents();
+    EXPECT_EQ(paintedRows().size(), 10);
+
+    listView->clearItems();
+}
@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTest>
+#include <QWidget>
+#include <private/qobject_p.h>
+
+#include "dstartuptimeline.h"
+#include "private/dstartuptimeline_p.h"
+
+DWIDGET_USE_NAMESPACE
+
+class ut_DStartupTimeline : public testing::Test
+{
+protected:
+    static DStartupTimeline::Phase phase(const QString &name)
+    {
+        for (const auto &item : DStartupTimeline::instance()->phases()) {
+            if (item.name == name)
+                return item;
+        }
+        return DStartupTimeline::Phase();
+    }
+};
+
+TEST_F(ut_DStartupTimeline, testApplicationPhase)
+{
+    // DApplication 构造时记录
+    const auto app = phase("DApplication");
+    EXPECT_EQ(app.name, QStringLiteral("DApplication"));
+    EXPECT_GT(app.durationNsecs, 0);
+    EXPECT_FALSE(app.deferred);
+}
+
+TEST_F(ut_DStartupTimeline, testPhaseScope)
+{
+    auto timeline = DStartupTimeline::instance();
+    const qint64 before = timeline->elapsed();
+    {
+        DStartupPhaseScope scope("ut_phase");
+        QTest::qSleep(5);
+    }
+
+    const auto recorded = phase("ut_phase");
+    EXPECT_EQ(recorded.name, QStringLiteral("ut_phase"));
+    EXPECT_GE(recorded.startNsecs, before);
+    EXPECT_GE(recorded.durationNsecs, 5000000);
+
+    // 未开始的阶段不会被记录
+    const int count = timeline->phases().size();
+    timeline->endPhase("ut_unknown");
+    EXPECT_EQ(timeline->phases().size(), count);
+
+    const QJsonObject root = QJsonDocument::fromJson(timeline->toJson()).object();
+    bool found = false;
+    for (const QJsonValue &value : root.value("phases").toArray())
+        found = found || value.toObject().value("name").toString() == "ut_phase";
+    EXPECT_TRUE(found);
+}
+
+TEST_F(ut_DStartupTimeline, testCallAfterFirstFrame)
+{
+    auto timeline = DStartupTimeline::instance();
+    // 超时后已不再跟踪第一帧，只有在此之前显示过窗口时才有第一帧的记录
+    const bool tracksFirstFrame = timeline->isFirstFrameShown() || !timeline->d_func()->deferredTasksDone;
+    bool called = false;
+    bool destroyedCalled = false;
+    QObject context;
+    auto destroyed = new QObject;
+    timeline->callAfterFirstFrame(&context, [&called] { called = true; });
+    timeline->callAfterFirstFrame(destroyed, [&destroyedCalled] { destroyedCalled = true; });
+    delete destroyed;
+
+    QWidget window;
+    window.resize(100, 100);
+    window.show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(&window));
+
+    EXPECT_TRUE(QTest::qWaitFor([&called] { return called; }, 1000));
+    if (tracksFirstFrame) {
+        EXPECT_TRUE(timeline->isFirstFrameShown());
+        EXPECT_GT(timeline->firstFrameNsecs(), 0);
+    }
+    EXPECT_FALSE(destroyedCalled);
+}
+
+TEST_F(ut_DStartupTimeline, testFallbackRemovesEventFilter)
+{
+    auto timeline = DStartupTimeline::instance();
+    auto d = timeline->d_func();
+
+    // 没有窗口显示时超时执行延迟任务，同时移除应用的事件过滤器
+    d->runDeferredTasks();
+    EXPECT_TRUE(d->deferredTasksDone);
+    EXPECT_FALSE(d->fallbackTimer->isActive());
+
+    auto extraData = QObjectPrivate::get(qApp)->extraData;
+    if (extraData) {
+        for (const auto &filter : extraData->eventFilters)
+            EXPECT_NE(filter.data(), timeline);
+    }
+}
@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QApplication>
+#include <QPainter>
+#include <QWidget>
+
+#include "dstyle.h"
+
+DWIDGET_USE_NAMESPACE
+
+class ut_DStyle : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        style = new DStyle;
+    }
+    void TearDown() override
+    {
+        delete style;
+    }
+
+    DStyle *style = nullptr;
+};
+
+TEST_F(ut_DStyle, testStandardIconMemoized)
+{
+    const QIcon first = DStyle::standardIcon(style, DStyle::SP_SelectElement);
+    const QIcon second = DStyle::standardIcon(style, DStyle::SP_SelectElement);
+    ASSERT_FALSE(first.isNull());
+    EXPECT_EQ(first.cacheKey(), second.cacheKey());
+
+    const QIcon titleIcon = style->standardIcon(QStyle::SP_TitleBarCloseButton);
+    EXPECT_EQ(titleIcon.cacheKey(), style->standardIcon(QStyle::SP_TitleBarCloseButton).cacheKey());
+    EXPECT_NE(titleIcon.cacheKey(), first.cacheKey());
+
+    // 不同的风格实例分别缓存
+    DStyle other;
+    EXPECT_NE(DStyle::standardIcon(&other, DStyle::SP_SelectElement).cacheKey(), first.cacheKey());
+}
+
+TEST_F(ut_DStyle, testStandardIconVariants)
+{
+    QWidget widget1;
+    QWidget widget2;
+    QStyleOption option;
+    option.state = QStyle::State_Selected;
+
+    const QIcon checked1 = DStyle::standardIcon(style, DStyle::SP_IndicatorChecked, nullptr, &widget1);
+    const QIcon selected1 = DStyle::standardIcon(style, DStyle::SP_IndicatorChecked, &option, &widget1);
+    const QIcon checked2 = DStyle::standardIcon(style, DStyle::SP_IndicatorChecked, nullptr, &widget2);
+
+    // 图标依赖控件的调色板以及选中状态
+    EXPECT_EQ(checked1.cacheKey(), DStyle::standardIcon(style, DStyle::SP_IndicatorChecked, nullptr, &widget1).cacheKey());
+    EXPECT_NE(checked1.cacheKey(), selected1.cacheKey());
+    EXPECT_NE(checked1.cacheKey(), checked2.cacheKey());
+}
+
+TEST_F(ut_DStyle, testStyledIconEnginePixmapCache)
+{
+    int drawCount = 0;
+    auto engine = new DStyledIconEngine([&drawCount](QPainter *painter, const QRectF &rect) {
+        ++drawCount;
+        painter->drawRect(rect);
+    });
+    QWidget widget;
+    engine->setFrontRole(&widget, QPalette::Highlight);
+    QIcon icon(engine);
+
+    const QPixmap pixmap = engine->pixmap(QSize(16, 16), QIcon::Normal, QIcon::Off);
+    EXPECT_EQ(engine->pixmap(QSize(16, 16), QIcon::Normal, QIcon::Off).cacheKey(), pixmap.cacheKey());
+    EXPECT_EQ(drawCount, 1);
+
+    engine->pixmap(QSize(24, 24), QIcon::Normal, QIcon::Off);
+    engine->pixmap(QSize(16, 16), QIcon::Disabled, QIcon::Off);
+    EXPECT_EQ(drawCount, 3);
+
+    // 前景色变化后重新绘制
+    QPalette pal = widget.palette();
+    pal.setColor(QPalette::Highlight, Qt::red);
+    widget.setPalette(pal);
+    engine->pixmap(QSize(16, 16), QIcon::Normal, QIcon::Off);
+    EXPECT_EQ(drawCount, 4);
+
+    // 修改绘制函数后缓存失效
+    engine->bindDrawFun([&drawCount](QPainter *, const QRectF &) {
+        drawCount += 10;
+    });
+    engine->pixmap(QSize(16, 16), QIcon::Normal, QIcon::Off);
+    EXPECT_EQ(drawCount, 14);
+}
+
+TEST_F(ut_DStyle, testPreferenceStyleHints)
+{
+    const bool underline = DStyle::shortcutUnderlineVisible();
+    const bool searchDisabled = DStyle::isMenuKeyboardSearchDisabled();
+
+    // 通过接口修改后缓存的结果立即更新
+    if (!qEnvironmentVariableIsSet("D_MENU_UNDERLINESHORTCUT")) {
+        DStyle::setShortcutUnderlineVisible(true);
+        EXPECT_TRUE(style->styleHint(QStyle::SH_UnderlineShortcut));
+        DStyle::setShortcutUnderlineVisible(false);
+        EXPECT_FALSE(style->styleHint(QStyle::SH_UnderlineShortcut));
+        DStyle::setShortcutUnderlineVisible(underline);
+    }
+
+    if (!qEnvironmentVariableIsSet("D_MENU_DISABLE_KEYBOARDSEARCH")) {
+        DStyle::setMenuKeyboardSearchDisabled(true);
+        EXPECT_FALSE(style->styleHint(QStyle::SH_Menu_KeyboardSearch));
+        DStyle::setMenuKeyboardSearchDisabled(false);
+        EXPECT_TRUE(style->styleHint(QStyle::SH_Menu_KeyboardSearch));
+        DStyle::setMenuKeyboardSearchDisabled(searchDisabled);
+    }
+}
+
+TEST_F(ut_DStyle, testPreferencePropertyChanged)
+{
+    // 直接修改程序属性时缓存的结果同样会更新
+    if (!qEnvironmentVariableIsSet("D_MENU_UNDERLINESHORTCUT")) {
+        const QVariant underline = qApp->property("_d_menu_underlineshortcut");
+        qApp->setProperty("_d_menu_underlineshortcut", true);
+        EXPECT_TRUE(DStyle::shortcutUnderlineVisible());
+        qApp->setProperty("_d_menu_underlineshortcut", false);
+        EXPECT_FALSE(DStyle::shortcutUnderlineVisible());
+        qApp->setProperty("_d_menu_underlineshortcut", underline);
+    }
+
+    if (!qEnvironmentVariableIsSet("D_MENU_DISABLE_KEYBOARDSEARCH")) {
+        const QVariant searchDisabled = qApp->property("_d_menu_keyboardsearch_disabled");
+        qApp->setProperty("_d_menu_keyboardsearch_disabled", true);
+        EXPECT_TRUE(DStyle::isMenuKeyboardSearchDisabled());
+        qApp->setProperty("_d_menu_keyboardsearch_disabled", false);
+        EXPECT_FALSE(DStyle::isMenuKeyboardSearchDisabled());
+        qApp->setProperty("_d_menu_keyboardsearch_disabled", searchDisabled);
+    }
+}
+
+TEST_F(ut_DStyle, testPasswordCharacterHint)
+{
+    QWidget widget;
+    const int character = style->styleHint(QStyle::SH_LineEdit_PasswordCharacter, nullptr, &widget);
+    const int expected = QFontMetrics(widget.font()).inFont(QChar(0x26AB)) ? 0x26AB : 0x25CF;
+    EXPECT_EQ(character, expected);
+    EXPECT_EQ(style->styleHint(QStyle::SH_LineEdit_PasswordCharacter, nullptr, &widget), character);
+    EXPECT_EQ(style->styleHint(QStyle::SH_LineEdit_PasswordCharacter), 0x25CF);
+}
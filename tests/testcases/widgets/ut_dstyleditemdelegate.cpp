@@ -6,8 +6,13 @@
 #include <gtest/gtest.h>
 #include <QListView>
 #include <QPointer>
+#include <QScrollBar>
+#include <QSignalSpy>
+#include <QTest>
 
 #include "dstyleditemdelegate.h"
+#include "dstyleoption.h"
+#include "private/dstyleditemdelegate_p.h"
 DWIDGET_USE_NAMESPACE
 DGUI_USE_NAMESPACE
 class ut_DStandardItem : public testing::Test
@@ -243,3 +248,142 @@ TEST_F(ut_DViewItemAction, accessActionByActionList)
 
     model->deleteLater();
 }
+
+// 每一行都带有同一个可点击 action 的大数据量模型
+class ActionRowsModel : public QAbstractListModel
+{
+public:
+    explicit ActionRowsModel(int rows, QObject *parent = nullptr)
+        : QAbstractListModel(parent)
+        , rows(rows)
+    {
+        auto action = new DViewItemAction(Qt::AlignVCenter, QSize(16, 16), QSize(), true);
+        action->setText("action");
+        action->setParent(this);
+        actions << action;
+    }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : rows;
+    }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        if (role == Qt::DisplayRole)
+            return QString::number(index.row());
+        if (role == Dtk::RightActionListRole)
+            return QVariant::fromValue(actions);
+        return QVariant();
+    }
+
+    int rows;
+    DViewItemActionList actions;
+};
+
+TEST(ut_DViewItemActionHitIndex, scrollThroughRows)
+{
+    QListView view;
+    view.setUniformItemSizes(true);
+    ActionRowsModel model(1000000);
+    auto delegate = new DStyledItemDelegate(&view);
+    view.setItemDelegate(delegate);
+    view.setModel(&model);
+    view.resize(300, 400);
+    view.show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(&view));
+
+    auto hitIndex = delegate->findChild<DViewItemActionHitIndex *>();
+    ASSERT_TRUE(hitIndex);
+
+    // 从头滚动到尾，只记录可见的行
+    QScrollBar *bar = view.verticalScrollBar();
+    int maxCount = 0;
+    for (int i = 0; i <= 200; ++i) {
+        bar->setValue(bar->maximum() / 200 * i);
+        QCoreApplication::processEvents();
+        maxCount = qMax(maxCount, hitIndex->count());
+    }
+
+    EXPECT_GT(hitIndex->count(), 0);
+    EXPECT_LE(maxCount, 64);
+}
+
+TEST(ut_DViewItemActionHitIndex, invalidateOnRowMove)
+{
+    QListView view;
+    QStandardItemModel model;
+    auto delegate = new DStyledItemDelegate(&view);
+    view.setItemDelegate(delegate);
+    view.setModel(&model);
+
+    DViewItemAction *actions[2];
+    for (int i = 0; i < 2; ++i) {
+        auto item = new DStandardItem(QString::number(i));
+        actions[i] = new DViewItemAction(Qt::AlignVCenter, QSize(16, 16), QSize(), true);
+        actions[i]->setText("action");
+        item->setActionList(Qt::RightEdge, {actions[i]});
+        model.appendRow(item);
+    }
+
+    view.resize(300, 200);
+    view.show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(&view));
+    view.viewport()->repaint();
+
+    auto hitIndex = delegate->findChild<DViewItemActionHitIndex *>();
+    ASSERT_EQ(hitIndex->count(), 2);
+
+    // 交换两行后旧的记录失效，不会触发错误行的 action
+    model.insertRow(0, model.takeRow(1));
+    EXPECT_EQ(hitIndex->count(), 0);
+
+    view.viewport()->repaint();
+    const auto rects = hitIndex->actions(model.index(0, 0));
+    ASSERT_EQ(rects.size(), 1);
+    EXPECT_EQ(rects.first().first, actions[1]);
+
+    QSignalSpy spy(actions[1], &QAction::triggered);
+    QTest::mouseClick(view.viewport(), Qt::LeftButton, Qt::NoModifier, rects.first().second.center());
+    EXPECT_EQ(spy.count(), 1);
+}
+
+TEST(ut_DViewItemActionHitIndex, clickAfterScroll)
+{
+    QListView view;
+    QStandardItemModel model;
+    auto delegate = new DStyledItemDelegate(&view);
+    view.setItemDelegate(delegate);
+    view.setModel(&model);
+
+    QList<DViewItemAction *> actions;
+    for (int i = 0; i < 50; ++i) {
+        auto item = new DStandardItem(QString::number(i));
+        auto action = new DViewItemAction(Qt::AlignVCenter, QSize(16, 16), QSize(), true);
+        action->setText("action");
+        item->setActionList(Qt::RightEdge, {action});
+        model.appendRow(item);
+        actions << action;
+    }
+
+    view.resize(300, 200);
+    view.show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(&view));
+    QCoreApplication::processEvents();
+
+    // 滚动一行后视图只重绘新露出的行，仍在可见区域内的行的 action 依然可以点击
+    QScrollBar *bar = view.verticalScrollBar();
+    ASSERT_GT(bar->maximum(), 0);
+    bar->setValue(bar->value() + bar->singleStep());
+    QCoreApplication::processEvents();
+
+    const QModelIndex index = view.indexAt(QPoint(10, view.viewport()->height() / 2));
+    ASSERT_TRUE(index.isValid());
+    const auto rects = delegate->findChild<DViewItemActionHitIndex *>()->actions(index);
+    ASSERT_EQ(rects.size(), 1);
+    EXPECT_TRUE(view.visualRect(index).contains(rects.first().second));
+
+    QSignalSpy spy(actions[index.row()], &QAction::triggered);
+    QTest::mouseClick(view.viewport(), Qt::LeftButton, Qt::NoModifier, rects.first().second.center());
+    EXPECT_EQ(spy.count(), 1);
+}
@@ -7,6 +7,7 @@
 #include <QDebug>
 
 #include "dswitchbutton.h"
+#include "private/dswitchbutton_p.h"
 
 DWIDGET_USE_NAMESPACE
 
@@ -93,3 +94,43 @@ TEST_F(ut_DSwitchButton, testDSwitchButtonCheckedChanged)
 
     ASSERT_TRUE(count == 2);
 }
+
+TEST_F(ut_DSwitchButton, testSharedFrames)
+{
+    // 相同状态的开关共用同一份解码后的帧
+    DSwitchButton other(widget);
+    auto d = button->d_func();
+    auto otherD = other.d_func();
+    d->ensureFrames();
+    otherD->ensureFrames();
+    ASSERT_TRUE(d->frames);
+    ASSERT_EQ(d->frames, otherD->frames);
+
+    other.setChecked(true);
+    otherD->ensureFrames();
+    ASSERT_NE(d->frames, otherD->frames);
+
+    other.setChecked(false);
+    otherD->ensureFrames();
+    ASSERT_EQ(d->frames, otherD->frames);
+}
+
+TEST_F(ut_DSwitchButton, testFrameAtTime)
+{
+    DSwitchButtonFrames frames;
+    ASSERT_TRUE(frames.image(0).isNull());
+    ASSERT_EQ(frames.duration(), 0);
+
+    for (int i = 0; i < 3; ++i) {
+        QImage image(1, 1, QImage::Format_ARGB32);
+        image.fill(QColor(i, 0, 0));
+        frames.images << image;
+        frames.endTimes << (i + 1) * 10;
+    }
+
+    ASSERT_EQ(frames.duration(), 30);
+    ASSERT_EQ(frames.image(0).pixelColor(0, 0).red(), 0);
+    ASSERT_EQ(frames.image(10).pixelColor(0, 0).red(), 1);
+    ASSERT_EQ(frames.image(29).pixelColor(0, 0).red(), 2);
+    ASSERT_EQ(frames.image(100).pixelColor(0, 0).red(), 2);
+}
@@ -4,10 +4,12 @@
 
 #include <gtest/gtest.h>
 #include <DLineEdit>
+#include <QHash>
 #include <QTest>
 
 #include "dtitlebar.h"
 #include "private/dtitlebarsettingsimpl.h"
+#include "private/dtitlebareditpanel.h"
 
 DWIDGET_USE_NAMESPACE
 
@@ -173,3 +175,93 @@ TEST_F(ut_DTitleBarSettings, base)
     settings.addTool(new TitleBarToolTest2());
     settings.load(dataFilePath);
 }
+
+// 统计视图收到的绘制事件，未显示的视图只有在截图时才会被绘制
+class ScreenShotCounter : public QObject
+{
+public:
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (event->type() == QEvent::Paint)
+            ++counts[watched];
+        return QObject::eventFilter(watched, event);
+    }
+
+    int total() const
+    {
+        int count = 0;
+        for (int value : counts)
+            count += value;
+        return count;
+    }
+
+    QHash<QObject *, int> counts;
+};
+
+TEST_F(ut_DTitleBarSettings, incrementalScreenShot)
+{
+    DTitlebarSettingsImpl settings;
+    settings.addTool(new TitleBarToolTest());
+    settings.addTool(new TitleBarToolTest2());
+    ASSERT_TRUE(settings.load(dataFilePath));
+
+    DTitlebarCustomWidget customWidget(&settings);
+    customWidget.setEditMode(true);
+    customWidget.reloadWidgets();
+    DTitlebarEditPanel panel(&settings, &customWidget);
+    panel.reloadWidgets();
+
+    ScreenShotCounter counter;
+    auto watchViews = [&] {
+        for (int i = 0; i < customWidget.m_mainHLayout->count(); ++i) {
+            if (auto view = customWidget.widget(i))
+                view->installEventFilter(&counter);
+        }
+    };
+    auto screenShot = [&] {
+        Q_EMIT panel.startScreenShot();
+        QCoreApplication::processEvents();
+    };
+
+    watchViews();
+    panel.updateScreenShotedViews();
+    QCoreApplication::processEvents();
+    const int initial = counter.total();
+    ASSERT_GT(initial, 0);
+
+    // 没有任何变化时不再截图
+    screenShot();
+    EXPECT_EQ(counter.total(), initial);
+
+    // 放下工具后标题栏视图会被重新创建，尺寸和内容不变的视图沿用原来的截图
+    panel.updateCustomWidget();
+    counter.counts.clear();
+    watchViews();
+    panel.updateScreenShotedViews();
+    QCoreApplication::processEvents();
+    EXPECT_EQ(counter.total(), 0);
+
+    auto button = qobject_cast<DragDropWidget *>(panel.m_mainHLayout->itemAt(0)->widget());
+    ASSERT_TRUE(button && button->m_view);
+    QWidget *view = button->m_view;
+
+    // 只有尺寸或内容变化的视图被重新截图
+    view->resize(view->width() + 10, view->height());
+    screenShot();
+    EXPECT_EQ(counter.counts.size(), 1);
+    EXPECT_EQ(counter.total(), counter.counts.value(view));
+    EXPECT_GT(counter.counts.value(view), 0);
+    EXPECT_EQ(button->size(), view->size());
+
+    const int resized = counter.total();
+    QFont font = view->font();
+    font.setPointSize(font.pointSize() + 2);
+    view->setFont(font);
+    screenShot();
+    EXPECT_EQ(counter.counts.size(), 1);
+    EXPECT_GT(counter.total(), resized);
+
+    const int fontChanged = counter.total();
+    screenShot();
+    EXPECT_EQ(counter.total(), fontChanged);
+}
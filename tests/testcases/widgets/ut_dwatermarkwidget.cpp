@@ -7,6 +7,7 @@
 #include <QTest>
 
 #include "dwatermarkwidget.h"
+#include "dcacheregistry.h"
 DWIDGET_USE_NAMESPACE
 class ut_DWaterMarkWidget : public testing::Test
 {
@@ -32,6 +33,44 @@ protected:
         return result.toImage() == source;
     }
 
+    inline static QImage emptyImage(const QSize &size)
+    {
+        QImage image(size, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+        return image;
+    }
+
+    inline QImage renderTarget(const QRegion &region = QRegion())
+    {
+        // 父界面未显示时不会立即收到 Resize 事件
+        target->resize(root->size());
+        QImage image = emptyImage(target->size());
+        target->render(&image, QPoint(), region);
+        return image;
+    }
+
+    inline void setTiledData(qreal rotation)
+    {
+        WaterMarkData data = target->data();
+        data.setType(WaterMarkData::Text);
+        data.setLayout(WaterMarkData::Tiled);
+        data.setText("deepin water mark");
+        data.setLineSpacing(40);
+        data.setSpacing(20);
+        data.setColor(Qt::red);
+        data.setRotation(rotation);
+        target->setData(data);
+    }
+
+    inline qint64 watermarkCacheCost()
+    {
+        for (const auto &stats : DCacheRegistry::instance()->statistics()) {
+            if (stats.cacheName == QStringLiteral("DWaterMarkWidget"))
+                return stats.cost;
+        }
+        return 0;
+    }
+
     DWaterMarkWidget *target = nullptr;
     QLabel *root = nullptr;
 };
@@ -66,3 +105,86 @@ TEST_F(ut_DWaterMarkWidget, paintImage)
 
     EXPECT_TRUE(equalImage(QImage(":/data/watermarks/image.png")));
 }
+
+TEST_F(ut_DWaterMarkWidget, paintTiledRegion)
+{
+    setTiledData(30);
+    const QImage full = renderTarget();
+    EXPECT_NE(full, emptyImage(full.size()));
+
+    // 只重绘部分区域时结果与整体绘制一致
+    const QRegion region = QRegion(10, 20, 100, 50) + QRegion(333, 401, 77, 123);
+    const QImage partial = renderTarget(region);
+    for (const QRect &rect : region)
+        EXPECT_EQ(partial.copy(rect), full.copy(rect));
+    EXPECT_EQ(partial.copy(200, 200, 50, 50), emptyImage(QSize(50, 50)));
+}
+
+TEST_F(ut_DWaterMarkWidget, paintTiledResize)
+{
+    setTiledData(-45);
+    root->resize(300, 300);
+    const QImage small = renderTarget();
+
+    // 调整大小后已有区域的水印位置不变
+    root->resize(700, 650);
+    const QImage large = renderTarget();
+    EXPECT_EQ(large.copy(small.rect()), small);
+
+    // 修改数据后重新生成平铺缓存
+    setTiledData(10);
+    EXPECT_NE(renderTarget().copy(small.rect()), small);
+}
+
+TEST_F(ut_DWaterMarkWidget, tiledCacheShrink)
+{
+    setTiledData(30);
+    root->resize(300, 300);
+    const QImage small = renderTarget();
+    const qint64 smallCost = watermarkCacheCost();
+    EXPECT_GT(smallCost, 0);
+
+    root->resize(900, 900);
+    renderTarget();
+    EXPECT_GT(watermarkCacheCost(), smallCost);
+
+    // 缩小后释放大尺寸的缓存，水印内容不变
+    root->resize(300, 300);
+    EXPECT_EQ(renderTarget(), small);
+    EXPECT_EQ(watermarkCacheCost(), smallCost);
+}
+
+TEST_F(ut_DWaterMarkWidget, tiledCacheLimit)
+{
+    setTiledData(30);
+    root->resize(300, 300);
+    renderTarget();
+    EXPECT_GT(watermarkCacheCost(), 0);
+
+    // 超过缓存上限时不保留缓存，直接用画刷绘制
+    root->resize(2000, 1500);
+    const QImage large = renderTarget();
+    EXPECT_EQ(watermarkCacheCost(), 0);
+    EXPECT_NE(large, emptyImage(large.size()));
+
+    // 部分重绘的结果与整体绘制一致
+    const QRegion region = QRegion(10, 20, 100, 50) + QRegion(1333, 1001, 77, 123);
+    const QImage partial = renderTarget(region);
+    for (const QRect &rect : region)
+        EXPECT_EQ(partial.copy(rect), large.copy(rect));
+}
+
+TEST_F(ut_DWaterMarkWidget, tiledCacheEviction)
+{
+    setTiledData(30);
+    const QImage full = renderTarget();
+    EXPECT_GT(watermarkCacheCost(), 0);
+
+    DCacheRegistry::instance()->trim(0);
+    EXPECT_EQ(watermarkCacheCost(), 0);
+    EXPECT_EQ(renderTarget(), full);
+
+    delete root;
+    root = nullptr;
+    EXPECT_EQ(watermarkCacheCost(), 0);
+}
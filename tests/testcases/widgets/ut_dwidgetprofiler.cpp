@@ -0,0 +1,234 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QResizeEvent>
+#include <QTest>
+#include <QThread>
+
+#include "dwidgetprofiler.h"
+#include "private/dwidgetprofiler_p.h"
+
+DWIDGET_USE_NAMESPACE
+
+// 处理 Resize 时向子控件发送事件，子控件处理 StyleChange 时阻塞一段时间
+class NestedEventWidget : public QWidget
+{
+public:
+    using QWidget::QWidget;
+
+    QWidget *child = nullptr;
+    int sleepMsecs = 20;
+
+protected:
+    bool event(QEvent *e) override
+    {
+        if (e->type() == QEvent::Resize && child) {
+            QEvent styleChange(QEvent::StyleChange);
+            QApplication::sendEvent(child, &styleChange);
+        } else if (e->type() == QEvent::StyleChange && !child) {
+            QThread::msleep(sleepMsecs);
+        }
+        return QWidget::event(e);
+    }
+};
+
+// 处理 StyleChange 时删除自身
+class SelfDeletingWidget : public QWidget
+{
+public:
+    using QWidget::QWidget;
+
+protected:
+    bool event(QEvent *e) override
+    {
+        if (e->type() == QEvent::StyleChange) {
+            delete this;
+            return true;
+        }
+        return QWidget::event(e);
+    }
+};
+
+class ut_DWidgetProfiler : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        profiler = DWidgetProfiler::instance();
+        profiler->reset();
+    }
+
+    void TearDown() override
+    {
+        profiler->setEnabled(false);
+        profiler->setOverlayEnabled(false);
+        profiler->setSlowThreshold(16000);
+        profiler->reset();
+    }
+
+    static DWidgetProfiler::Record objectRecord(const QList<DWidgetProfiler::Record> &records,
+                                                const QString &name, DWidgetProfiler::EventType type)
+    {
+        for (const auto &record : records) {
+            if (record.objectName == name && record.eventType == type)
+                return record;
+        }
+        return DWidgetProfiler::Record();
+    }
+
+    DWidgetProfiler *profiler = nullptr;
+};
+
+TEST_F(ut_DWidgetProfiler, testDisabled)
+{
+    ASSERT_FALSE(profiler->isEnabled());
+
+    QWidget widget;
+    widget.setObjectName("disabledWidget");
+    QEvent event(QEvent::StyleChange);
+    for (int i = 0; i < 100; ++i)
+        QApplication::sendEvent(&widget, &event);
+
+    // 未启用时不记录任何数据，耗时对比见 benchmarks/bench_dapplication.cpp
+    EXPECT_TRUE(profiler->classRecords().isEmpty());
+    EXPECT_TRUE(profiler->objectRecords().isEmpty());
+}
+
+TEST_F(ut_DWidgetProfiler, testRecords)
+{
+    QWidget widget;
+    widget.setObjectName("profiledWidget");
+    profiler->setEnabled(true);
+
+    QResizeEvent resize(QSize(100, 100), QSize(50, 50));
+    for (int i = 0; i < 3; ++i)
+        QApplication::sendEvent(&widget, &resize);
+    QEvent userEvent(QEvent::User);
+    QApplication::sendEvent(&widget, &userEvent);
+
+    const auto record = objectRecord(profiler->objectRecords(), "profiledWidget", DWidgetProfiler::ResizeEvent);
+    EXPECT_EQ(record.className, QStringLiteral("QWidget"));
+    EXPECT_EQ(record.count, 3u);
+    EXPECT_EQ(record.histogram.size(), DWidgetProfiler::histogramBounds().size() + 1);
+
+    quint64 histogramCount = 0;
+    for (quint64 value : record.histogram)
+        histogramCount += value;
+    EXPECT_EQ(histogramCount, record.count);
+
+    bool hasClassRecord = false;
+    for (const auto &classRecord : profiler->classRecords()) {
+        if (classRecord.className == "QWidget" && classRecord.eventType == DWidgetProfiler::ResizeEvent)
+            hasClassRecord = classRecord.count >= 3;
+    }
+    EXPECT_TRUE(hasClassRecord);
+
+    // 关闭后不再记录
+    profiler->setEnabled(false);
+    QApplication::sendEvent(&widget, &resize);
+    EXPECT_EQ(objectRecord(profiler->objectRecords(), "profiledWidget", DWidgetProfiler::ResizeEvent).count, 3u);
+}
+
+TEST_F(ut_DWidgetProfiler, testNestedSelfTime)
+{
+    NestedEventWidget parent;
+    parent.setObjectName("parent");
+    auto child = new NestedEventWidget(&parent);
+    child->setObjectName("child");
+    parent.child = child;
+
+    profiler->setEnabled(true);
+    QResizeEvent resize(QSize(100, 100), QSize(50, 50));
+    QApplication::sendEvent(&parent, &resize);
+
+    const auto records = profiler->objectRecords();
+    const auto parentRecord = objectRecord(records, "parent", DWidgetProfiler::ResizeEvent);
+    const auto childRecord = objectRecord(records, "child", DWidgetProfiler::StyleChangeEvent);
+    ASSERT_EQ(parentRecord.count, 1u);
+    ASSERT_EQ(childRecord.count, 1u);
+
+    // 子控件的耗时不计入父控件
+    EXPECT_GE(childRecord.totalNsecs, child->sleepMsecs * 1000000ll);
+    EXPECT_LT(parentRecord.totalNsecs, childRecord.totalNsecs);
+}
+
+TEST_F(ut_DWidgetProfiler, testJsonDump)
+{
+    QWidget widget;
+    widget.setObjectName("jsonWidget");
+    profiler->setEnabled(true);
+    QEvent styleChange(QEvent::StyleChange);
+    QApplication::sendEvent(&widget, &styleChange);
+
+    const QJsonObject root = QJsonDocument::fromJson(profiler->toJson()).object();
+    EXPECT_TRUE(root.value("enabled").toBool());
+    EXPECT_EQ(root.value("histogramBoundsUs").toArray().size(), DWidgetProfiler::histogramBounds().size());
+
+    bool found = false;
+    for (const QJsonValue &value : root.value("objects").toArray()) {
+        const QJsonObject object = value.toObject();
+        if (object.value("objectName").toString() == "jsonWidget") {
+            found = true;
+            EXPECT_EQ(object.value("event").toString(), QStringLiteral("StyleChangeEvent"));
+            EXPECT_EQ(object.value("count").toInt(), 1);
+        }
+    }
+    EXPECT_TRUE(found);
+    EXPECT_FALSE(root.value("classes").toArray().isEmpty());
+}
+
+TEST_F(ut_DWidgetProfiler, testOverlay)
+{
+    QWidget window;
+    window.resize(200, 200);
+    auto child = new QWidget(&window);
+    child->setGeometry(10, 10, 50, 50);
+    window.show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(&window));
+
+    profiler->setEnabled(true);
+    profiler->setOverlayEnabled(true);
+    profiler->setSlowThreshold(0);
+
+    QEvent styleChange(QEvent::StyleChange);
+    QApplication::sendEvent(child, &styleChange);
+
+    auto d = DWidgetProfilerPrivate::get(profiler);
+    QPointer<DWidgetProfilerOverlay> overlay = d->overlays.value(&window);
+    ASSERT_TRUE(overlay);
+    EXPECT_EQ(overlay->parentWidget(), &window);
+    EXPECT_EQ(overlay->geometry(), window.rect());
+    EXPECT_TRUE(overlay->highlights.contains(child));
+    EXPECT_EQ(overlay->highlights.value(child).rect, QRect(10, 10, 50, 50));
+
+    profiler->setOverlayEnabled(false);
+    EXPECT_TRUE(d->overlays.isEmpty());
+}
+
+TEST_F(ut_DWidgetProfiler, testWidgetDeletedDuringEvent)
+{
+    QWidget window;
+    window.resize(200, 200);
+    QPointer<QWidget> child = new SelfDeletingWidget(&window);
+    window.show();
+    ASSERT_TRUE(QTest::qWaitForWindowExposed(&window));
+
+    profiler->setEnabled(true);
+    profiler->setOverlayEnabled(true);
+    profiler->setSlowThreshold(0);
+
+    // 控件在自身的事件中被删除后不能再被高亮
+    QEvent styleChange(QEvent::StyleChange);
+    QApplication::sendEvent(child, &styleChange);
+    EXPECT_TRUE(child.isNull());
+
+    auto d = DWidgetProfilerPrivate::get(profiler);
+    QPointer<DWidgetProfilerOverlay> overlay = d->overlays.value(&window);
+    EXPECT_TRUE(!overlay || overlay->highlights.isEmpty());
+}